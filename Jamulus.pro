@@ -42,6 +42,26 @@ contains(CONFIG, "nosound") {
     warning("\"nosound\" is deprecated: please use \"serveronly\" for a server-only build.")
 }
 
+# synthetic load generator which emulates a number of clients to measure the
+# capacity of a server, it is built instead of Jamulus
+contains(CONFIG, "loadgen") {
+    message(Building the load generator jamulus-loadgen due to CONFIG+=loadgen.)
+    !unix:error(The load generator is only supported on Unix.)
+    TARGET = jamulus-loadgen
+    CONFIG += headless \
+        serveronly \
+        nojsonrpc
+}
+
+# microbenchmarks of the hot primitives, they are built instead of Jamulus
+contains(CONFIG, "benchmarks") {
+    message(Building the microbenchmarks jamulus-benchmarks due to CONFIG+=benchmarks.)
+    TARGET = jamulus-benchmarks
+    CONFIG += headless \
+        serveronly \
+        nojsonrpc
+}
+
 contains(CONFIG, "headless") {
     message(Headless mode activated.)
     QT -= gui
@@ -390,15 +410,22 @@ FORMS_GUI = src/aboutdlgbase.ui \
 HEADERS += src/plugins/audioreverb.h \
     src/buffer.h \
     src/channel.h \
+    src/channeltable.h \
     src/global.h \
+    src/mixkernels.h \
+    src/overloadcontroller.h \
+    src/packetcapture.h \
     src/protocol.h \
     src/recorder/jamcontroller.h \
-    src/threadpool.h \
+    src/rtworkerteam.h \
     src/server.h \
+    src/serverbenchmark.h \
     src/serverlist.h \
     src/serverlogging.h \
+    src/serverreplay.h \
     src/settings.h \
     src/socket.h \
+    src/tickprofiler.h \
     src/util.h \
     src/recorder/jamrecorder.h \
     src/recorder/creaperproject.h \
@@ -498,15 +525,23 @@ HEADERS_OPUS_X86 = libs/opus/celt/x86/celt_lpc_sse.h \
 SOURCES += src/plugins/audioreverb.cpp \
     src/buffer.cpp \
     src/channel.cpp \
+    src/channeltable.cpp \
     src/main.cpp \
+    src/mixkernels.cpp \
+    src/overloadcontroller.cpp \
+    src/packetcapture.cpp \
     src/protocol.cpp \
     src/recorder/jamcontroller.cpp \
+    src/rtworkerteam.cpp \
     src/server.cpp \
+    src/serverbenchmark.cpp \
     src/serverlist.cpp \
     src/serverlogging.cpp \
+    src/serverreplay.cpp \
     src/settings.cpp \
     src/signalhandler.cpp \
     src/socket.cpp \
+    src/tickprofiler.cpp \
     src/util.cpp \
     src/recorder/jamrecorder.cpp \
     src/recorder/creaperproject.cpp \
@@ -1114,6 +1149,20 @@ contains(CONFIG, "nojsonrpc") {
     }
 }
 
+contains(CONFIG, "benchmarks") {
+    SOURCES -= src/main.cpp
+    HEADERS += src/benchmarks/benchmarks.h
+    SOURCES += src/benchmarks/benchmarks.cpp \
+        src/benchmarks/main.cpp
+}
+
+contains(CONFIG, "loadgen") {
+    SOURCES -= src/main.cpp
+    HEADERS += src/loadgen/loadgen.h
+    SOURCES += src/loadgen/loadgen.cpp \
+        src/loadgen/main.cpp
+}
+
 # use external OPUS library if requested
 contains(CONFIG, "opus_shared_lib") {
     message(OPUS codec is used from a shared library.)
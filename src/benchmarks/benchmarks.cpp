@@ -0,0 +1,565 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "benchmarks.h"
+#include <QHostAddress>
+#include <QSysInfo>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#ifdef USE_OPUS_SHARED_LIB
+#    include "opus/opus_custom.h"
+#else
+#    include "opus_custom.h"
+#endif
+#include "../buffer.h"
+#include "../channeltable.h"
+#include "../mixkernels.h"
+#include "../protocol.h"
+
+/* Implementation *************************************************************/
+// the benchmarks store a result here so that the compiler cannot remove the
+// benchmarked code
+static volatile double dBenchmarkSink = 0;
+
+static int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds> ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+CBenchmarkRunner::CBenchmarkRunner ( const QString& strNFilter, const int iNRepetitionTimeMs, const int iNNumRepetitions ) :
+    Filter ( strNFilter ),
+    iRepetitionTimeNs ( static_cast<int64_t> ( iNRepetitionTimeMs ) * 1000000 ),
+    iNumRepetitions ( iNNumRepetitions )
+{}
+
+void CBenchmarkRunner::Run ( const QString& strName, const int iNumItemsPerIteration, TBenchmarkFunc BenchmarkFunc )
+{
+    if ( !Filter.match ( strName ).hasMatch() )
+    {
+        return;
+    }
+
+    // calibration: the number of iterations is doubled until a run takes long
+    // enough, then it is scaled to the repetition time (this also warms up the
+    // caches and the branch predictors)
+    int64_t iNumIterations = 1;
+
+    for ( ;; )
+    {
+        const int64_t iStartNs = Now();
+
+        BenchmarkFunc ( iNumIterations );
+
+        const int64_t iDurationNs = std::max ( Now() - iStartNs, static_cast<int64_t> ( 1 ) );
+
+        if ( iDurationNs >= BENCHMARKS_CALIBRATION_FRACTION * iRepetitionTimeNs )
+        {
+            iNumIterations = std::max ( static_cast<int64_t> ( static_cast<double> ( iNumIterations ) * iRepetitionTimeNs / iDurationNs ),
+                                        static_cast<int64_t> ( 1 ) );
+            break;
+        }
+
+        iNumIterations *= 2;
+    }
+
+    // measurement
+    CVector<double> vecdNsPerIteration ( iNumRepetitions );
+
+    for ( int i = 0; i < iNumRepetitions; i++ )
+    {
+        const int64_t iStartNs = Now();
+
+        BenchmarkFunc ( iNumIterations );
+
+        vecdNsPerIteration[i] = static_cast<double> ( Now() - iStartNs ) / iNumIterations;
+    }
+
+    std::sort ( vecdNsPerIteration.begin(), vecdNsPerIteration.end() );
+
+    const int    iMid = iNumRepetitions / 2;
+    const double dMedianNs =
+        ( iNumRepetitions % 2 == 1 ) ? vecdNsPerIteration[iMid] : ( vecdNsPerIteration[iMid - 1] + vecdNsPerIteration[iMid] ) / 2;
+
+    QJsonObject jsonResult;
+    jsonResult["name"]                 = strName;
+    jsonResult["iterations"]           = static_cast<double> ( iNumIterations );
+    jsonResult["repetitions"]          = iNumRepetitions;
+    jsonResult["ns_per_iteration"]     = dMedianNs;
+    jsonResult["ns_per_iteration_min"] = vecdNsPerIteration[0];
+    jsonResult["ns_per_iteration_max"] = vecdNsPerIteration[iNumRepetitions - 1];
+    jsonResult["items_per_iteration"]  = iNumItemsPerIteration;
+    jsonResult["ns_per_item"]          = dMedianNs / iNumItemsPerIteration;
+    jsonResults.append ( jsonResult );
+
+    qInfo() << qUtf8Printable ( QString ( "- %1: %2 ns per iteration, %3 ns per item" )
+                                    .arg ( strName, -50 )
+                                    .arg ( dMedianNs, 10, 'f', 1 )
+                                    .arg ( dMedianNs / iNumItemsPerIteration, 8, 'f', 2 ) );
+}
+
+QJsonObject CBenchmarkRunner::GetResults() const
+{
+    QJsonObject jsonRoot;
+    jsonRoot["version"]            = VERSION;
+    jsonRoot["cpu_architecture"]   = QSysInfo::currentCpuArchitecture();
+    jsonRoot["os"]                 = QSysInfo::prettyProductName();
+    jsonRoot["mix_kernels"]        = CMixKernels::Get().strName;
+    jsonRoot["repetition_time_ms"] = static_cast<double> ( iRepetitionTimeNs / 1000000 );
+    jsonRoot["benchmarks"]         = jsonResults;
+
+    return jsonRoot;
+}
+
+/******************************************************************************\
+* Mix kernels                                                                  *
+\******************************************************************************/
+void RunMixKernelBenchmarks ( CBenchmarkRunner& Runner )
+{
+    // one server frame of stereo audio (128 samples frame size)
+    const int iNumFrames = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+
+    std::mt19937                       RandomGen ( 1 );
+    std::uniform_int_distribution<int> Sample ( -20000, 20000 );
+    CVector<int16_t>                   vecsSrc ( 2 * iNumFrames );
+    CVector<int16_t>                   vecsDest ( 2 * iNumFrames );
+    CVector<float>                     vecfMix ( 2 * iNumFrames, 0 );
+    CVector<float>                     vecfClip ( 2 * iNumFrames );
+
+    for ( int i = 0; i < 2 * iNumFrames; i++ )
+    {
+        vecsSrc[i] = static_cast<int16_t> ( Sample ( RandomGen ) );
+
+        // some of the samples must be clipped
+        vecfClip[i] = 1.5f * vecsSrc[i];
+    }
+
+    const std::vector<const CMixKernels*> vecpKernels = CMixKernels::GetSupported();
+
+    for ( const CMixKernels* pKernels : vecpKernels )
+    {
+        const CMixKernels& Kernels = *pKernels;
+        const QString      strName = QString ( "mix/%1/" ).arg ( Kernels.strName );
+
+        Runner.Run ( strName + "AddMono", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddMono ( &vecfMix[0], &vecsSrc[0], iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "AddMonoGain", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddMonoGain ( &vecfMix[0], &vecsSrc[0], 0.7f, iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "AddStereoToMono", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddStereoToMono ( &vecfMix[0], &vecsSrc[0], iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "AddStereoToMonoGain", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddStereoToMonoGain ( &vecfMix[0], &vecsSrc[0], 0.7f, iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "AddMonoToStereo", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddMonoToStereo ( &vecfMix[0], &vecsSrc[0], 0.6f, 0.8f, iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "AddStereo", iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.AddStereo ( &vecfMix[0], &vecsSrc[0], 0.6f, 0.8f, iNumFrames );
+            }
+            dBenchmarkSink = vecfMix[0];
+        } );
+
+        Runner.Run ( strName + "Float2ShortClip", 2 * iNumFrames, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Kernels.Float2ShortClip ( &vecsDest[0], &vecfClip[0], 2 * iNumFrames );
+            }
+            dBenchmarkSink = vecsDest[0];
+        } );
+    }
+
+    // the scalar conversion of the client and of the server without mix kernels
+    Runner.Run ( "util/Float2Short", 2 * iNumFrames, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            for ( int j = 0; j < 2 * iNumFrames; j++ )
+            {
+                vecsDest[j] = Float2Short ( vecfClip[j] );
+            }
+        }
+        dBenchmarkSink = vecsDest[0];
+    } );
+}
+
+/******************************************************************************\
+* OPUS                                                                         *
+\******************************************************************************/
+void RunOpusBenchmarks ( CBenchmarkRunner& Runner )
+{
+    // number of different audio frames which are encoded/decoded in turn
+    const int iNumAudioFrames = 16;
+
+    const EAudComprType eCodecs[]      = { CT_OPUS, CT_OPUS64 };
+    const EAudioQuality eQualities[]   = { AQ_LOW, AQ_NORMAL, AQ_HIGH };
+    const char*         strQualities[] = { "low", "normal", "high" };
+
+    for ( const EAudComprType eAudComprType : eCodecs )
+    {
+        const int iFrameSizeSamples = COpusCoding::GetFrameSizeSamples ( eAudComprType );
+        int       iOpusError;
+
+        OpusCustomMode* OpusMode = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, iFrameSizeSamples, &iOpusError );
+
+        for ( int iNumAudioChannels = 1; iNumAudioChannels <= 2; iNumAudioChannels++ )
+        {
+            // same test signal as in the load generator
+            CVector<int16_t> vecsAudio ( iNumAudioFrames * iFrameSizeSamples * iNumAudioChannels );
+
+            COpusCoding::GetTestSignal ( vecsAudio, iNumAudioChannels );
+
+            for ( int iQuality = 0; iQuality < 3; iQuality++ )
+            {
+                const int     iCeltNumCodedBytes = COpusCoding::GetNumCodedBytes ( eAudComprType, iNumAudioChannels, eQualities[iQuality] );
+                const QString strCodec           = ( eAudComprType == CT_OPUS ) ? "opus" : "opus64";
+                const QString strChannels        = ( iNumAudioChannels == 1 ) ? "mono" : "stereo";
+                const QString strName            = QString ( "%1-%2-%3" ).arg ( strCodec, strChannels, strQualities[iQuality] );
+
+                // same encoder settings as in the client
+                OpusCustomEncoder* OpusEncoder = opus_custom_encoder_create ( OpusMode, iNumAudioChannels, &iOpusError );
+                OpusCustomDecoder* OpusDecoder = opus_custom_decoder_create ( OpusMode, iNumAudioChannels, &iOpusError );
+
+                COpusCoding::InitEncoder ( OpusEncoder, eAudComprType );
+                COpusCoding::SetEncoderBitRate ( OpusEncoder, eAudComprType, iCeltNumCodedBytes );
+
+                CVector<uint8_t> vecbyCoded ( iNumAudioFrames * iCeltNumCodedBytes );
+                CVector<int16_t> vecsDecoded ( iFrameSizeSamples * iNumAudioChannels );
+
+                Runner.Run ( "opus/encode/" + strName, iFrameSizeSamples, [&] ( const int64_t iNumIterations ) {
+                    for ( int64_t i = 0; i < iNumIterations; i++ )
+                    {
+                        const int iFrame = static_cast<int> ( i % iNumAudioFrames );
+
+                        opus_custom_encode ( OpusEncoder,
+                                             &vecsAudio[iFrame * iFrameSizeSamples * iNumAudioChannels],
+                                             iFrameSizeSamples,
+                                             &vecbyCoded[iFrame * iCeltNumCodedBytes],
+                                             iCeltNumCodedBytes );
+                    }
+                    dBenchmarkSink = vecbyCoded[0];
+                } );
+
+                Runner.Run ( "opus/decode/" + strName, iFrameSizeSamples, [&] ( const int64_t iNumIterations ) {
+                    for ( int64_t i = 0; i < iNumIterations; i++ )
+                    {
+                        const int iFrame = static_cast<int> ( i % iNumAudioFrames );
+
+                        opus_custom_decode ( OpusDecoder,
+                                             &vecbyCoded[iFrame * iCeltNumCodedBytes],
+                                             iCeltNumCodedBytes,
+                                             &vecsDecoded[0],
+                                             iFrameSizeSamples );
+                    }
+                    dBenchmarkSink = vecsDecoded[0];
+                } );
+
+                opus_custom_encoder_destroy ( OpusEncoder );
+                opus_custom_decoder_destroy ( OpusDecoder );
+            }
+        }
+
+        opus_custom_mode_destroy ( OpusMode );
+    }
+}
+
+/******************************************************************************\
+* Jitter buffer                                                                *
+\******************************************************************************/
+// gives access to the statistics update which is otherwise only called by Get()
+class CNetBufWithStatsBenchmark : public CNetBufWithStats
+{
+public:
+    using CNetBufWithStats::UpdateAutoSetting;
+};
+
+void RunNetBufBenchmarks ( CBenchmarkRunner& Runner )
+{
+    // OPUS64 stereo packets of normal quality with a sequence number
+    const int iBlockSize  = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY;
+    const int iPacketSize = iBlockSize + 1;
+    const int iFillLevel  = DEF_NET_BUF_SIZE_NUM_BL / 2;
+
+    CVector<uint8_t> vecbyPacket ( iPacketSize, 0x55 );
+    CVector<uint8_t> vecbyPacketNext ( iPacketSize, 0x55 );
+    CVector<uint8_t> vecbyBlock ( iBlockSize );
+    CNetBuf          NetBuf;
+    uint8_t          iSequenceNumber = 0;
+
+    // the buffer is kept at a constant fill level
+    NetBuf.Init ( iBlockSize, DEF_NET_BUF_SIZE_NUM_BL, true );
+
+    for ( int i = 0; i < iFillLevel; i++ )
+    {
+        vecbyPacket[iBlockSize] = iSequenceNumber++;
+        NetBuf.Put ( vecbyPacket, iPacketSize );
+    }
+
+    Runner.Run ( "netbuf/PutGet", 1, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            vecbyPacket[iBlockSize] = iSequenceNumber++;
+            NetBuf.Put ( vecbyPacket, iPacketSize );
+            NetBuf.Get ( vecbyBlock, iBlockSize );
+        }
+        dBenchmarkSink = vecbyBlock[0];
+    } );
+
+    // pairs of packets arrive in swapped order
+    Runner.Run ( "netbuf/PutGetReordered", 2, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            vecbyPacket[iBlockSize]     = iSequenceNumber++;
+            vecbyPacketNext[iBlockSize] = iSequenceNumber++;
+            NetBuf.Put ( vecbyPacketNext, iPacketSize );
+            NetBuf.Put ( vecbyPacket, iPacketSize );
+            NetBuf.Get ( vecbyBlock, iBlockSize );
+            NetBuf.Get ( vecbyBlock, iBlockSize );
+        }
+        dBenchmarkSink = vecbyBlock[0];
+    } );
+
+    // the jitter buffer of the server channels with the auto setting statistics
+    CNetBufWithStatsBenchmark NetBufWithStats;
+
+    NetBufWithStats.SetUseDoubleSystemFrameSize ( false );
+    NetBufWithStats.Init ( iBlockSize, DEF_NET_BUF_SIZE_NUM_BL, true );
+
+    for ( int i = 0; i < iFillLevel; i++ )
+    {
+        vecbyPacket[iBlockSize] = iSequenceNumber++;
+        NetBufWithStats.Put ( vecbyPacket, iPacketSize );
+    }
+
+    Runner.Run ( "netbuf/StatsPutGet", 1, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            vecbyPacket[iBlockSize] = iSequenceNumber++;
+            NetBufWithStats.Put ( vecbyPacket, iPacketSize );
+            NetBufWithStats.Get ( vecbyBlock, iBlockSize );
+        }
+        dBenchmarkSink = vecbyBlock[0];
+    } );
+
+    Runner.Run ( "netbuf/UpdateAutoSetting", 1, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            NetBufWithStats.UpdateAutoSetting();
+        }
+        dBenchmarkSink = NetBufWithStats.GetAutoSetting();
+    } );
+}
+
+/******************************************************************************\
+* Protocol                                                                     *
+\******************************************************************************/
+// gives access to the frame generation which is otherwise only used internally
+class CProtocolBenchmark : public CProtocol
+{
+public:
+    using CProtocol::GenMessageFrame;
+};
+
+void RunProtocolBenchmarks ( CBenchmarkRunner& Runner )
+{
+    CProtocolBenchmark Protocol;
+    CVector<uint8_t>   vecbyFrame;
+    CVector<uint8_t>   vecbyMesBodyData;
+    int                iRecCounter;
+    int                iRecID;
+
+    // a ping (the most frequent message) and a chat text of typical length
+    CVector<uint8_t> vecbyPing ( 4, 0x12 );
+    CVector<uint8_t> vecbyChat ( 2 + 100, 0x41 );
+
+    vecbyChat[0] = 100;
+    vecbyChat[1] = 0;
+
+    const int     iIDs[]     = { PROTMESSID_CLM_PING_MS, PROTMESSID_CHAT_TEXT };
+    const QString strNames[] = { "ping", "chat" };
+
+    for ( int iMes = 0; iMes < 2; iMes++ )
+    {
+        const CVector<uint8_t>& vecbyData = ( iMes == 0 ) ? vecbyPing : vecbyChat;
+
+        Runner.Run ( "protocol/GenMessageFrame/" + strNames[iMes], 1, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                Protocol.GenMessageFrame ( vecbyFrame, static_cast<int> ( i & 0xFF ), iIDs[iMes], vecbyData );
+            }
+            dBenchmarkSink = vecbyFrame[vecbyFrame.Size() - 1];
+        } );
+
+        Protocol.GenMessageFrame ( vecbyFrame, 0, iIDs[iMes], vecbyData );
+
+        Runner.Run ( "protocol/ParseMessageFrame/" + strNames[iMes], 1, [&] ( const int64_t iNumIterations ) {
+            for ( int64_t i = 0; i < iNumIterations; i++ )
+            {
+                CProtocol::ParseMessageFrame ( vecbyFrame, vecbyFrame.Size(), vecbyMesBodyData, iRecCounter, iRecID );
+            }
+            dBenchmarkSink = iRecID;
+        } );
+    }
+}
+
+/******************************************************************************\
+* Channel lookup                                                               *
+\******************************************************************************/
+void RunChannelTableBenchmarks ( CBenchmarkRunner& Runner )
+{
+    // the server looks up the channel of each received packet by its address
+    // (CServer::FindChannel() for known addresses), the table is full
+    std::mt19937          RandomGen ( 1 );
+    CChannelTable         ChannelTable;
+    CVector<CHostAddress> vecKnownAddr ( MAX_NUM_CHANNELS );
+    CVector<CHostAddress> vecUnknownAddr ( MAX_NUM_CHANNELS );
+
+    ChannelTable.Init ( MAX_NUM_CHANNELS );
+
+    // random IPv4 addresses and ports
+    auto RandomAddr = [&RandomGen]() {
+        return CHostAddress ( QHostAddress ( static_cast<quint32> ( RandomGen() ) ), static_cast<quint16> ( 1024 + RandomGen() % 60000 ) );
+    };
+
+    for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+    {
+        vecKnownAddr[i]   = RandomAddr();
+        vecUnknownAddr[i] = RandomAddr();
+
+        ChannelTable.Add ( vecKnownAddr[i], ChannelTable.GetFreeChannel() );
+    }
+
+    // the packets of the clients arrive interleaved
+    std::shuffle ( vecKnownAddr.begin(), vecKnownAddr.end(), RandomGen );
+
+    Runner.Run ( "channeltable/FindKnown", MAX_NUM_CHANNELS, [&] ( const int64_t iNumIterations ) {
+        int iSum = 0;
+
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            for ( int j = 0; j < MAX_NUM_CHANNELS; j++ )
+            {
+                iSum += ChannelTable.Find ( vecKnownAddr[j] );
+            }
+        }
+        dBenchmarkSink = iSum;
+    } );
+
+    Runner.Run ( "channeltable/FindUnknown", MAX_NUM_CHANNELS, [&] ( const int64_t iNumIterations ) {
+        int iSum = 0;
+
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            for ( int j = 0; j < MAX_NUM_CHANNELS; j++ )
+            {
+                iSum += ChannelTable.Find ( vecUnknownAddr[j] );
+            }
+        }
+        dBenchmarkSink = iSum;
+    } );
+}
+
+/******************************************************************************\
+* Level meter                                                                  *
+\******************************************************************************/
+void RunLevelMeterBenchmarks ( CBenchmarkRunner& Runner )
+{
+    const int iNumFrames = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+
+    std::mt19937                       RandomGen ( 1 );
+    std::uniform_int_distribution<int> Sample ( -20000, 20000 );
+    CVector<short>                     vecsAudio ( 2 * iNumFrames );
+    CStereoSignalLevelMeter            LevelMeter;
+
+    for ( int i = 0; i < 2 * iNumFrames; i++ )
+    {
+        vecsAudio[i] = static_cast<short> ( Sample ( RandomGen ) );
+    }
+
+    Runner.Run ( "levelmeter/UpdateMono", iNumFrames, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            LevelMeter.Update ( vecsAudio, iNumFrames, false );
+        }
+        dBenchmarkSink = LevelMeter.GetLevelForMeterdBLeftOrMono();
+    } );
+
+    Runner.Run ( "levelmeter/UpdateStereo", iNumFrames, [&] ( const int64_t iNumIterations ) {
+        for ( int64_t i = 0; i < iNumIterations; i++ )
+        {
+            LevelMeter.Update ( vecsAudio, iNumFrames, true );
+        }
+        dBenchmarkSink = LevelMeter.GetLevelForMeterdBLeftOrMono();
+    } );
+}
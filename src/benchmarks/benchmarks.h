@@ -0,0 +1,100 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QString>
+#include <functional>
+#include "../global.h"
+#include "../util.h"
+
+/* Definitions ****************************************************************/
+// default measurement time of one repetition and default number of
+// repetitions of each benchmark
+#define BENCHMARKS_DEFAULT_REPETITION_TIME_MS 20
+#define BENCHMARKS_DEFAULT_NUM_REPETITIONS    10
+
+// the number of iterations of a repetition is doubled until it takes at least
+// this fraction of the repetition time
+#define BENCHMARKS_CALIBRATION_FRACTION 0.5
+
+/* Classes ********************************************************************/
+// Runs microbenchmarks and collects the results. A benchmark function gets
+// the number of iterations it must run. The number of iterations is
+// calibrated so that one repetition takes about the repetition time, the
+// median of all repetitions is the result (the median is robust against
+// outliers caused by interrupts or frequency changes).
+class CBenchmarkRunner
+{
+public:
+    typedef std::function<void ( const int64_t iNumIterations )> TBenchmarkFunc;
+
+    CBenchmarkRunner ( const QString& strNFilter, const int iNRepetitionTimeMs, const int iNNumRepetitions );
+
+    // the number of items (e.g. samples) per iteration is used to report the
+    // time per item in addition
+    void Run ( const QString& strName, const int iNumItemsPerIteration, TBenchmarkFunc BenchmarkFunc );
+
+    // machine-readable result of all benchmarks which were run
+    QJsonObject GetResults() const;
+
+protected:
+    QRegularExpression Filter;
+    int64_t            iRepetitionTimeNs;
+    int                iNumRepetitions;
+    QJsonArray         jsonResults;
+};
+
+// the groups of microbenchmarks of the hot primitives
+void RunMixKernelBenchmarks ( CBenchmarkRunner& Runner );
+void RunOpusBenchmarks ( CBenchmarkRunner& Runner );
+void RunNetBufBenchmarks ( CBenchmarkRunner& Runner );
+void RunProtocolBenchmarks ( CBenchmarkRunner& Runner );
+void RunChannelTableBenchmarks ( CBenchmarkRunner& Runner );
+void RunLevelMeterBenchmarks ( CBenchmarkRunner& Runner );
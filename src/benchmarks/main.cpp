@@ -0,0 +1,126 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include "benchmarks.h"
+
+/* Implementation *************************************************************/
+int main ( int argc, char** argv )
+{
+    QCoreApplication Application ( argc, argv );
+    QCoreApplication::setApplicationName ( "jamulus-benchmarks" );
+    QCoreApplication::setApplicationVersion ( VERSION );
+
+    QCommandLineParser Parser;
+    Parser.setApplicationDescription ( "Runs the microbenchmarks of the hot primitives of Jamulus and writes the results as JSON." );
+    Parser.addHelpOption();
+    Parser.addVersionOption();
+
+    const QCommandLineOption FilterOption ( "filter", "Only run the benchmarks whose name matches the regular expression.", "regex", "" );
+    const QCommandLineOption TimeOption ( "time",
+                                          QString ( "Time of one repetition (default: %1)." ).arg ( BENCHMARKS_DEFAULT_REPETITION_TIME_MS ),
+                                          "ms",
+                                          QString::number ( BENCHMARKS_DEFAULT_REPETITION_TIME_MS ) );
+    const QCommandLineOption RepetitionsOption ( "repetitions",
+                                                 QString ( "Number of repetitions (default: %1)." ).arg ( BENCHMARKS_DEFAULT_NUM_REPETITIONS ),
+                                                 "number",
+                                                 QString::number ( BENCHMARKS_DEFAULT_NUM_REPETITIONS ) );
+    const QCommandLineOption OutputOption ( QStringList() << "o" << "output", "Write the JSON results to this file (default: stdout).", "file" );
+
+    Parser.addOptions ( { FilterOption, TimeOption, RepetitionsOption, OutputOption } );
+    Parser.process ( Application );
+
+    bool      bTimeOk           = false;
+    bool      bRepetitionsOk    = false;
+    const int iRepetitionTimeMs = Parser.value ( TimeOption ).toInt ( &bTimeOk );
+    const int iNumRepetitions   = Parser.value ( RepetitionsOption ).toInt ( &bRepetitionsOk );
+
+    if ( !bTimeOk || ( iRepetitionTimeMs < 1 ) || ( iRepetitionTimeMs > 10000 ) )
+    {
+        qCritical() << "- invalid value for --time, allowed range is 1 to 10000";
+        return 1;
+    }
+
+    if ( !bRepetitionsOk || ( iNumRepetitions < 1 ) || ( iNumRepetitions > 1000 ) )
+    {
+        qCritical() << "- invalid value for --repetitions, allowed range is 1 to 1000";
+        return 1;
+    }
+
+    CBenchmarkRunner Runner ( Parser.value ( FilterOption ), iRepetitionTimeMs, iNumRepetitions );
+
+    RunMixKernelBenchmarks ( Runner );
+    RunOpusBenchmarks ( Runner );
+    RunNetBufBenchmarks ( Runner );
+    RunProtocolBenchmarks ( Runner );
+    RunChannelTableBenchmarks ( Runner );
+    RunLevelMeterBenchmarks ( Runner );
+
+    // the progress goes to stderr, the results to stdout or the given file
+    QFile OutputFile;
+
+    if ( Parser.isSet ( OutputOption ) )
+    {
+        OutputFile.setFileName ( Parser.value ( OutputOption ) );
+
+        if ( !OutputFile.open ( QIODevice::WriteOnly | QIODevice::Truncate ) )
+        {
+            qCritical() << qUtf8Printable ( QString ( "- cannot write %1" ).arg ( Parser.value ( OutputOption ) ) );
+            return 1;
+        }
+    }
+    else
+    {
+        OutputFile.open ( stdout, QIODevice::WriteOnly );
+    }
+
+    OutputFile.write ( QJsonDocument ( Runner.GetResults() ).toJson ( QJsonDocument::Indented ) );
+
+    return 0;
+}
@@ -90,32 +90,57 @@ void CNetBuf::Init ( const int iNewBlockSize, const int iNewNumBlocks, const boo
         }
         else
         {
-            // store current complete buffer state in temporary memory
-            CVector<int> veciTempBlockValid ( iNumBlocksMemory );
-            const int    iOldNumBlocksMemory = iNumBlocksMemory;
-            const int    iOldBlockGetPos     = iBlockGetPos;
-            int          iCurBlockPos        = 0;
+            // store current complete buffer state in temporary memory (including
+            // the audio which was already decoded on arrival since the decoder
+            // state has already advanced)
+            CVector<CVector<int16_t>> vecvecsTempDecMemory = vecvecsDecMemory;
+            CVector<int>              veciTempBlockValid ( iNumBlocksMemory );
+            CVector<int>              veciTempBlockDecoded ( iNumBlocksMemory );
+            const int                 iOldNumBlocksMemory = iNumBlocksMemory;
+            const int                 iOldBlockGetPos     = iBlockGetPos;
+            const uint8_t             iOldSeqNumAtDecPos  = iSequenceNumberAtDecPos;
+            const bool                bHasDecMemory       = ( vecvecsDecMemory.Size() == iNumBlocksMemory );
+            int                       iCurBlockPos        = 0;
 
             while ( iBlockGetPos < iNumBlocksMemory && iCurBlockPos < iTempSize )
             {
-                veciTempBlockValid[iCurBlockPos] = veciBlockValid[iBlockGetPos];
-                vecvecTempMemory[iCurBlockPos++] = vecvecMemory[iBlockGetPos++];
+                if ( bHasDecMemory )
+                {
+                    vecvecsTempDecMemory[iCurBlockPos] = vecvecsDecMemory[iBlockGetPos];
+                }
+
+                veciTempBlockValid[iCurBlockPos]   = veciBlockValid[iBlockGetPos];
+                veciTempBlockDecoded[iCurBlockPos] = veciBlockDecoded[iBlockGetPos];
+                vecvecTempMemory[iCurBlockPos++]   = vecvecMemory[iBlockGetPos++];
             }
 
             for ( iBlockGetPos = 0; iBlockGetPos < iOldBlockGetPos && iCurBlockPos < iTempSize; iBlockGetPos++ )
             {
-                veciTempBlockValid[iCurBlockPos] = veciBlockValid[iBlockGetPos];
-                vecvecTempMemory[iCurBlockPos++] = vecvecMemory[iBlockGetPos];
+                if ( bHasDecMemory )
+                {
+                    vecvecsTempDecMemory[iCurBlockPos] = vecvecsDecMemory[iBlockGetPos];
+                }
+
+                veciTempBlockValid[iCurBlockPos]   = veciBlockValid[iBlockGetPos];
+                veciTempBlockDecoded[iCurBlockPos] = veciBlockDecoded[iBlockGetPos];
+                vecvecTempMemory[iCurBlockPos++]   = vecvecMemory[iBlockGetPos];
             }
 
             // now resize the buffer to the new size
             Resize ( iNewNumBlocks, iNewBlockSize );
 
             // write back the temporary data in new memory
-            iBlockGetPos = 0; // per definition
+            iBlockGetPos            = 0; // per definition
+            iSequenceNumberAtDecPos = iOldSeqNumAtDecPos;
 
             for ( int iCurPos = 0; iCurPos < std::min ( iNewNumBlocks, iOldNumBlocksMemory ) && iCurPos < iTempSize; iCurPos++ )
             {
+                if ( bHasDecMemory && ( vecvecsDecMemory.Size() == iNewNumBlocks ) )
+                {
+                    vecvecsDecMemory[iCurPos] = vecvecsTempDecMemory[iCurPos];
+                    veciBlockDecoded[iCurPos] = veciTempBlockDecoded[iCurPos];
+                }
+
                 veciBlockValid[iCurPos] = veciTempBlockValid[iCurPos];
                 vecvecMemory[iCurPos]   = vecvecTempMemory[iCurPos];
             }
@@ -134,7 +159,8 @@ void CNetBuf::Resize ( const int iNewNumBlocks, const int iNewBlockSize )
 {
     // allocate memory for actual data buffer
     vecvecMemory.Init ( iNewNumBlocks );
-    veciBlockValid.Init ( iNewNumBlocks, 0 ); // initialize with zeros = invalid
+    veciBlockValid.Init ( iNewNumBlocks, 0 );   // initialize with zeros = invalid
+    veciBlockDecoded.Init ( iNewNumBlocks, 0 ); // initialize with zeros = not decoded
 
     if ( !bIsSimulation )
     {
@@ -144,12 +170,28 @@ void CNetBuf::Resize ( const int iNewNumBlocks, const int iNewBlockSize )
         }
     }
 
+    // memory for the audio which is decoded on arrival
+    if ( !bIsSimulation && ( iDecBlockSize > 0 ) )
+    {
+        vecvecsDecMemory.Init ( iNewNumBlocks );
+
+        for ( int iBlock = 0; iBlock < iNewNumBlocks; iBlock++ )
+        {
+            vecvecsDecMemory[iBlock].Init ( iDecBlockSize );
+        }
+    }
+    else
+    {
+        vecvecsDecMemory.Init ( 0 );
+    }
+
     // init buffer pointers and buffer state (empty buffer) and store buffer properties
-    iBlockGetPos     = 0;
-    iBlockPutPos     = 0;
-    eBufState        = BS_EMPTY;
-    iBlockSize       = iNewBlockSize;
-    iNumBlocksMemory = iNewNumBlocks;
+    iBlockGetPos            = 0;
+    iBlockPutPos            = 0;
+    eBufState               = BS_EMPTY;
+    iBlockSize              = iNewBlockSize;
+    iNumBlocksMemory        = iNewNumBlocks;
+    iSequenceNumberAtDecPos = iSequenceNumberAtGetPos;
 }
 
 bool CNetBuf::Put ( const CVector<uint8_t>& vecbyData, int iInSize )
@@ -209,7 +251,8 @@ bool CNetBuf::Put ( const CVector<uint8_t>& vecbyData, int iInSize )
                 for ( int i = iSeqNumDiff; i < 0; i++ )
                 {
                     // insert an invalid block at the shifted position
-                    veciBlockValid[iBlockGetPos] = 0; // invalidate
+                    veciBlockValid[iBlockGetPos]   = 0; // invalidate
+                    veciBlockDecoded[iBlockGetPos] = 0;
 
                     // we decrease the local sequence number and get position and take care of wrap
                     iSequenceNumberAtGetPos--;
@@ -231,7 +274,8 @@ bool CNetBuf::Put ( const CVector<uint8_t>& vecbyData, int iInSize )
                 for ( int i = 0; i < iSeqNumDiff - iNumBlocksMemory + 1; i++ )
                 {
                     // insert an invalid block at the shifted position
-                    veciBlockValid[iBlockGetPos] = 0; // invalidate
+                    veciBlockValid[iBlockGetPos]   = 0; // invalidate
+                    veciBlockDecoded[iBlockGetPos] = 0;
 
                     // we increase the local sequence number and get position and take care of wrap
                     iSequenceNumberAtGetPos++;
@@ -262,6 +306,14 @@ bool CNetBuf::Put ( const CVector<uint8_t>& vecbyData, int iInSize )
                 {
                     iBlockPutPos -= iNumBlocksMemory;
                 }
+
+                // a valid block at this position has the same sequence number, i.e. this is
+                // a duplicated packet which is dropped (the block may already be decoded on
+                // arrival and decoding it a second time would corrupt the decoder state)
+                if ( veciBlockValid[iBlockPutPos] != 0 )
+                {
+                    continue;
+                }
             }
 
             // for simulation buffer only update pointer, no data copying
@@ -271,8 +323,9 @@ bool CNetBuf::Put ( const CVector<uint8_t>& vecbyData, int iInSize )
                 std::copy ( vecbyData.begin() + iBlockOffset, vecbyData.begin() + iBlockOffset + iBlockSize, vecvecMemory[iBlockPutPos].begin() );
             }
 
-            // valid packet added, set flag
-            veciBlockValid[iBlockPutPos] = 1;
+            // valid packet added, set flag (the new packet is not yet decoded)
+            veciBlockValid[iBlockPutPos]   = 1;
+            veciBlockDecoded[iBlockPutPos] = 0;
         }
     }
     else
@@ -340,7 +393,8 @@ bool CNetBuf::Get ( CVector<uint8_t>& vecbyData, const int iOutSize )
         bReturn = ( veciBlockValid[iBlockGetPos] > 0 );
 
         // invalidate the block we are now taking from the buffer
-        veciBlockValid[iBlockGetPos] = 0; // zero means invalid
+        veciBlockValid[iBlockGetPos]   = 0; // zero means invalid
+        veciBlockDecoded[iBlockGetPos] = 0;
     }
 
     // for simultion buffer or invalid block only update pointer, no data copying
@@ -373,6 +427,19 @@ bool CNetBuf::Get ( CVector<uint8_t>& vecbyData, const int iOutSize )
     return bReturn;
 }
 
+bool CNetBuf::GetDecodedBlock ( int16_t* psDecData, const int iDecDataSize ) const
+{
+    if ( !bUseSequenceNumber || bIsSimulation || ( iDecBlockSize == 0 ) || ( iDecDataSize != iDecBlockSize ) ||
+         ( veciBlockDecoded[iBlockGetPos] == 0 ) )
+    {
+        return false;
+    }
+
+    std::copy ( vecvecsDecMemory[iBlockGetPos].begin(), vecvecsDecMemory[iBlockGetPos].begin() + iDecBlockSize, psDecData );
+
+    return true;
+}
+
 int CNetBuf::GetAvailSpace() const
 {
     // calculate available space in buffer
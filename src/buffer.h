@@ -255,15 +255,38 @@ protected:
 class CNetBuf
 {
 public:
-    CNetBuf ( const bool bNIsSim = false ) : iSequenceNumberAtGetPos ( 0 ), bIsSimulation ( bNIsSim ), bIsInitialized ( false ) {}
+    CNetBuf ( const bool bNIsSim = false ) :
+        iSequenceNumberAtGetPos ( 0 ),
+        iSequenceNumberAtDecPos ( 0 ),
+        iDecBlockSize ( 0 ),
+        bIsSimulation ( bNIsSim ),
+        bIsInitialized ( false )
+    {}
 
     void Init ( const int iNewBlockSize, const int iNewNumBlocks, const bool bNUseSequenceNumber, const bool bPreserve = false );
 
     void SetIsSimulation ( const bool bNIsSim ) { bIsSimulation = bNIsSim; }
 
+    // decode-on-arrival: size of the decoded audio stored per block, zero
+    // disables the feature (NOTE must be set BEFORE the init())
+    void SetDecodedBlockSize ( const int iNDecBlockSize ) { iDecBlockSize = iNDecBlockSize; }
+
     virtual bool Put ( const CVector<uint8_t>& vecbyData, int iInSize );
     virtual bool Get ( CVector<uint8_t>& vecbyData, const int iOutSize );
 
+    // Decodes all blocks which directly follow the last decoded block in
+    // sequence number order. Decoding must happen in playback order for the
+    // decoder state, therefore a block after a gap is only decoded after the
+    // gap was concealed in Get(). The function is called with the coded block
+    // and the memory for the decoded audio and returns false if the block
+    // cannot be decoded (e.g. because the stream properties just changed).
+    template<typename TDecodeFunc>
+    void DecodeNewBlocks ( TDecodeFunc DecodeFunc );
+
+    // copies the decoded audio if the block at the get position was decoded
+    // on arrival with the requested size, must be called directly before Get()
+    bool GetDecodedBlock ( int16_t* psDecData, const int iDecDataSize ) const;
+
 protected:
     enum EBufState
     {
@@ -278,11 +301,15 @@ protected:
 
     CVector<CVector<uint8_t>> vecvecMemory;
     CVector<int>              veciBlockValid;
+    CVector<CVector<int16_t>> vecvecsDecMemory;
+    CVector<int>              veciBlockDecoded;
     int                       iNumBlocksMemory;
     int                       iBlockGetPos;
     int                       iBlockPutPos;
     int                       iBlockSize;
     uint8_t                   iSequenceNumberAtGetPos; // uint8_t so that it wraps automatically
+    uint8_t                   iSequenceNumberAtDecPos; // next block the decoder expects
+    int                       iDecBlockSize;
     EBufState                 eBufState;
     bool                      bUseSequenceNumber;
     bool                      bIsSimulation;
@@ -291,6 +318,50 @@ protected:
     static constexpr int iNumBytesSeqNum = 1; // per definition 1 byte sequence counter
 };
 
+template<typename TDecodeFunc>
+void CNetBuf::DecodeNewBlocks ( TDecodeFunc DecodeFunc )
+{
+    // decoding on arrival needs the sequence number to know the playback order
+    if ( ( iDecBlockSize == 0 ) || !bUseSequenceNumber || bIsSimulation )
+    {
+        return;
+    }
+
+    // the decoder position is relative to the get position, if the buffer
+    // window was moved in the meantime, we start at the get position
+    int iDecOffset = static_cast<int8_t> ( iSequenceNumberAtDecPos - iSequenceNumberAtGetPos );
+
+    if ( ( iDecOffset < 0 ) || ( iDecOffset > iNumBlocksMemory ) )
+    {
+        iDecOffset = 0;
+    }
+
+    while ( iDecOffset < iNumBlocksMemory )
+    {
+        const int iBlockPos = ( iBlockGetPos + iDecOffset ) % iNumBlocksMemory;
+
+        // stop at the first gap, it must be concealed first
+        if ( veciBlockValid[iBlockPos] == 0 )
+        {
+            break;
+        }
+
+        if ( veciBlockDecoded[iBlockPos] == 0 )
+        {
+            if ( !DecodeFunc ( &vecvecMemory[iBlockPos][0], iBlockSize, &vecvecsDecMemory[iBlockPos][0], iDecBlockSize ) )
+            {
+                break;
+            }
+
+            veciBlockDecoded[iBlockPos] = 1;
+        }
+
+        iDecOffset++;
+    }
+
+    iSequenceNumberAtDecPos = static_cast<uint8_t> ( iSequenceNumberAtGetPos + iDecOffset );
+}
+
 // Network buffer (jitter buffer) with statistic calculations ------------------
 class CNetBufWithStats : public CNetBuf
 {
@@ -358,6 +429,10 @@ public:
         iGetPos = 0;
     }
 
+    // after reserving the memory, Init() with a size up to the reserved size
+    // does not reallocate the memory (so that references to the data stay valid)
+    void Reserve ( const int iMaxMemSize ) { vecMemory.reserve ( iMaxMemSize ); }
+
     void SetBufferSize ( const int iNBSize )
     {
         // if buffer size has changed, apply new value and reset the buffer pointers
@@ -53,12 +53,14 @@ CChannel::CChannel ( const bool bNIsServer ) :
     iCurSockBufNumFrames ( INVALID_INDEX ),
     bDoAutoSockBufSize ( true ),
     bUseSequenceNumber ( false ), // this is important since in the client we reset on Channel.SetEnable ( false )
+    bDecodeOnArrival ( false ),
     iSendSequenceNumber ( 0 ),
     iFadeInCnt ( 0 ),
     iFadeInCntMax ( FADE_IN_NUM_FRAMES_DBLE_FRAMESIZE ),
     bIsEnabled ( false ),
     bIsServer ( bNIsServer ),
     bIsIdentified ( false ),
+    bIsAllocated ( !bNIsServer ),
     iAudioFrameSizeSamples ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES ),
     SignalLevelMeter ( false, 0.5 ) // server mode with mono out and faster smoothing
 {
@@ -73,9 +75,20 @@ CChannel::CChannel ( const bool bNIsServer ) :
     // init time-out for the buffer with zero -> no connection
     iConTimeOut = 0;
 
+    // the mixer must always find a valid gain/pan snapshot
+    PublishMixRow();
+
     // init the socket buffer
     SetSockBufNumFrames ( DEF_NET_BUF_SIZE_NUM_BL );
 
+    // the server sends the packets in batches which reference the conversion
+    // buffer memory, therefore a change of the network properties must not
+    // reallocate that memory
+    if ( bIsServer )
+    {
+        ConvBuf.Reserve ( MAX_SIZE_BYTES_NETW_BUF );
+    }
+
     // initialize channel info
     ResetInfo();
 
@@ -227,6 +240,7 @@ void CChannel::SetAudioStreamProperties ( const EAudComprType eNewAudComprType,
         {
             // init socket buffer
             SockBuf.SetUseDoubleSystemFrameSize ( eAudioCompressionType == CT_OPUS ); // NOTE must be set BEFORE the init()
+            SockBuf.SetDecodedBlockSize ( bDecodeOnArrival ? iAudioFrameSizeSamples * iNumAudioChannels : 0 );
             SockBuf.Init ( iCeltNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
         }
         MutexSocketBuf.unlock();
@@ -301,18 +315,24 @@ void CChannel::SetGain ( const int iChanID, const float fNewGain )
     // set value (make sure channel ID is in range)
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
-        // signal mute change
-        if ( ( vecfGains[iChanID] == 0 ) && ( fNewGain > 0 ) )
-        {
-            emit MuteStateHasChanged ( iChanID, false );
-        }
-        if ( ( vecfGains[iChanID] > 0 ) && ( fNewGain == 0 ) )
-        {
-            emit MuteStateHasChanged ( iChanID, true );
-        }
+        StoreGain ( iChanID, fNewGain );
+        PublishMixRow();
+    }
+}
 
-        vecfGains[iChanID] = fNewGain;
+void CChannel::StoreGain ( const int iChanID, const float fNewGain )
+{
+    // signal mute change
+    if ( ( vecfGains[iChanID] == 0 ) && ( fNewGain > 0 ) )
+    {
+        emit MuteStateHasChanged ( iChanID, false );
+    }
+    if ( ( vecfGains[iChanID] > 0 ) && ( fNewGain == 0 ) )
+    {
+        emit MuteStateHasChanged ( iChanID, true );
     }
+
+    vecfGains[iChanID] = fNewGain;
 }
 
 float CChannel::GetGain ( const int iChanID )
@@ -338,6 +358,7 @@ void CChannel::SetPan ( const int iChanID, const float fNewPan )
     if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
     {
         vecfPannings[iChanID] = fNewPan;
+        PublishMixRow();
     }
 }
 
@@ -356,6 +377,48 @@ float CChannel::GetPan ( const int iChanID )
     }
 }
 
+void CChannel::ResetGainsAndPans()
+{
+    QMutexLocker locker ( &Mutex );
+
+    for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+    {
+        StoreGain ( i, 1.0f );
+        vecfPannings[i] = 0.5f;
+    }
+
+    PublishMixRow();
+}
+
+void CChannel::SetGainAndPan ( const int iChanID, const float fNewGain, const float fNewPan )
+{
+    QMutexLocker locker ( &Mutex );
+
+    // set values (make sure channel ID is in range)
+    if ( ( iChanID >= 0 ) && ( iChanID < MAX_NUM_CHANNELS ) )
+    {
+        StoreGain ( iChanID, fNewGain );
+        vecfPannings[iChanID] = fNewPan;
+        PublishMixRow();
+    }
+}
+
+void CChannel::PublishMixRow()
+{
+    // note that the caller must hold the mutex
+    CChannelMixRow& NewRow = MixRow.GetWriteBuffer();
+
+    for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+    {
+        NewRow.fGain[i]  = vecfGains[i];
+        NewRow.fPan[i]   = vecfPannings[i];
+        NewRow.fGainL[i] = MathUtils::GetLeftPan ( vecfPannings[i], false ) * vecfGains[i];
+        NewRow.fGainR[i] = MathUtils::GetRightPan ( vecfPannings[i], false ) * vecfGains[i];
+    }
+
+    MixRow.Publish();
+}
+
 void CChannel::SetChanInfo ( const CChannelCoreInfo& NChanInf )
 {
     // apply value (if a new channel or different from previous one)
@@ -476,6 +539,7 @@ void CChannel::OnNetTranspPropsReceived ( CNetworkTransportProps NetworkTranspor
                 // update socket buffer (the network block size is a multiple of the
                 // minimum network frame size)
                 SockBuf.SetUseDoubleSystemFrameSize ( eAudioCompressionType == CT_OPUS ); // NOTE must be set BEFORE the init()
+                SockBuf.SetDecodedBlockSize ( bDecodeOnArrival ? iAudioFrameSizeSamples * iNumAudioChannels : 0 );
                 SockBuf.Init ( iCeltNumCodedBytes, iCurSockBufNumFrames, bUseSequenceNumber );
             }
             MutexSocketBuf.unlock();
@@ -537,6 +601,30 @@ void CChannel::Disconnect()
     }
 }
 
+void CChannel::Allocate ( const CHostAddress& NAddr )
+{
+    QMutexLocker locker ( &MutexSocketBuf );
+
+    SetAddress ( NAddr );
+    bIsAllocated = true;
+}
+
+bool CChannel::Release()
+{
+    QMutexLocker locker ( &MutexSocketBuf );
+
+    // an audio packet which was received after the disconnection has connected
+    // the channel again, in this case it stays allocated
+    if ( IsConnected() )
+    {
+        return false;
+    }
+
+    bIsAllocated = false;
+
+    return true;
+}
+
 void CChannel::PutProtocolData ( const int iRecCounter, const int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr )
 {
     // Only process protocol message if:
@@ -555,12 +643,14 @@ EPutDataStat CChannel::PutAudioData ( const CVector<uint8_t>& vecbyData, const i
     // init return state
     EPutDataStat eRet = PS_GEN_ERROR;
 
-    // Only process audio data if:
-    // - for client only: the packet comes from the server we want to talk to
-    // - the channel is enabled
-    if ( ( bIsServer || ( GetAddress() == RecHostAddr ) ) && IsEnabled() )
+    MutexSocketBuf.lock();
     {
-        MutexSocketBuf.lock();
+        // Only process audio data if:
+        // - the packet comes from the address of this channel (the server
+        //   looks up the channel without a lock, the channel may have been
+        //   released or allocated for another client in the meantime)
+        // - the channel is enabled
+        if ( bIsAllocated && ( GetAddress() == RecHostAddr ) && IsEnabled() )
         {
             // only process audio if packet has correct size
             if ( iNumBytes == ( iNetwFrameSize * iNetwFrameSizeFact ) )
@@ -612,23 +702,25 @@ EPutDataStat CChannel::PutAudioData ( const CVector<uint8_t>& vecbyData, const i
             // "IsConnected()" query above)
             ResetTimeOutCounter();
         }
-        MutexSocketBuf.unlock();
-    }
-    else
-    {
-        eRet = PS_AUDIO_INVALID;
+        else
+        {
+            eRet = PS_AUDIO_INVALID;
+        }
     }
+    MutexSocketBuf.unlock();
 
     return eRet;
 }
 
-EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes )
+EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes, int16_t* psDecData, const int iDecDataSize )
 {
     EGetDataStat eGetStatus;
 
     MutexSocketBuf.lock();
     {
-        // the socket access must be inside a mutex
+        // the socket access must be inside a mutex (if the block was already
+        // decoded on arrival, we get the decoded audio, too)
+        const bool bIsDecoded    = ( psDecData != nullptr ) && SockBuf.GetDecodedBlock ( psDecData, iDecDataSize );
         const bool bSockBufState = SockBuf.Get ( vecbyData, iNumBytes );
 
         // decrease time-out counter
@@ -654,7 +746,7 @@ EGetDataStat CChannel::GetData ( CVector<uint8_t>& vecbyData, const int iNumByte
                 if ( bSockBufState )
                 {
                     // everything is ok
-                    eGetStatus = GS_BUFFER_OK;
+                    eGetStatus = bIsDecoded ? GS_BUFFER_OK_DECODED : GS_BUFFER_OK;
                 }
                 else
                 {
@@ -704,6 +796,47 @@ void CChannel::PrepAndSendPacket ( CHighPrioSocket* pSocket, const CVector<uint8
     }
 }
 
+void CChannel::PrepAndSendPacket ( CHighPrioSocket*        pSocket,
+                                   CSocketSendBatch&       SendBatch,
+                                   const CVector<uint8_t>& vecbyNPacket,
+                                   const int               iNPacketLen )
+{
+    // see the comment about clients which have not sent the channel info above
+    if ( bIsServer && !bIsIdentified )
+    {
+        return;
+    }
+
+    QMutexLocker locker ( &MutexConvBuf );
+
+    if ( ConvBuf.Put ( vecbyNPacket, iNPacketLen, iSendSequenceNumber++ ) )
+    {
+        const CVector<uint8_t>& vecbyPacket = ConvBuf.GetAll();
+
+        if ( SendBatch.IsFull() )
+        {
+            pSocket->SendBatch ( SendBatch );
+        }
+
+        // the conversion buffer is not touched until the next frame, so the
+        // batch can reference the data without copying it
+        SendBatch.Add ( vecbyPacket.data(), vecbyPacket.Size(), SockAddr );
+    }
+}
+
+bool CChannel::PrepPacket ( const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen, CVector<uint8_t>& vecbyPacket )
+{
+    QMutexLocker locker ( &MutexConvBuf );
+
+    if ( ConvBuf.Put ( vecbyNPacket, iNPacketLen, iSendSequenceNumber++ ) )
+    {
+        vecbyPacket = ConvBuf.GetAll();
+        return true;
+    }
+
+    return false;
+}
+
 double CChannel::UpdateAndGetLevelForMeterdB ( const CVector<short>& vecsAudio, const int iInSize, const bool bIsStereoIn )
 {
     // update the signal level meter and immediately return the current value
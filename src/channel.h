@@ -82,6 +82,17 @@ enum EPutDataStat
 };
 
 /* Classes ********************************************************************/
+// gains/pans a listener has set for all other channels as used by the mixer,
+// the left/right gains have the pan law already applied
+class CChannelMixRow
+{
+public:
+    float fGain[MAX_NUM_CHANNELS];
+    float fPan[MAX_NUM_CHANNELS];
+    float fGainL[MAX_NUM_CHANNELS];
+    float fGainR[MAX_NUM_CHANNELS];
+};
+
 class CChannel : public QObject
 {
     Q_OBJECT
@@ -95,10 +106,29 @@ public:
 
     EPutDataStat PutAudioData ( const CVector<uint8_t>& vecbyData, const int iNumBytes, const CHostAddress& RecHostAddr );
 
-    EGetDataStat GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes );
+    EGetDataStat GetData ( CVector<uint8_t>& vecbyData, const int iNumBytes, int16_t* psDecData = nullptr, const int iDecDataSize = 0 );
+
+    // decode-on-arrival: the owner of the decoder decodes the new in-order
+    // blocks of the jitter buffer directly after they were received
+    void SetDecodeOnArrival ( const bool bNDecodeOnArrival ) { bDecodeOnArrival = bNDecodeOnArrival; }
+
+    template<typename TDecodeFunc>
+    void DecodeNewAudioData ( TDecodeFunc DecodeFunc )
+    {
+        QMutexLocker locker ( &MutexSocketBuf );
+
+        SockBuf.DecodeNewBlocks ( DecodeFunc );
+    }
 
     void PrepAndSendPacket ( CHighPrioSocket* pSocket, const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen );
 
+    // the packet is added to the batch which is sent later by the caller
+    void PrepAndSendPacket ( CHighPrioSocket* pSocket, CSocketSendBatch& SendBatch, const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen );
+
+    // the complete network packet is copied to the given vector and sent later
+    // by the caller, false is returned if no packet is ready yet
+    bool PrepPacket ( const CVector<uint8_t>& vecbyNPacket, const int iNPacketLen, CVector<uint8_t>& vecbyPacket );
+
     void ResetTimeOutCounter() { iConTimeOut = iConTimeOutStartVal; }
     bool IsConnected() const { return iConTimeOut > 0; }
     void Disconnect();
@@ -106,9 +136,18 @@ public:
     void SetEnable ( const bool bNEnStat );
     bool IsEnabled() { return bIsEnabled; }
 
-    void                SetAddress ( const CHostAddress& NAddr ) { InetAddr = NAddr; }
+    void SetAddress ( const CHostAddress& NAddr )
+    {
+        InetAddr = NAddr;
+        SockAddr.Set ( NAddr );
+    }
     const CHostAddress& GetAddress() const { return InetAddr; }
 
+    // server only: a channel is allocated for a client address and released
+    // when it is disconnected, audio packets are only accepted in between
+    void Allocate ( const CHostAddress& NAddr );
+    bool Release();
+
     void ResetInfo()
     {
         bIsIdentified = false;
@@ -131,6 +170,12 @@ public:
     void  SetPan ( const int iChanID, const float fNewPan );
     float GetPan ( const int iChanID );
 
+    void ResetGainsAndPans();
+    void SetGainAndPan ( const int iChanID, const float fNewGain, const float fNewPan );
+
+    // lock-free access for the mixer, must only be called by one thread at a time
+    const CChannelMixRow& GetMixRow() { return MixRow.GetReadBuffer(); }
+
     void SetRemoteChanGain ( const int iId, const float fGain ) { Protocol.CreateChanGainMes ( iId, fGain ); }
 
     void SetRemoteChanPan ( const int iId, const float fPan ) { Protocol.CreateChanPanMes ( iId, fPan ); }
@@ -152,6 +197,7 @@ public:
 
     bool GetDoAutoSockBufSize() const { return bDoAutoSockBufSize; }
 
+    int GetNetwFrameSize() const { return iNetwFrameSize; }
     int GetNetwFrameSizeFact() const { return iNetwFrameSizeFact; }
     int GetCeltNumCodedBytes() const { return iCeltNumCodedBytes; }
 
@@ -195,6 +241,8 @@ public:
 
 protected:
     bool ProtocolIsEnabled();
+    void StoreGain ( const int iChanID, const float fNewGain );
+    void PublishMixRow();
 
     void ResetNetworkTransportProperties()
     {
@@ -210,20 +258,23 @@ protected:
     }
 
     // connection parameters
-    CHostAddress InetAddr;
+    CHostAddress   InetAddr;
+    CSocketAddress SockAddr;
 
     // channel info
     CChannelCoreInfo ChannelInfo;
 
     // mixer and effect settings
-    CVector<float> vecfGains;
-    CVector<float> vecfPannings;
+    CVector<float>                vecfGains;
+    CVector<float>                vecfPannings;
+    CTripleBuffer<CChannelMixRow> MixRow;
 
     // network jitter-buffer
     CNetBufWithStats SockBuf;
     int              iCurSockBufNumFrames;
     bool             bDoAutoSockBufSize;
     bool             bUseSequenceNumber;
+    bool             bDecodeOnArrival;
     uint8_t          iSendSequenceNumber;
 
     // network output conversion buffer
@@ -240,6 +291,7 @@ protected:
     std::atomic<bool> bIsEnabled;
     bool              bIsServer;
     bool              bIsIdentified;
+    bool              bIsAllocated; // protected by MutexSocketBuf
 
     int iNetwFrameSizeFact;
     int iNetwFrameSize;
@@ -274,12 +326,12 @@ public slots:
         Protocol.ParseMessageBody ( vecbyMesBodyData, iRecCounter, iRecID );
     }
 
-    void OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
+    void OnProtocolMessageReceived ( int iRecCounter, int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr )
     {
         PutProtocolData ( iRecCounter, iRecID, vecbyMesBodyData, RecHostAddr );
     }
 
-    void OnProtocolCLMessageReceived ( int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
+    void OnProtocolCLMessageReceived ( int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr )
     {
         emit DetectedCLMessage ( vecbyMesBodyData, iRecID, RecHostAddr );
     }
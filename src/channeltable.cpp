@@ -0,0 +1,250 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "channeltable.h"
+
+/* Implementation *************************************************************/
+CChannelTable::CChannelTable() : iMaxNumChannels ( 0 ), iNumChannels ( 0 ), iSequence ( 0 )
+{
+    for ( SSlot& Slot : vecSlots )
+    {
+        Slot.iAddrHi   = 0;
+        Slot.iAddrLo   = 0;
+        Slot.iPortHash = 0;
+        Slot.iScopeId  = 0;
+        Slot.iChanID   = INVALID_INDEX;
+    }
+
+    Init ( MAX_NUM_CHANNELS );
+}
+
+void CChannelTable::Init ( const int iNewMaxNumChannels )
+{
+    BeginWrite();
+
+    for ( SSlot& Slot : vecSlots )
+    {
+        Slot.iChanID.store ( INVALID_INDEX, std::memory_order_relaxed );
+    }
+
+    for ( int i = 0; i < MAX_NUM_CHANNELS; i++ )
+    {
+        vecbChanUsed[i] = false;
+    }
+
+    iMaxNumChannels = std::min ( iNewMaxNumChannels, MAX_NUM_CHANNELS );
+    iNumChannels.store ( 0, std::memory_order_relaxed );
+
+    EndWrite();
+}
+
+CChannelTable::SKey CChannelTable::MakeKey ( const CHostAddress& Addr )
+{
+    SKey Key;
+
+    // the host address is stored as raw bytes (IPv4 is IPv4-mapped), so the
+    // key can be built by a plain copy, the precomputed address hash is
+    // carried along in the upper half of the port word
+    memcpy ( &Key.iAddrHi, &Addr.byAddr[0], sizeof ( Key.iAddrHi ) );
+    memcpy ( &Key.iAddrLo, &Addr.byAddr[8], sizeof ( Key.iAddrLo ) );
+    Key.iPortHash = Addr.iPort | ( static_cast<uint32_t> ( Addr.GetHash() ) << 16 );
+    Key.iScopeId  = Addr.iScopeId;
+
+    return Key;
+}
+
+int CChannelTable::Hash ( const SKey& Key ) { return static_cast<int> ( ( Key.iPortHash >> 16 ) & ( CHANNEL_TABLE_SIZE - 1 ) ); }
+
+int CChannelTable::Find ( const CHostAddress& Addr ) const
+{
+    const SKey Key   = MakeKey ( Addr );
+    const int  iHash = Hash ( Key );
+    int        iChanID;
+    uint32_t   iSeqStart;
+
+    do
+    {
+        // wait until a writer has finished (this is very short and rare)
+        while ( ( iSeqStart = iSequence.load ( std::memory_order_acquire ) ) & 1 )
+        {
+        }
+
+        iChanID = INVALID_INDEX;
+
+        // the probe sequence ends at the first empty slot, the number of probes
+        // is limited since we may see an inconsistent table during a write
+        for ( int i = 0, iSlot = iHash; i < CHANNEL_TABLE_SIZE; i++, iSlot = ( iSlot + 1 ) & ( CHANNEL_TABLE_SIZE - 1 ) )
+        {
+            const SSlot& Slot        = vecSlots[iSlot];
+            const int    iSlotChanID = Slot.iChanID.load ( std::memory_order_relaxed );
+
+            if ( iSlotChanID == INVALID_INDEX )
+            {
+                break;
+            }
+
+            if ( ( Slot.iPortHash.load ( std::memory_order_relaxed ) == Key.iPortHash ) &&
+                 ( Slot.iAddrLo.load ( std::memory_order_relaxed ) == Key.iAddrLo ) &&
+                 ( Slot.iAddrHi.load ( std::memory_order_relaxed ) == Key.iAddrHi ) &&
+                 ( Slot.iScopeId.load ( std::memory_order_relaxed ) == Key.iScopeId ) )
+            {
+                iChanID = iSlotChanID;
+                break;
+            }
+        }
+
+        // the reads of the slots must be done before the sequence is checked again
+        std::atomic_thread_fence ( std::memory_order_acquire );
+    } while ( iSequence.load ( std::memory_order_relaxed ) != iSeqStart );
+
+    return iChanID;
+}
+
+int CChannelTable::GetFreeChannel() const
+{
+    // use the lowest free channel ID
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        if ( !vecbChanUsed[i] )
+        {
+            return i;
+        }
+    }
+
+    return INVALID_INDEX;
+}
+
+void CChannelTable::Add ( const CHostAddress& Addr, const int iChanID )
+{
+    const SKey Key   = MakeKey ( Addr );
+    int        iSlot = Hash ( Key );
+
+    // find the first empty slot of the probe sequence (there is always one)
+    while ( vecSlots[iSlot].iChanID.load ( std::memory_order_relaxed ) != INVALID_INDEX )
+    {
+        iSlot = ( iSlot + 1 ) & ( CHANNEL_TABLE_SIZE - 1 );
+    }
+
+    BeginWrite();
+
+    vecSlots[iSlot].iAddrHi.store ( Key.iAddrHi, std::memory_order_relaxed );
+    vecSlots[iSlot].iAddrLo.store ( Key.iAddrLo, std::memory_order_relaxed );
+    vecSlots[iSlot].iPortHash.store ( Key.iPortHash, std::memory_order_relaxed );
+    vecSlots[iSlot].iScopeId.store ( Key.iScopeId, std::memory_order_relaxed );
+    vecSlots[iSlot].iChanID.store ( iChanID, std::memory_order_relaxed );
+
+    vecChanKeys[iChanID]  = Key;
+    vecbChanUsed[iChanID] = true;
+    iNumChannels.fetch_add ( 1, std::memory_order_relaxed );
+
+    EndWrite();
+}
+
+void CChannelTable::Remove ( const int iChanID )
+{
+    if ( ( iChanID < 0 ) || ( iChanID >= MAX_NUM_CHANNELS ) || !vecbChanUsed[iChanID] )
+    {
+        return;
+    }
+
+    int iSlot = Hash ( vecChanKeys[iChanID] );
+
+    while ( vecSlots[iSlot].iChanID.load ( std::memory_order_relaxed ) != iChanID )
+    {
+        iSlot = ( iSlot + 1 ) & ( CHANNEL_TABLE_SIZE - 1 );
+    }
+
+    BeginWrite();
+
+    // Instead of leaving a deleted marker, the following entries of the probe
+    // sequence are moved back if the freed slot is part of their probe sequence.
+    int iNext = ( iSlot + 1 ) & ( CHANNEL_TABLE_SIZE - 1 );
+
+    while ( vecSlots[iNext].iChanID.load ( std::memory_order_relaxed ) != INVALID_INDEX )
+    {
+        const int iHome = Hash ( vecChanKeys[vecSlots[iNext].iChanID.load ( std::memory_order_relaxed )] );
+
+        // the entry stays if its home slot is cyclically in ( iSlot, iNext ]
+        const bool bStays = ( iSlot <= iNext ) ? ( ( iSlot < iHome ) && ( iHome <= iNext ) ) : ( ( iSlot < iHome ) || ( iHome <= iNext ) );
+
+        if ( !bStays )
+        {
+            MoveSlot ( iSlot, iNext );
+            iSlot = iNext;
+        }
+
+        iNext = ( iNext + 1 ) & ( CHANNEL_TABLE_SIZE - 1 );
+    }
+
+    vecSlots[iSlot].iChanID.store ( INVALID_INDEX, std::memory_order_relaxed );
+
+    vecbChanUsed[iChanID] = false;
+    iNumChannels.fetch_sub ( 1, std::memory_order_relaxed );
+
+    EndWrite();
+}
+
+void CChannelTable::MoveSlot ( const int iTo, const int iFrom )
+{
+    vecSlots[iTo].iAddrHi.store ( vecSlots[iFrom].iAddrHi.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+    vecSlots[iTo].iAddrLo.store ( vecSlots[iFrom].iAddrLo.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+    vecSlots[iTo].iPortHash.store ( vecSlots[iFrom].iPortHash.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+    vecSlots[iTo].iScopeId.store ( vecSlots[iFrom].iScopeId.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+    vecSlots[iTo].iChanID.store ( vecSlots[iFrom].iChanID.load ( std::memory_order_relaxed ), std::memory_order_relaxed );
+}
+
+void CChannelTable::BeginWrite()
+{
+    // make the sequence odd before any slot is modified
+    iSequence.store ( iSequence.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    std::atomic_thread_fence ( std::memory_order_release );
+}
+
+void CChannelTable::EndWrite()
+{
+    // make the sequence even after all slots are modified
+    iSequence.store ( iSequence.load ( std::memory_order_relaxed ) + 1, std::memory_order_release );
+}
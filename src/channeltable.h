@@ -0,0 +1,125 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "global.h"
+#include "util.h"
+
+/* Definitions ****************************************************************/
+// number of slots of the channel table, must be a power of two and at least
+// twice the maximum number of channels so that the probe sequences stay short
+#define CHANNEL_TABLE_SIZE 512
+
+static_assert ( ( CHANNEL_TABLE_SIZE & ( CHANNEL_TABLE_SIZE - 1 ) ) == 0, "CHANNEL_TABLE_SIZE must be a power of two" );
+static_assert ( CHANNEL_TABLE_SIZE >= 2 * MAX_NUM_CHANNELS, "CHANNEL_TABLE_SIZE is too small" );
+
+/* Classes ********************************************************************/
+// Maps the address of a client to its channel ID. The table uses open
+// addressing with linear probing on a packed (IP address, scope id, port) key.
+// Find() does not take any lock and can be called from several threads at the
+// same time: the table is protected by a sequence counter and a reader repeats
+// the lookup if a writer modified the table in the meantime. New and freed
+// channels are rare, the writer functions must be serialised by the caller.
+class CChannelTable
+{
+public:
+    CChannelTable();
+
+    void Init ( const int iNewMaxNumChannels );
+
+    // returns the channel ID or INVALID_INDEX if the address is unknown
+    int Find ( const CHostAddress& Addr ) const;
+
+    // writer functions
+    int  GetFreeChannel() const;
+    void Add ( const CHostAddress& Addr, const int iChanID );
+    void Remove ( const int iChanID );
+
+    bool IsUsed ( const int iChanID ) const { return vecbChanUsed[iChanID]; }
+    int  GetNumChannels() const { return iNumChannels.load ( std::memory_order_relaxed ); }
+
+protected:
+    struct SKey
+    {
+        uint64_t iAddrHi;
+        uint64_t iAddrLo;
+        uint32_t iPortHash; // port and the address hash
+        uint32_t iScopeId;  // IPv6 scope id
+    };
+
+    // all fields are atomic since they are read while a writer may modify them,
+    // a slot is empty if its channel ID is INVALID_INDEX
+    struct SSlot
+    {
+        std::atomic<uint64_t> iAddrHi;
+        std::atomic<uint64_t> iAddrLo;
+        std::atomic<uint32_t> iPortHash;
+        std::atomic<uint32_t> iScopeId;
+        std::atomic<int>      iChanID;
+    };
+
+    static SKey MakeKey ( const CHostAddress& Addr );
+    static int  Hash ( const SKey& Key );
+
+    void BeginWrite();
+    void EndWrite();
+    void MoveSlot ( const int iTo, const int iFrom );
+
+    SSlot vecSlots[CHANNEL_TABLE_SIZE];
+
+    // only used by the writer
+    SKey vecChanKeys[MAX_NUM_CHANNELS];
+    bool vecbChanUsed[MAX_NUM_CHANNELS];
+    int  iMaxNumChannels;
+
+    std::atomic<int>      iNumChannels;
+    std::atomic<uint32_t> iSequence; // odd while the table is modified
+};
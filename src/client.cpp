@@ -110,25 +110,11 @@ CClient::CClient ( const quint16  iPortNumber,
     Opus64EncoderStereo = opus_custom_encoder_create ( Opus64Mode, 2, &iOpusError ); // stereo encoder OPUS64
     Opus64DecoderStereo = opus_custom_decoder_create ( Opus64Mode, 2, &iOpusError ); // stereo decoder OPUS64
 
-    // we require a constant bit rate
-    opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_VBR ( 0 ) );
-    opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_VBR ( 0 ) );
-    opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_VBR ( 0 ) );
-    opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_VBR ( 0 ) );
-
-    // for 64 samples frame size we have to adjust the PLC behavior to avoid loud artifacts
-    opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
-    opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
-
-    // we want as low delay as possible
-    opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-    opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-    opus_custom_encoder_ctl ( Opus64EncoderMono, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-    opus_custom_encoder_ctl ( Opus64EncoderStereo, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
-
-    // set encoder low complexity for legacy 128 samples frame size
-    opus_custom_encoder_ctl ( OpusEncoderMono, OPUS_SET_COMPLEXITY ( 1 ) );
-    opus_custom_encoder_ctl ( OpusEncoderStereo, OPUS_SET_COMPLEXITY ( 1 ) );
+    // same encoder settings as used by the load generator and the benchmarks
+    COpusCoding::InitEncoder ( OpusEncoderMono, CT_OPUS );
+    COpusCoding::InitEncoder ( OpusEncoderStereo, CT_OPUS );
+    COpusCoding::InitEncoder ( Opus64EncoderMono, CT_OPUS64 );
+    COpusCoding::InitEncoder ( Opus64EncoderStereo, CT_OPUS64 );
 
     // Connections -------------------------------------------------------------
     // connections for the protocol mechanism
@@ -1193,151 +1179,32 @@ void CClient::Init()
     }
 
     // inits for audio coding
+    iOPUSFrameSizeSamples = COpusCoding::GetFrameSizeSamples ( eAudioCompressionType );
+    iNumAudioChannels     = ( eAudioChannelConf == CC_MONO ) ? 1 : 2;
+
     if ( eAudioCompressionType == CT_OPUS )
     {
-        iOPUSFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
-
-        if ( eAudioChannelConf == CC_MONO )
-        {
-            CurOpusEncoder    = OpusEncoderMono;
-            CurOpusDecoder    = OpusDecoderMono;
-            iNumAudioChannels = 1;
-
-            switch ( eAudioQuality )
-            {
-            case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_RAW:
-                if ( bRawAudioIsSupported )
-                {
-                    // no OPUS encoding or decoding
-                    CurOpusEncoder = nullptr;
-                    CurOpusDecoder = nullptr;
-
-                    iCeltNumCodedBytes = sizeof ( int16_t ) * iNumAudioChannels * iOPUSFrameSizeSamples;
-                }
-                else
-                {
-                    // fall back to highest OPUS quality
-                    iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE;
-                }
-                break;
-            }
-        }
-        else
-        {
-            CurOpusEncoder    = OpusEncoderStereo;
-            CurOpusDecoder    = OpusDecoderStereo;
-            iNumAudioChannels = 2;
-
-            switch ( eAudioQuality )
-            {
-            case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE;
-                break;
-            case AQ_RAW:
-                if ( bRawAudioIsSupported )
-                {
-                    // no OPUS encoding or decoding
-                    CurOpusEncoder = nullptr;
-                    CurOpusDecoder = nullptr;
-
-                    iCeltNumCodedBytes = sizeof ( int16_t ) * iNumAudioChannels * iOPUSFrameSizeSamples;
-                }
-                else
-                {
-                    // fall back to highest OPUS quality
-                    iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE;
-                }
-                break;
-            }
-        }
+        CurOpusEncoder = ( iNumAudioChannels == 1 ) ? OpusEncoderMono : OpusEncoderStereo;
+        CurOpusDecoder = ( iNumAudioChannels == 1 ) ? OpusDecoderMono : OpusDecoderStereo;
     }
     else /* CT_OPUS64 */
     {
-        iOPUSFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
-
-        if ( eAudioChannelConf == CC_MONO )
-        {
-            CurOpusEncoder    = Opus64EncoderMono;
-            CurOpusDecoder    = Opus64DecoderMono;
-            iNumAudioChannels = 1;
-
-            switch ( eAudioQuality )
-            {
-            case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_LOW_QUALITY;
-                break;
-            case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_NORMAL_QUALITY;
-                break;
-            case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY;
-                break;
-            case AQ_RAW:
-                if ( bRawAudioIsSupported )
-                {
-                    // no OPUS encoding or decoding
-                    CurOpusEncoder = nullptr;
-                    CurOpusDecoder = nullptr;
-
-                    iCeltNumCodedBytes = sizeof ( int16_t ) * iNumAudioChannels * iOPUSFrameSizeSamples;
-                }
-                else
-                {
-                    // fall back to highest OPUS quality
-                    iCeltNumCodedBytes = OPUS_NUM_BYTES_MONO_HIGH_QUALITY;
-                }
-                break;
-            }
-        }
-        else
-        {
-            CurOpusEncoder    = Opus64EncoderStereo;
-            CurOpusDecoder    = Opus64DecoderStereo;
-            iNumAudioChannels = 2;
+        CurOpusEncoder = ( iNumAudioChannels == 1 ) ? Opus64EncoderMono : Opus64EncoderStereo;
+        CurOpusDecoder = ( iNumAudioChannels == 1 ) ? Opus64DecoderMono : Opus64DecoderStereo;
+    }
 
-            switch ( eAudioQuality )
-            {
-            case AQ_LOW:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_LOW_QUALITY;
-                break;
-            case AQ_NORMAL:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY;
-                break;
-            case AQ_HIGH:
-                iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
-                break;
-            case AQ_RAW:
-                if ( bRawAudioIsSupported )
-                {
-                    // no OPUS encoding or decoding
-                    CurOpusEncoder = nullptr;
-                    CurOpusDecoder = nullptr;
+    if ( ( eAudioQuality == AQ_RAW ) && bRawAudioIsSupported )
+    {
+        // no OPUS encoding or decoding
+        CurOpusEncoder = nullptr;
+        CurOpusDecoder = nullptr;
 
-                    iCeltNumCodedBytes = sizeof ( int16_t ) * iNumAudioChannels * iOPUSFrameSizeSamples;
-                }
-                else
-                {
-                    // fall back to highest OPUS quality
-                    iCeltNumCodedBytes = OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
-                }
-                break;
-            }
-        }
+        iCeltNumCodedBytes = sizeof ( int16_t ) * iNumAudioChannels * iOPUSFrameSizeSamples;
+    }
+    else
+    {
+        // without raw audio support on the server, we fall back to highest OPUS quality
+        iCeltNumCodedBytes = COpusCoding::GetNumCodedBytes ( eAudioCompressionType, iNumAudioChannels, eAudioQuality );
     }
 
     // calculate stereo (two channels) buffer size
@@ -1350,8 +1217,7 @@ void CClient::Init()
     // In case we are connected to a non raw audio server or we don't use raw audio we need to initialze the codec
     if ( CurOpusEncoder != nullptr )
     {
-        opus_custom_encoder_ctl ( CurOpusEncoder,
-                                  OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, iOPUSFrameSizeSamples ) ) );
+        COpusCoding::SetEncoderBitRate ( CurOpusEncoder, eAudioCompressionType, iCeltNumCodedBytes );
     }
 
     // inits for network and channel
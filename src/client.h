@@ -101,31 +101,6 @@
 // this will be increased to double the ping time if connected to a distant server
 #define DEFAULT_GAIN_DELAY_PERIOD_MS 50
 
-// OPUS number of coded bytes per audio packet
-// TODO we have to use new numbers for OPUS to avoid that old CELT packets
-// are used in the OPUS decoder (which gives a bad noise output signal).
-// Later on when the CELT is completely removed we could set the OPUS
-// numbers back to the original CELT values (to reduce network load)
-
-// calculation to get from the number of bytes to the code rate in bps:
-// rate [pbs] = Fs / L * N * 8, where
-// Fs: sampling rate (SYSTEM_SAMPLE_RATE_HZ)
-// L:  number of samples per packet (SYSTEM_FRAME_SIZE_SAMPLES)
-// N:  number of bytes per packet (values below)
-#define OPUS_NUM_BYTES_MONO_LOW_QUALITY                   12
-#define OPUS_NUM_BYTES_MONO_NORMAL_QUALITY                22
-#define OPUS_NUM_BYTES_MONO_HIGH_QUALITY                  36
-#define OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE    25
-#define OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE 45
-#define OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE   82
-
-#define OPUS_NUM_BYTES_STEREO_LOW_QUALITY                   24
-#define OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY                35
-#define OPUS_NUM_BYTES_STEREO_HIGH_QUALITY                  73
-#define OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE    47
-#define OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE 71
-#define OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE   165
-
 /* Classes ********************************************************************/
 
 class CClientChannel
@@ -376,7 +376,7 @@ void CConnectDlg::SetServerList ( const CHostAddress& InetAddr, const CVector<CS
     // we only accept a server list from the server address we have sent the
     // request for this to (note that we cannot use the port number since the
     // receive port and send port might be different at the directory server).
-    if ( bServerListReceived || ( InetAddr.InetAddr != haDirectoryAddress.InetAddr ) )
+    if ( bServerListReceived || !InetAddr.HasSameIP ( haDirectoryAddress ) )
     {
         return;
     }
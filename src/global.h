@@ -162,6 +162,31 @@ LED bar:      lbr
 // gets in trouble if the value is too low)
 #define CELT_MINIMUM_NUM_BYTES 10
 
+// OPUS number of coded bytes per audio packet
+// TODO we have to use new numbers for OPUS to avoid that old CELT packets
+// are used in the OPUS decoder (which gives a bad noise output signal).
+// Later on when the CELT is completely removed we could set the OPUS
+// numbers back to the original CELT values (to reduce network load)
+
+// calculation to get from the number of bytes to the code rate in bps:
+// rate [pbs] = Fs / L * N * 8, where
+// Fs: sampling rate (SYSTEM_SAMPLE_RATE_HZ)
+// L:  number of samples per packet (SYSTEM_FRAME_SIZE_SAMPLES)
+// N:  number of bytes per packet (values below)
+#define OPUS_NUM_BYTES_MONO_LOW_QUALITY                   12
+#define OPUS_NUM_BYTES_MONO_NORMAL_QUALITY                22
+#define OPUS_NUM_BYTES_MONO_HIGH_QUALITY                  36
+#define OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE    25
+#define OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE 45
+#define OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE   82
+
+#define OPUS_NUM_BYTES_STEREO_LOW_QUALITY                   24
+#define OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY                35
+#define OPUS_NUM_BYTES_STEREO_HIGH_QUALITY                  73
+#define OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE    47
+#define OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE 71
+#define OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE   165
+
 // Maximum block size for network input buffer. It is defined by the longest
 // protocol message which is PROTMESSID_CLM_SERVER_LIST: Worst case:
 // (2+2+1+2+2)+200*(4+2+2+1+1+2+20+2+32+2+20)=17609
@@ -345,7 +370,10 @@ typedef unsigned char      uint8_t;
 
 /* Pseudo enum definitions -------------------------------------------------- */
 // definition for custom event
-#define MS_PACKET_RECEIVED 0
+#define MS_PACKET_RECEIVED        0
+#define MS_CHAN_DISCONNECTED      1
+#define MS_NO_CLIENTS             2
+#define MS_OVERLOAD_LEVEL_CHANGED 3
 
 /* Classes ********************************************************************/
 class CGenErr
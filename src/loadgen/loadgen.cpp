@@ -0,0 +1,679 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "loadgen.h"
+#include <QCoreApplication>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#ifdef USE_OPUS_SHARED_LIB
+#    include "opus/opus_custom.h"
+#else
+#    include "opus_custom.h"
+#endif
+#include "../signalhandler.h"
+
+/* Implementation *************************************************************/
+void CLoadGenClientStats::Add ( const CLoadGenClientStats& Stats )
+{
+    iNumConnected += Stats.iNumConnected;
+    iNumPacketsSent += Stats.iNumPacketsSent;
+    iNumPacketsLost += Stats.iNumPacketsLost;
+    iNumPacketsReceived += Stats.iNumPacketsReceived;
+    iNumFramesOnTime += Stats.iNumFramesOnTime;
+    iNumFramesLate += Stats.iNumFramesLate;
+
+    // the jitter is summed up here, the caller calculates the mean
+    fJitterMs += Stats.fJitterMs;
+    fMaxJitterMs = std::max ( fMaxJitterMs, Stats.fMaxJitterMs );
+}
+
+/******************************************************************************\
+* Virtual client                                                               *
+\******************************************************************************/
+CLoadGenClient::CLoadGenClient ( const int                        iNClientID,
+                                 const CLoadGenSettings&          Settings,
+                                 const int                        iNCeltNumCodedBytes,
+                                 const CVector<CVector<uint8_t>>& vecvecbyNCodedFrames ) :
+    iClientID ( iNClientID ),
+    ServerAddr ( Settings.ServerAddr ),
+    iCeltNumCodedBytes ( iNCeltNumCodedBytes ),
+    iNetwFrameSizeFact ( Settings.iNetwFrameSizeFact ),
+    iPacketPeriodNs ( static_cast<int64_t> ( Settings.iNetwFrameSizeFact ) *
+                      ( Settings.eAudComprType == CT_OPUS ? DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES : SYSTEM_FRAME_SIZE_SAMPLES ) * 1000000000 /
+                      SYSTEM_SAMPLE_RATE_HZ ),
+    iJitterNs ( static_cast<int64_t> ( Settings.iJitterMs ) * 1000000 ),
+    dLossProbability ( Settings.dLossPercent / 100 ),
+    vecvecbyCodedFrames ( vecvecbyNCodedFrames ),
+    UdpSocket ( INVALID_SOCKET ),
+    Channel ( false ), // client channel
+    iStartNs ( 0 ),
+    iHandshakeNs ( -1 ),
+    bIsConnected ( false ),
+    bIsActive ( false ),
+    iNextPacketNs ( 0 ),
+    iLastDueNs ( 0 ),
+    iFrameIdx ( 0 ),
+    bPlayoutStarted ( false ),
+    iSendQueueReadPos ( 0 ),
+    iSendQueueWritePos ( 0 ),
+    vecbyNetwData ( iNCeltNumCodedBytes ),
+    iNumPacketsSent ( 0 ),
+    iNumPacketsLost ( 0 ),
+    iNumFramesOnTime ( 0 ),
+    iNumFramesLate ( 0 ),
+    iLastArrivalNs ( 0 ),
+    iNumPacketsReceived ( 0 ),
+    fJitterMs ( 0 ),
+    fMaxJitterMs ( 0 )
+{
+    ChannelInfo.strName = QString ( "loadgen-%1" ).arg ( iClientID );
+
+    // the packets are sent to the server only
+    Channel.SetAddress ( ServerAddr );
+
+    // a fixed jitter buffer size makes the late frames comparable between runs
+    Channel.SetDoAutoSockBufSize ( false );
+    Channel.SetSockBufNumFrames ( Settings.iSockBufNumFrames );
+
+    Channel.SetAudioStreamProperties ( Settings.eAudComprType, iCeltNumCodedBytes, iNetwFrameSizeFact, Settings.iNumAudioChannels );
+
+    // the protocol messages are received in the receive thread
+    QObject::connect ( this, &CLoadGenClient::ProtocolMessageReceived, &Channel, &CChannel::OnProtocolMessageReceived, Qt::QueuedConnection );
+
+    QObject::connect ( this, &CLoadGenClient::NewConnection, this, &CLoadGenClient::OnNewConnection, Qt::QueuedConnection );
+
+    QObject::connect ( &Channel, &CChannel::MessReadyForSending, this, &CLoadGenClient::OnSendProtMessage );
+
+    QObject::connect ( &Channel, &CChannel::ReqJittBufSize, this, &CLoadGenClient::OnReqJittBufSize );
+
+    QObject::connect ( &Channel, &CChannel::ReqChanInfo, this, &CLoadGenClient::OnReqChanInfo );
+
+    QObject::connect ( &Channel, &CChannel::Disconnected, this, &CLoadGenClient::OnDisconnected );
+
+    QObject::connect ( &ConnLessProtocol, &CProtocol::CLMessReadyForSending, this, &CLoadGenClient::OnSendCLProtMessage );
+
+    for ( int i = 0; i < LOADGEN_SEND_QUEUE_SIZE; i++ )
+    {
+        vecSendQueue[i].iDueNs = 0;
+        vecSendQueue[i].vecbyData.reserve ( MAX_SIZE_BYTES_NETW_BUF );
+    }
+
+    LostPacket.iDueNs = 0;
+}
+
+CLoadGenClient::~CLoadGenClient()
+{
+    if ( UdpSocket != INVALID_SOCKET )
+    {
+        close ( UdpSocket );
+    }
+}
+
+int64_t CLoadGenClient::Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds> ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+bool CLoadGenClient::Open()
+{
+    const CSocketAddress ServerSockAddr ( ServerAddr );
+
+    UdpSocket = socket ( ServerSockAddr.IsIPv6() ? AF_INET6 : AF_INET, SOCK_DGRAM, 0 );
+
+    if ( UdpSocket == INVALID_SOCKET )
+    {
+        return false;
+    }
+
+    // the socket is connected to the server so that only the packets of the
+    // server are received, the local port is chosen by the system
+    if ( ::connect ( UdpSocket, &ServerSockAddr.Addr.Generic, ServerSockAddr.iLen ) != 0 )
+    {
+        return false;
+    }
+
+    // the receive thread reads until the socket is drained
+    return fcntl ( UdpSocket, F_SETFL, fcntl ( UdpSocket, F_GETFL, 0 ) | O_NONBLOCK ) == 0;
+}
+
+void CLoadGenClient::Start()
+{
+    Channel.SetEnable ( true );
+
+    // the send thread starts with the first packet directly
+    iStartNs      = Now();
+    iNextPacketNs = iStartNs;
+    iLastDueNs    = iStartNs;
+
+    bIsActive.store ( true, std::memory_order_release );
+}
+
+void CLoadGenClient::Stop()
+{
+    // must only be called if the send thread is stopped
+    if ( bIsActive.load ( std::memory_order_relaxed ) )
+    {
+        bIsActive.store ( false, std::memory_order_relaxed );
+
+        // tell the server that we are gone instead of waiting for the time-out
+        ConnLessProtocol.CreateCLDisconnection ( ServerAddr );
+
+        Channel.SetEnable ( false );
+    }
+}
+
+void CLoadGenClient::SendPacket ( const CVector<uint8_t>& vecbyData )
+{
+    // errors are ignored, e.g. if no server is running yet
+    send ( UdpSocket, (const char*) &vecbyData[0], vecbyData.Size(), 0 );
+}
+
+void CLoadGenClient::OnNewConnection()
+{
+    // the server only sends audio after it has received our channel info,
+    // therefore the first received mix completes the handshake
+    if ( iHandshakeNs < 0 )
+    {
+        iHandshakeNs = Now() - iStartNs;
+    }
+
+    bIsConnected = true;
+
+    // same as in the client: send infos and request the connected clients list
+    Channel.SetRemoteInfo ( ChannelInfo );
+    Channel.CreateReqConnClientsList();
+    Channel.CreateJitBufMes ( AUTO_NET_BUF_SIZE_FOR_PROTOCOL );
+}
+
+void CLoadGenClient::ReceivePackets ( CVector<uint8_t>& vecbyRecBuf, CVector<uint8_t>& vecbyMesBodyData )
+{
+    for ( ;; )
+    {
+        const long iNumBytesRead = recv ( UdpSocket, (char*) &vecbyRecBuf[0], MAX_SIZE_BYTES_NETW_BUF, 0 );
+
+        // the socket is drained or an error occurred (e.g. no server is running)
+        if ( iNumBytesRead <= 0 )
+        {
+            return;
+        }
+
+        int iRecCounter;
+        int iRecID;
+
+        if ( !CProtocol::ParseMessageFrame ( vecbyRecBuf, iNumBytesRead, vecbyMesBodyData, iRecCounter, iRecID ) )
+        {
+            // connection less messages (e.g. server full) are not evaluated
+            if ( !CProtocol::IsConnectionLessMessageID ( iRecID ) )
+            {
+                emit ProtocolMessageReceived ( iRecCounter, iRecID, vecbyMesBodyData, ServerAddr );
+            }
+        }
+        else
+        {
+            const int64_t iNowNs = Now();
+
+            // the server sends the mixes with the period of our own packets,
+            // the deviation from that period is the inter-arrival jitter
+            if ( iLastArrivalNs > 0 )
+            {
+                const float fDeviationMs = std::abs ( static_cast<float> ( iNowNs - iLastArrivalNs - iPacketPeriodNs ) ) / 1000000;
+                const float fOldJitterMs = fJitterMs.load ( std::memory_order_relaxed );
+
+                fJitterMs.store ( fOldJitterMs + ( fDeviationMs - fOldJitterMs ) * LOADGEN_JITTER_SMOOTH_FACTOR, std::memory_order_relaxed );
+
+                // the maximum is reset by the reader, therefore it is updated
+                // with a compare and swap
+                float fOldMaxJitterMs = fMaxJitterMs.load ( std::memory_order_relaxed );
+
+                while ( ( fDeviationMs > fOldMaxJitterMs ) && !fMaxJitterMs.compare_exchange_weak ( fOldMaxJitterMs, fDeviationMs ) )
+                {
+                }
+            }
+
+            iLastArrivalNs = iNowNs;
+            iNumPacketsReceived.fetch_add ( 1, std::memory_order_relaxed );
+
+            if ( Channel.PutAudioData ( vecbyRecBuf, iNumBytesRead, ServerAddr ) == PS_NEW_CONNECTION )
+            {
+                emit NewConnection();
+            }
+        }
+    }
+}
+
+void CLoadGenClient::Process ( const int64_t iNowNs, std::mt19937& RandomGen )
+{
+    if ( !bIsActive.load ( std::memory_order_acquire ) )
+    {
+        return;
+    }
+
+    std::uniform_real_distribution<double> Uniform ( 0, 1 );
+
+    if ( iNowNs - iNextPacketNs > LOADGEN_MAX_CATCH_UP_NUM_PACKETS * iPacketPeriodNs )
+    {
+        iNextPacketNs = iNowNs;
+    }
+
+    // emulate the sound card callbacks which are due
+    while ( iNowNs >= iNextPacketNs )
+    {
+        for ( int i = 0; i < iNetwFrameSizeFact; i++ )
+        {
+            // a packet which does not fit in the queue is lost
+            const bool     bQueueIsFull = ( iSendQueueWritePos - iSendQueueReadPos ) >= LOADGEN_SEND_QUEUE_SIZE;
+            SQueuedPacket& Packet       = bQueueIsFull ? LostPacket : vecSendQueue[iSendQueueWritePos % LOADGEN_SEND_QUEUE_SIZE];
+
+            // the conversion buffer of the channel puts the frames together and
+            // adds the sequence number (also for lost packets)
+            if ( Channel.PrepPacket ( vecvecbyCodedFrames[iFrameIdx], iCeltNumCodedBytes, Packet.vecbyData ) )
+            {
+                if ( bQueueIsFull || ( Uniform ( RandomGen ) < dLossProbability ) )
+                {
+                    iNumPacketsLost.fetch_add ( 1, std::memory_order_relaxed );
+                }
+                else
+                {
+                    // the packet order is kept, i.e. a delayed packet delays the
+                    // following packets, too
+                    Packet.iDueNs = std::max ( iLastDueNs, iNextPacketNs + static_cast<int64_t> ( Uniform ( RandomGen ) * iJitterNs ) );
+                    iLastDueNs    = Packet.iDueNs;
+
+                    iSendQueueWritePos++;
+                }
+            }
+
+            iFrameIdx = ( iFrameIdx + 1 ) % vecvecbyCodedFrames.Size();
+        }
+
+        // the received mixes are played out with the same period, before the
+        // first frame was played out the jitter buffer is still filling up
+        for ( int i = 0; i < iNetwFrameSizeFact; i++ )
+        {
+            switch ( Channel.GetData ( vecbyNetwData, iCeltNumCodedBytes ) )
+            {
+            case GS_BUFFER_OK:
+            case GS_BUFFER_OK_DECODED:
+                bPlayoutStarted = true;
+                iNumFramesOnTime.fetch_add ( 1, std::memory_order_relaxed );
+                break;
+
+            case GS_BUFFER_UNDERRUN:
+                if ( bPlayoutStarted )
+                {
+                    iNumFramesLate.fetch_add ( 1, std::memory_order_relaxed );
+                }
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        iNextPacketNs += iPacketPeriodNs;
+    }
+
+    // send the packets which are due
+    while ( ( iSendQueueReadPos != iSendQueueWritePos ) && ( vecSendQueue[iSendQueueReadPos % LOADGEN_SEND_QUEUE_SIZE].iDueNs <= iNowNs ) )
+    {
+        SendPacket ( vecSendQueue[iSendQueueReadPos % LOADGEN_SEND_QUEUE_SIZE].vecbyData );
+
+        iSendQueueReadPos++;
+        iNumPacketsSent.fetch_add ( 1, std::memory_order_relaxed );
+    }
+}
+
+void CLoadGenClient::GetStats ( CLoadGenClientStats& Stats )
+{
+    Stats.iNumConnected       = bIsConnected ? 1 : 0;
+    Stats.iNumPacketsSent     = iNumPacketsSent.load ( std::memory_order_relaxed );
+    Stats.iNumPacketsLost     = iNumPacketsLost.load ( std::memory_order_relaxed );
+    Stats.iNumPacketsReceived = iNumPacketsReceived.load ( std::memory_order_relaxed );
+    Stats.iNumFramesOnTime    = iNumFramesOnTime.load ( std::memory_order_relaxed );
+    Stats.iNumFramesLate      = iNumFramesLate.load ( std::memory_order_relaxed );
+    Stats.fJitterMs           = fJitterMs.load ( std::memory_order_relaxed );
+    Stats.fMaxJitterMs        = fMaxJitterMs.exchange ( 0, std::memory_order_relaxed );
+}
+
+/******************************************************************************\
+* Load generator                                                               *
+\******************************************************************************/
+CLoadGenerator::CLoadGenerator ( const CLoadGenSettings& NSettings ) :
+    Settings ( NSettings ),
+    iCeltNumCodedBytes ( COpusCoding::GetNumCodedBytes ( Settings.eAudComprType, Settings.iNumAudioChannels, Settings.eAudioQuality ) ),
+    iNumStartedClients ( 0 ),
+    bRun ( false ),
+    iStartNs ( 0 ),
+    iLastReportNs ( 0 )
+{
+    EncodeFrames();
+
+    for ( int i = 0; i < Settings.iNumClients; i++ )
+    {
+        vecpClients.emplace_back ( new CLoadGenClient ( i, Settings, iCeltNumCodedBytes, vecvecbyCodedFrames ) );
+    }
+
+    // the clients are started evenly distributed over the ramp-up time
+    TimerRampUp.setTimerType ( Qt::PreciseTimer );
+    TimerRampUp.setInterval ( Settings.iRampUpMs / std::max ( Settings.iNumClients, 1 ) );
+
+    TimerReport.setInterval ( Settings.iReportIntervalS * 1000 );
+
+    QObject::connect ( &TimerRampUp, &QTimer::timeout, this, &CLoadGenerator::OnTimerRampUp );
+
+    QObject::connect ( &TimerReport, &QTimer::timeout, this, &CLoadGenerator::OnTimerReport );
+
+    QObject::connect ( CSignalHandler::getSingletonP(), &CSignalHandler::HandledSignal, this, &CLoadGenerator::OnHandledSignal );
+}
+
+CLoadGenerator::~CLoadGenerator() { StopThreads(); }
+
+void CLoadGenerator::EncodeFrames()
+{
+    // the frames are encoded once and shared by all virtual clients so that the
+    // load generator itself needs as little CPU as possible
+    const int iOpusFrameSizeSamples = COpusCoding::GetFrameSizeSamples ( Settings.eAudComprType );
+    const int iNumAudioChannels     = Settings.iNumAudioChannels;
+    int       iOpusError;
+
+    OpusCustomMode*    OpusMode    = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, iOpusFrameSizeSamples, &iOpusError );
+    OpusCustomEncoder* OpusEncoder = opus_custom_encoder_create ( OpusMode, iNumAudioChannels, &iOpusError );
+
+    COpusCoding::InitEncoder ( OpusEncoder, Settings.eAudComprType );
+    COpusCoding::SetEncoderBitRate ( OpusEncoder, Settings.eAudComprType, iCeltNumCodedBytes );
+
+    CVector<int16_t> vecsAudio ( LOADGEN_NUM_PREENCODED_FRAMES * iOpusFrameSizeSamples * iNumAudioChannels );
+
+    COpusCoding::GetTestSignal ( vecsAudio, iNumAudioChannels );
+
+    vecvecbyCodedFrames.Init ( LOADGEN_NUM_PREENCODED_FRAMES );
+
+    for ( int iFrame = 0; iFrame < LOADGEN_NUM_PREENCODED_FRAMES; iFrame++ )
+    {
+        vecvecbyCodedFrames[iFrame].Init ( iCeltNumCodedBytes );
+
+        opus_custom_encode ( OpusEncoder,
+                             &vecsAudio[iFrame * iOpusFrameSizeSamples * iNumAudioChannels],
+                             iOpusFrameSizeSamples,
+                             &vecvecbyCodedFrames[iFrame][0],
+                             iCeltNumCodedBytes );
+    }
+
+    opus_custom_encoder_destroy ( OpusEncoder );
+    opus_custom_mode_destroy ( OpusMode );
+}
+
+bool CLoadGenerator::Start()
+{
+    for ( size_t i = 0; i < vecpClients.size(); i++ )
+    {
+        if ( !vecpClients[i]->Open() )
+        {
+            qCritical() << qUtf8Printable ( QString ( "- cannot open the socket of virtual client %1: %2" ).arg ( i ).arg ( strerror ( errno ) ) );
+            return false;
+        }
+    }
+
+    iStartNs      = CLoadGenClient::Now();
+    iLastReportNs = iStartNs;
+
+    bRun          = true;
+    SendThread    = std::thread ( &CLoadGenerator::RunSendThread, this );
+    ReceiveThread = std::thread ( &CLoadGenerator::RunReceiveThread, this );
+
+    if ( TimerRampUp.interval() > 0 )
+    {
+        OnTimerRampUp();
+        TimerRampUp.start();
+    }
+    else
+    {
+        while ( iNumStartedClients < Settings.iNumClients )
+        {
+            OnTimerRampUp();
+        }
+    }
+
+    if ( Settings.iReportIntervalS > 0 )
+    {
+        TimerReport.start();
+    }
+
+    if ( Settings.iDurationS > 0 )
+    {
+        QTimer::singleShot ( Settings.iDurationS * 1000, this, &CLoadGenerator::OnStop );
+    }
+
+    return true;
+}
+
+void CLoadGenerator::StopThreads()
+{
+    if ( bRun )
+    {
+        bRun = false;
+        SendThread.join();
+        ReceiveThread.join();
+    }
+}
+
+void CLoadGenerator::RunSendThread()
+{
+    std::random_device RandomDevice;
+    std::mt19937       RandomGen ( RandomDevice() );
+
+    std::chrono::steady_clock::time_point NextStep = std::chrono::steady_clock::now();
+
+    while ( bRun )
+    {
+        const int64_t iNowNs = CLoadGenClient::Now();
+
+        for ( size_t i = 0; i < vecpClients.size(); i++ )
+        {
+            vecpClients[i]->Process ( iNowNs, RandomGen );
+        }
+
+        // absolute wake up times avoid a drift, if a step is late the clients
+        // catch up with the missed packets in the next step
+        NextStep += std::chrono::nanoseconds ( LOADGEN_SEND_STEP_NS );
+        NextStep = std::max ( NextStep, std::chrono::steady_clock::now() );
+
+        std::this_thread::sleep_until ( NextStep );
+    }
+}
+
+void CLoadGenerator::RunReceiveThread()
+{
+    std::vector<struct pollfd> vecPollFds ( vecpClients.size() );
+    CVector<uint8_t>           vecbyRecBuf ( MAX_SIZE_BYTES_NETW_BUF );
+    CVector<uint8_t>           vecbyMesBodyData ( MAX_SIZE_BYTES_NETW_BUF );
+
+    for ( size_t i = 0; i < vecpClients.size(); i++ )
+    {
+        vecPollFds[i].fd     = vecpClients[i]->GetSocket();
+        vecPollFds[i].events = POLLIN;
+    }
+
+    while ( bRun )
+    {
+        if ( poll ( &vecPollFds[0], vecPollFds.size(), LOADGEN_RECV_POLL_TIMEOUT_MS ) <= 0 )
+        {
+            continue;
+        }
+
+        for ( size_t i = 0; i < vecPollFds.size(); i++ )
+        {
+            if ( vecPollFds[i].revents != 0 )
+            {
+                vecpClients[i]->ReceivePackets ( vecbyRecBuf, vecbyMesBodyData );
+            }
+        }
+    }
+}
+
+void CLoadGenerator::OnTimerRampUp()
+{
+    if ( iNumStartedClients < Settings.iNumClients )
+    {
+        vecpClients[iNumStartedClients]->Start();
+        iNumStartedClients++;
+    }
+
+    if ( iNumStartedClients == Settings.iNumClients )
+    {
+        TimerRampUp.stop();
+    }
+}
+
+void CLoadGenerator::OnTimerReport()
+{
+    CLoadGenClientStats Stats;
+
+    for ( size_t i = 0; i < vecpClients.size(); i++ )
+    {
+        CLoadGenClientStats ClientStats;
+
+        vecpClients[i]->GetStats ( ClientStats );
+        Stats.Add ( ClientStats );
+    }
+
+    const int64_t iNowNs = CLoadGenClient::Now();
+
+    Report ( Stats, LastStats, static_cast<double> ( iNowNs - iLastReportNs ) / 1000000000 );
+
+    LastStats     = Stats;
+    iLastReportNs = iNowNs;
+}
+
+void CLoadGenerator::Report ( const CLoadGenClientStats& Stats, const CLoadGenClientStats& PrevStats, const double dIntervalS )
+{
+    const int64_t iNumSent     = Stats.iNumPacketsSent - PrevStats.iNumPacketsSent;
+    const int64_t iNumLost     = Stats.iNumPacketsLost - PrevStats.iNumPacketsLost;
+    const int64_t iNumReceived = Stats.iNumPacketsReceived - PrevStats.iNumPacketsReceived;
+    const int64_t iNumOnTime   = Stats.iNumFramesOnTime - PrevStats.iNumFramesOnTime;
+    const int64_t iNumLate     = Stats.iNumFramesLate - PrevStats.iNumFramesLate;
+
+    qInfo() << qUtf8Printable ( QString ( "- %1 s: %2/%3 clients connected, sent %4 pkt/s (%5 % lost), received %6 pkt/s, "
+                                          "jitter %7 ms (max %8 ms), late frames %9 %" )
+                                    .arg ( static_cast<double> ( CLoadGenClient::Now() - iStartNs ) / 1000000000, 0, 'f', 1 )
+                                    .arg ( Stats.iNumConnected )
+                                    .arg ( iNumStartedClients )
+                                    .arg ( dIntervalS > 0 ? iNumSent / dIntervalS : 0, 0, 'f', 0 )
+                                    .arg ( iNumSent + iNumLost > 0 ? 100.0 * iNumLost / ( iNumSent + iNumLost ) : 0, 0, 'f', 2 )
+                                    .arg ( dIntervalS > 0 ? iNumReceived / dIntervalS : 0, 0, 'f', 0 )
+                                    .arg ( iNumStartedClients > 0 ? Stats.fJitterMs / iNumStartedClients : 0, 0, 'f', 3 )
+                                    .arg ( Stats.fMaxJitterMs, 0, 'f', 3 )
+                                    .arg ( iNumOnTime + iNumLate > 0 ? 100.0 * iNumLate / ( iNumOnTime + iNumLate ) : 0, 0, 'f', 3 ) );
+}
+
+void CLoadGenerator::OnStop()
+{
+    if ( !bRun )
+    {
+        return;
+    }
+
+    TimerRampUp.stop();
+    TimerReport.stop();
+
+    // the report of the complete run
+    CLoadGenClientStats Stats;
+    int64_t             iSumHandshakeNs = 0;
+    int64_t             iMaxHandshakeNs = 0;
+    int                 iNumHandshakes  = 0;
+
+    for ( size_t i = 0; i < vecpClients.size(); i++ )
+    {
+        CLoadGenClientStats ClientStats;
+
+        vecpClients[i]->GetStats ( ClientStats );
+        Stats.Add ( ClientStats );
+
+        if ( vecpClients[i]->GetHandshakeNs() >= 0 )
+        {
+            iSumHandshakeNs += vecpClients[i]->GetHandshakeNs();
+            iMaxHandshakeNs = std::max ( iMaxHandshakeNs, vecpClients[i]->GetHandshakeNs() );
+            iNumHandshakes++;
+        }
+    }
+
+    qInfo() << "- summary of the complete run:";
+    Report ( Stats, CLoadGenClientStats(), static_cast<double> ( CLoadGenClient::Now() - iStartNs ) / 1000000000 );
+
+    qInfo() << qUtf8Printable ( QString ( "- handshake completed by %1 clients, mean %2 ms, max %3 ms" )
+                                    .arg ( iNumHandshakes )
+                                    .arg ( iNumHandshakes > 0 ? iSumHandshakeNs / iNumHandshakes / 1000000.0 : 0, 0, 'f', 1 )
+                                    .arg ( iMaxHandshakeNs / 1000000.0, 0, 'f', 1 ) );
+
+    // the clients disconnect from the main thread, therefore the send thread
+    // must be stopped first
+    StopThreads();
+
+    for ( size_t i = 0; i < vecpClients.size(); i++ )
+    {
+        vecpClients[i]->Stop();
+    }
+
+    QCoreApplication::instance()->exit();
+}
+
+void CLoadGenerator::OnHandledSignal ( int sigNum )
+{
+    switch ( sigNum )
+    {
+    case SIGINT:
+    case SIGTERM:
+        OnStop();
+        break;
+
+    default:
+        break;
+    }
+}
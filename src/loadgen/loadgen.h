@@ -0,0 +1,282 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../global.h"
+#include "../channel.h"
+#include "../protocol.h"
+#include "../socket.h"
+#include "../util.h"
+
+/* Definitions ****************************************************************/
+// number of audio frames which are encoded at startup and sent in a loop
+#define LOADGEN_NUM_PREENCODED_FRAMES 1000
+
+// period of the send thread which emulates the sound card callbacks of all
+// virtual clients
+#define LOADGEN_SEND_STEP_NS 250000
+
+// number of packets which can be held back by the jitter emulation (must be a
+// power of two)
+#define LOADGEN_SEND_QUEUE_SIZE 64
+
+// maximum emulated network jitter
+#define LOADGEN_MAX_JITTER_MS 50
+
+// if the send thread was stalled for longer than this number of packets, the
+// missed packets are skipped instead of being sent in a burst
+#define LOADGEN_MAX_CATCH_UP_NUM_PACKETS 100
+
+// time-out of the receive thread poll so that it can be stopped
+#define LOADGEN_RECV_POLL_TIMEOUT_MS 100
+
+// smoothing of the inter-arrival jitter (RFC 3550)
+#define LOADGEN_JITTER_SMOOTH_FACTOR ( 1.0f / 16 )
+
+/* Classes ********************************************************************/
+class CLoadGenSettings
+{
+public:
+    CLoadGenSettings() :
+        iNumClients ( 10 ),
+        eAudComprType ( CT_OPUS64 ),
+        iNumAudioChannels ( 2 ),
+        eAudioQuality ( AQ_NORMAL ),
+        iNetwFrameSizeFact ( FRAME_SIZE_FACTOR_DEFAULT ),
+        iJitterMs ( 0 ),
+        dLossPercent ( 0 ),
+        iRampUpMs ( 0 ),
+        iDurationS ( 0 ),
+        iReportIntervalS ( 5 ),
+        iSockBufNumFrames ( DEF_NET_BUF_SIZE_NUM_BL )
+    {}
+
+    CHostAddress  ServerAddr;
+    int           iNumClients;
+    EAudComprType eAudComprType;
+    int           iNumAudioChannels;
+    EAudioQuality eAudioQuality;
+    int           iNetwFrameSizeFact; // number of coded frames per network packet
+    int           iJitterMs;          // the send time of each packet is delayed by up to this value
+    double        dLossPercent;       // percentage of packets which are not sent
+    int           iRampUpMs;          // the clients are started evenly distributed over this time
+    int           iDurationS;         // zero means no limit
+    int           iReportIntervalS;   // interval of the statistics output on the console
+    int           iSockBufNumFrames;  // jitter buffer size of the virtual clients
+};
+
+class CLoadGenClientStats
+{
+public:
+    CLoadGenClientStats() :
+        iNumConnected ( 0 ),
+        iNumPacketsSent ( 0 ),
+        iNumPacketsLost ( 0 ),
+        iNumPacketsReceived ( 0 ),
+        iNumFramesOnTime ( 0 ),
+        iNumFramesLate ( 0 ),
+        fJitterMs ( 0 ),
+        fMaxJitterMs ( 0 )
+    {}
+
+    void Add ( const CLoadGenClientStats& Stats );
+
+    int     iNumConnected;
+    int64_t iNumPacketsSent;
+    int64_t iNumPacketsLost; // dropped by the loss emulation
+    int64_t iNumPacketsReceived;
+    int64_t iNumFramesOnTime; // frames which were in the jitter buffer when they were played out
+    int64_t iNumFramesLate;   // jitter buffer underruns
+    float   fJitterMs;        // smoothed deviation of the inter-arrival times from the packet period
+    float   fMaxJitterMs;     // maximum deviation since the last query
+};
+
+/* Virtual client ----------------------------------------------------------- */
+// Each virtual client uses a client channel and its own UDP socket, just like
+// a real client. The network threads are owned by the load generator, the
+// protocol is handled in the main thread.
+class CLoadGenClient : public QObject
+{
+    Q_OBJECT
+
+public:
+    CLoadGenClient ( const int                        iNClientID,
+                     const CLoadGenSettings&          Settings,
+                     const int                        iNCeltNumCodedBytes,
+                     const CVector<CVector<uint8_t>>& vecvecbyNCodedFrames );
+
+    virtual ~CLoadGenClient();
+
+    bool Open();
+    void Start();
+    void Stop();
+
+    SOCKET GetSocket() const { return UdpSocket; }
+
+    // called by the receive thread
+    void ReceivePackets ( CVector<uint8_t>& vecbyRecBuf, CVector<uint8_t>& vecbyMesBodyData );
+
+    // called by the send thread
+    void Process ( const int64_t iNowNs, std::mt19937& RandomGen );
+
+    void GetStats ( CLoadGenClientStats& Stats );
+
+    int64_t GetHandshakeNs() const { return iHandshakeNs; }
+
+    static int64_t Now();
+
+protected:
+    struct SQueuedPacket
+    {
+        int64_t          iDueNs;
+        CVector<uint8_t> vecbyData;
+    };
+
+    void SendPacket ( const CVector<uint8_t>& vecbyData );
+
+    const int                        iClientID;
+    const CHostAddress               ServerAddr;
+    const int                        iCeltNumCodedBytes;
+    const int                        iNetwFrameSizeFact;
+    const int64_t                    iPacketPeriodNs;
+    const int64_t                    iJitterNs;
+    const double                     dLossProbability;
+    const CVector<CVector<uint8_t>>& vecvecbyCodedFrames;
+
+    SOCKET UdpSocket;
+
+    CChannel         Channel;
+    CProtocol        ConnLessProtocol;
+    CChannelCoreInfo ChannelInfo;
+
+    // main thread
+    int64_t iStartNs;
+    int64_t iHandshakeNs;
+    bool    bIsConnected;
+
+    // send thread
+    std::atomic<bool>    bIsActive;
+    int64_t              iNextPacketNs;
+    int64_t              iLastDueNs;
+    int                  iFrameIdx;
+    bool                 bPlayoutStarted;
+    SQueuedPacket        vecSendQueue[LOADGEN_SEND_QUEUE_SIZE];
+    SQueuedPacket        LostPacket;
+    uint32_t             iSendQueueReadPos;
+    uint32_t             iSendQueueWritePos;
+    CVector<uint8_t>     vecbyNetwData;
+    std::atomic<int64_t> iNumPacketsSent;
+    std::atomic<int64_t> iNumPacketsLost;
+    std::atomic<int64_t> iNumFramesOnTime;
+    std::atomic<int64_t> iNumFramesLate;
+
+    // receive thread
+    int64_t              iLastArrivalNs;
+    std::atomic<int64_t> iNumPacketsReceived;
+    std::atomic<float>   fJitterMs;
+    std::atomic<float>   fMaxJitterMs;
+
+public slots:
+    void OnSendProtMessage ( CVector<uint8_t> vecMessage ) { SendPacket ( vecMessage ); }
+    void OnSendCLProtMessage ( CHostAddress, CVector<uint8_t> vecMessage ) { SendPacket ( vecMessage ); }
+    void OnReqJittBufSize() { Channel.CreateJitBufMes ( AUTO_NET_BUF_SIZE_FOR_PROTOCOL ); }
+    void OnReqChanInfo() { Channel.SetRemoteInfo ( ChannelInfo ); }
+    void OnNewConnection();
+    void OnDisconnected() { bIsConnected = false; }
+
+signals:
+    void ProtocolMessageReceived ( int iRecCounter, int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& HostAdr );
+    void NewConnection();
+};
+
+/* Load generator ----------------------------------------------------------- */
+class CLoadGenerator : public QObject
+{
+    Q_OBJECT
+
+public:
+    CLoadGenerator ( const CLoadGenSettings& NSettings );
+    virtual ~CLoadGenerator();
+
+    bool Start();
+
+protected:
+    void EncodeFrames();
+    void RunSendThread();
+    void RunReceiveThread();
+    void StopThreads();
+    void Report ( const CLoadGenClientStats& Stats, const CLoadGenClientStats& PrevStats, const double dIntervalS );
+
+    CLoadGenSettings                             Settings;
+    int                                          iCeltNumCodedBytes;
+    CVector<CVector<uint8_t>>                    vecvecbyCodedFrames;
+    std::vector<std::unique_ptr<CLoadGenClient>> vecpClients;
+    int                                          iNumStartedClients;
+
+    std::atomic<bool> bRun;
+    std::thread       SendThread;
+    std::thread       ReceiveThread;
+
+    QTimer              TimerRampUp;
+    QTimer              TimerReport;
+    int64_t             iStartNs;
+    int64_t             iLastReportNs;
+    CLoadGenClientStats LastStats;
+
+public slots:
+    void OnTimerRampUp();
+    void OnTimerReport();
+    void OnStop();
+    void OnHandledSignal ( int sigNum );
+};
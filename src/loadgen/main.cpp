@@ -0,0 +1,200 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include "loadgen.h"
+
+/* Implementation *************************************************************/
+// parses an integer option and checks its range
+static bool GetIntOption ( const QCommandLineParser& Parser, const QCommandLineOption& Option, const int iMin, const int iMax, int& iValue )
+{
+    bool bOk = false;
+
+    iValue = Parser.value ( Option ).toInt ( &bOk );
+
+    if ( !bOk || ( iValue < iMin ) || ( iValue > iMax ) )
+    {
+        qCritical() << qUtf8Printable (
+            QString ( "- invalid value for --%1, allowed range is %2 to %3" ).arg ( Option.names().last() ).arg ( iMin ).arg ( iMax ) );
+        return false;
+    }
+
+    return true;
+}
+
+int main ( int argc, char** argv )
+{
+    QCoreApplication Application ( argc, argv );
+    QCoreApplication::setApplicationName ( "jamulus-loadgen" );
+    QCoreApplication::setApplicationVersion ( VERSION );
+
+    QCommandLineParser Parser;
+    Parser.setApplicationDescription ( "Emulates a number of Jamulus clients to measure the capacity of a server." );
+    Parser.addHelpOption();
+    Parser.addVersionOption();
+
+    const QCommandLineOption ServerOption ( QStringList() << "s" << "server",
+                                            "Server address (default: localhost).",
+                                            "address",
+                                            QString ( "127.0.0.1:%1" ).arg ( DEFAULT_PORT_NUMBER ) );
+    const QCommandLineOption ClientsOption ( QStringList() << "n" << "clients", "Number of virtual clients (default: 10).", "number", "10" );
+    const QCommandLineOption CodecOption ( "codec", "Audio codec: opus (128 samples frames) or opus64 (default).", "codec", "opus64" );
+    const QCommandLineOption MonoOption ( "mono", "Send mono instead of stereo audio." );
+    const QCommandLineOption QualityOption ( "quality", "Audio quality: low, normal (default) or high.", "quality", "normal" );
+    const QCommandLineOption FrameFactOption ( "framefactor", "Number of codec frames per packet: 1, 2 (default) or 4.", "factor", "2" );
+    const QCommandLineOption JitterOption ( "jitter", "Maximum network jitter which is emulated (default: 0).", "ms", "0" );
+    const QCommandLineOption LossOption ( "loss", "Packet loss which is emulated (default: 0).", "percent", "0" );
+    const QCommandLineOption RampUpOption ( "rampup", "Time over which the clients are started (default: 0).", "ms", "0" );
+    const QCommandLineOption DurationOption ( "duration", "Duration of the test, 0 runs until interrupted (default).", "seconds", "0" );
+    const QCommandLineOption ReportOption ( "report", "Interval of the statistics output, 0 disables it (default: 5).", "seconds", "5" );
+    const QCommandLineOption JitBufOption ( "jitterbuffer",
+                                            QString ( "Jitter buffer size of the clients (default: %1)." ).arg ( DEF_NET_BUF_SIZE_NUM_BL ),
+                                            "frames",
+                                            QString::number ( DEF_NET_BUF_SIZE_NUM_BL ) );
+
+    Parser.addOptions ( { ServerOption,
+                          ClientsOption,
+                          CodecOption,
+                          MonoOption,
+                          QualityOption,
+                          FrameFactOption,
+                          JitterOption,
+                          LossOption,
+                          RampUpOption,
+                          DurationOption,
+                          ReportOption,
+                          JitBufOption } );
+
+    Parser.process ( Application );
+
+    CLoadGenSettings Settings;
+
+    if ( !NetworkUtil::ParseNetworkAddress ( Parser.value ( ServerOption ), Settings.ServerAddr, true ) )
+    {
+        qCritical() << qUtf8Printable ( QString ( "- invalid server address: %1" ).arg ( Parser.value ( ServerOption ) ) );
+        return 1;
+    }
+
+    if ( !GetIntOption ( Parser, ClientsOption, 1, 10000, Settings.iNumClients ) ||
+         !GetIntOption ( Parser, FrameFactOption, FRAME_SIZE_FACTOR_PREFERRED, FRAME_SIZE_FACTOR_SAFE, Settings.iNetwFrameSizeFact ) ||
+         !GetIntOption ( Parser, JitterOption, 0, LOADGEN_MAX_JITTER_MS, Settings.iJitterMs ) ||
+         !GetIntOption ( Parser, RampUpOption, 0, 3600000, Settings.iRampUpMs ) ||
+         !GetIntOption ( Parser, DurationOption, 0, 1000000, Settings.iDurationS ) ||
+         !GetIntOption ( Parser, ReportOption, 0, 3600, Settings.iReportIntervalS ) ||
+         !GetIntOption ( Parser, JitBufOption, MIN_NET_BUF_SIZE_NUM_BL, MAX_NET_BUF_SIZE_NUM_BL, Settings.iSockBufNumFrames ) )
+    {
+        return 1;
+    }
+
+    if ( Settings.iNetwFrameSizeFact == 3 )
+    {
+        qCritical() << "- invalid value for --framefactor, allowed values are 1, 2 and 4";
+        return 1;
+    }
+
+    bool bLossOk          = false;
+    Settings.dLossPercent = Parser.value ( LossOption ).toDouble ( &bLossOk );
+
+    if ( !bLossOk || ( Settings.dLossPercent < 0 ) || ( Settings.dLossPercent > 100 ) )
+    {
+        qCritical() << "- invalid value for --loss, allowed range is 0 to 100";
+        return 1;
+    }
+
+    if ( Parser.value ( CodecOption ) == "opus" )
+    {
+        Settings.eAudComprType = CT_OPUS;
+    }
+    else if ( Parser.value ( CodecOption ) == "opus64" )
+    {
+        Settings.eAudComprType = CT_OPUS64;
+    }
+    else
+    {
+        qCritical() << "- invalid value for --codec, allowed values are opus and opus64";
+        return 1;
+    }
+
+    if ( Parser.value ( QualityOption ) == "low" )
+    {
+        Settings.eAudioQuality = AQ_LOW;
+    }
+    else if ( Parser.value ( QualityOption ) == "normal" )
+    {
+        Settings.eAudioQuality = AQ_NORMAL;
+    }
+    else if ( Parser.value ( QualityOption ) == "high" )
+    {
+        Settings.eAudioQuality = AQ_HIGH;
+    }
+    else
+    {
+        qCritical() << "- invalid value for --quality, allowed values are low, normal and high";
+        return 1;
+    }
+
+    Settings.iNumAudioChannels = Parser.isSet ( MonoOption ) ? 1 : 2;
+
+    qInfo() << qUtf8Printable ( QString ( "- %1 virtual clients, server %2, %3 %4 %5 quality, %6 frame(s) per packet, jitter %7 ms, loss %8 %" )
+                                    .arg ( Settings.iNumClients )
+                                    .arg ( Settings.ServerAddr.toString() )
+                                    .arg ( Parser.value ( CodecOption ) )
+                                    .arg ( Settings.iNumAudioChannels == 1 ? "mono" : "stereo" )
+                                    .arg ( Parser.value ( QualityOption ) )
+                                    .arg ( Settings.iNetwFrameSizeFact )
+                                    .arg ( Settings.iJitterMs )
+                                    .arg ( Settings.dLossPercent ) );
+
+    CLoadGenerator LoadGenerator ( Settings );
+
+    if ( !LoadGenerator.Start() )
+    {
+        return 1;
+    }
+
+    return Application.exec();
+}
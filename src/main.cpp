@@ -57,6 +57,8 @@
 #    endif
 #endif
 #include "settings.h"
+#include "serverbenchmark.h"
+#include "serverreplay.h"
 #ifndef SERVER_ONLY
 #    include "testbench.h"
 #endif
@@ -117,11 +119,25 @@ int main ( int argc, char** argv )
     bool         bMuteMeInPersonalMix        = false;
     bool         bDisableRecording           = false;
     bool         bDelayPan                   = false;
+    bool         bUseMixMinus                = false;
+    bool         bUseEncodeOnce              = false;
+    bool         bPinCores                   = false;
+    bool         bUsePipeline                = false;
+    bool         bDecodeOnArrival            = false;
     bool         bNoAutoJackConnect          = false;
     bool         bUseTranslation             = true;
     bool         bCustomPortNumberGiven      = false;
     bool         bDisableIPv6                = false;
     int          iNumServerChannels          = DEFAULT_USED_NUM_CHANNELS;
+    int          iNumRecvSockets             = 1;
+    bool         bUseRtThread                = false;
+    bool         bUseOverloadControl         = false;
+    int          iAdmissionTargetPercent     = 0; // no admission control
+    int          iBenchmarkNumClients        = 0; // no benchmark
+    int          iBenchmarkNumFrames         = BENCHMARK_DEFAULT_NUM_FRAMES;
+    QString      strBenchmarkMix             = BENCHMARK_DEFAULT_MIX;
+    QString      strCaptureFileName          = "";
+    QString      strReplayFileName           = "";
     quint16      iPortNumber                 = DEFAULT_PORT_NUMBER;
     int          iJsonRpcPortNumber          = INVALID_PORT;
     QString      strJsonRpcBindIP            = DEFAULT_JSON_RPC_LISTEN_ADDRESS;
@@ -483,6 +499,164 @@ int main ( int argc, char** argv )
             continue;
         }
 
+        // Use mix-minus bus ---------------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--mixminus", // no short form
+                               "--mixminus" ) )
+        {
+            bUseMixMinus = true;
+            qInfo() << "- using mix-minus bus";
+            CommandLineOptions << "--mixminus";
+            ServerOnlyOptions << "--mixminus";
+            continue;
+        }
+
+        // Encode identical mixes only once ------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--encodeonce", // no short form
+                               "--encodeonce" ) )
+        {
+            bUseEncodeOnce = true;
+            qInfo() << "- encode identical mixes only once";
+            CommandLineOptions << "--encodeonce";
+            ServerOnlyOptions << "--encodeonce";
+            continue;
+        }
+
+        // Pin multithreading workers to CPU cores -----------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--pincores", // no short form
+                               "--pincores" ) )
+        {
+            bPinCores = true;
+            qInfo() << "- pin multithreading workers to CPU cores";
+            CommandLineOptions << "--pincores";
+            ServerOnlyOptions << "--pincores";
+            continue;
+        }
+
+        // Pipelined decoding and mixing ---------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--pipeline", // no short form
+                               "--pipeline" ) )
+        {
+            bUsePipeline = true;
+            qInfo() << "- pipelined decoding and mixing (adds one frame of latency)";
+            CommandLineOptions << "--pipeline";
+            ServerOnlyOptions << "--pipeline";
+            continue;
+        }
+
+        // Decode audio packets on arrival -------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--decodeonarrival", // no short form
+                               "--decodeonarrival" ) )
+        {
+            bDecodeOnArrival = true;
+            qInfo() << "- decode audio packets on arrival";
+            CommandLineOptions << "--decodeonarrival";
+            ServerOnlyOptions << "--decodeonarrival";
+            continue;
+        }
+
+        // Number of receive sockets -------------------------------------------
+        if ( GetNumericArgument ( argc, argv, i, "--recvsockets", "--recvsockets", 1, MAX_NUM_RECV_SOCKETS, rDbleArgument ) )
+        {
+            iNumRecvSockets = static_cast<int> ( rDbleArgument );
+            qInfo() << qUtf8Printable ( QString ( "- number of receive sockets: %1" ).arg ( iNumRecvSockets ) );
+            CommandLineOptions << "--recvsockets";
+            ServerOnlyOptions << "--recvsockets";
+            continue;
+        }
+
+        // Real-time thread ----------------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--rtthread", // no short form
+                               "--rtthread" ) )
+        {
+            bUseRtThread = true;
+            qInfo() << "- run the audio processing in the real-time timer thread";
+            CommandLineOptions << "--rtthread";
+            ServerOnlyOptions << "--rtthread";
+            continue;
+        }
+
+        // Overload control ----------------------------------------------------
+        if ( GetFlagArgument ( argv,
+                               i,
+                               "--overloadcontrol", // no short form
+                               "--overloadcontrol" ) )
+        {
+            bUseOverloadControl = true;
+            qInfo() << "- reduce the audio quality on overload";
+            CommandLineOptions << "--overloadcontrol";
+            ServerOnlyOptions << "--overloadcontrol";
+            continue;
+        }
+
+        // Admission control ---------------------------------------------------
+        if ( GetNumericArgument ( argc, argv, i, "--admission", "--admission", 1, 100, rDbleArgument ) )
+        {
+            iAdmissionTargetPercent = static_cast<int> ( rDbleArgument );
+            qInfo() << qUtf8Printable ( QString ( "- admission control with a tick utilisation target of %1 %" ).arg ( iAdmissionTargetPercent ) );
+            CommandLineOptions << "--admission";
+            ServerOnlyOptions << "--admission";
+            continue;
+        }
+
+        // Offline benchmark ---------------------------------------------------
+        if ( GetNumericArgument ( argc, argv, i, "--benchmark", "--benchmark", 1, MAX_NUM_CHANNELS, rDbleArgument ) )
+        {
+            iBenchmarkNumClients = static_cast<int> ( rDbleArgument );
+            qInfo() << qUtf8Printable ( QString ( "- offline benchmark with %1 clients" ).arg ( iBenchmarkNumClients ) );
+            CommandLineOptions << "--benchmark";
+            ServerOnlyOptions << "--benchmark";
+            continue;
+        }
+
+        if ( GetNumericArgument ( argc, argv, i, "--benchmarkframes", "--benchmarkframes", 1, 100000000, rDbleArgument ) )
+        {
+            iBenchmarkNumFrames = static_cast<int> ( rDbleArgument );
+            qInfo() << qUtf8Printable ( QString ( "- benchmark frames: %1" ).arg ( iBenchmarkNumFrames ) );
+            CommandLineOptions << "--benchmarkframes";
+            ServerOnlyOptions << "--benchmarkframes";
+            continue;
+        }
+
+        if ( GetStringArgument ( argc, argv, i, "--benchmarkmix", "--benchmarkmix", strArgument ) )
+        {
+            strBenchmarkMix = strArgument;
+            qInfo() << qUtf8Printable ( QString ( "- benchmark client mix: %1" ).arg ( strBenchmarkMix ) );
+            CommandLineOptions << "--benchmarkmix";
+            ServerOnlyOptions << "--benchmarkmix";
+            continue;
+        }
+
+        // Packet capture and replay -------------------------------------------
+        if ( GetStringArgument ( argc, argv, i, "--capture", "--capture", strArgument ) )
+        {
+            strCaptureFileName = strArgument;
+            qInfo() << qUtf8Printable ( QString ( "- record the received packets in the capture file: %1" ).arg ( strCaptureFileName ) );
+            CommandLineOptions << "--capture";
+            ServerOnlyOptions << "--capture";
+            continue;
+        }
+
+        if ( GetStringArgument ( argc, argv, i, "--replay", "--replay", strArgument ) )
+        {
+            strReplayFileName = strArgument;
+            qInfo() << qUtf8Printable ( QString ( "- replay the capture file: %1" ).arg ( strReplayFileName ) );
+            CommandLineOptions << "--replay";
+            ServerOnlyOptions << "--replay";
+            continue;
+        }
+
         // Maximum number of channels ------------------------------------------
         if ( GetNumericArgument ( argc, argv, i, "-u", "--numchannels", 1, MAX_NUM_CHANNELS, rDbleArgument ) )
         {
@@ -703,6 +877,47 @@ int main ( int argc, char** argv )
             strServerInfo = "";
         }
 
+        // the benchmark needs neither the GUI nor the network, it does not take
+        // the port of a running server and may use all channels
+        if ( iBenchmarkNumClients > 0 )
+        {
+            bUseGUI             = false;
+            iPortNumber         = 0;
+            iNumServerChannels  = MAX_NUM_CHANNELS;
+            strDirectoryAddress = "";
+            iJsonRpcPortNumber  = INVALID_PORT;
+        }
+
+        // the same for the replay, the other server options are not changed so
+        // that they can be set like for the recorded server
+        if ( !strReplayFileName.isEmpty() )
+        {
+            bUseGUI             = false;
+            iPortNumber         = 0;
+            strDirectoryAddress = "";
+            iJsonRpcPortNumber  = INVALID_PORT;
+
+            if ( !strCaptureFileName.isEmpty() )
+            {
+                qWarning() << "- the replay is not captured, --capture is ignored";
+                strCaptureFileName = "";
+            }
+
+            // the overload and admission control react on the measured tick
+            // durations, i.e., the digest of the mixes would not be reproducible
+            if ( bUseOverloadControl )
+            {
+                qWarning() << "- the replay has no overload control, --overloadcontrol is ignored";
+                bUseOverloadControl = false;
+            }
+
+            if ( iAdmissionTargetPercent > 0 )
+            {
+                qWarning() << "- the replay has no admission control, --admission is ignored";
+                iAdmissionTargetPercent = 0;
+            }
+        }
+
 #ifndef HEADLESS
         if ( bUseGUI )
         {
@@ -1034,6 +1249,18 @@ int main ( int argc, char** argv )
 #endif
         {
             // Server:
+            // the replay needs the frame size of the recorded server
+            std::unique_ptr<CPacketCaptureReader> pReplayReader;
+
+            if ( !strReplayFileName.isEmpty() )
+            {
+                pReplayReader.reset ( new CPacketCaptureReader ( strReplayFileName ) );
+                bUseDoubleSystemFrameSize = ( pReplayReader->GetServerFrameSizeSamples() == DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES );
+            }
+
+            // the capture writer must outlive the sockets of the server
+            std::unique_ptr<CPacketCaptureWriter> pCaptureWriter;
+
             // actual server object
             CServer Server ( iNumServerChannels,
                              strLoggingFileName,
@@ -1054,9 +1281,41 @@ int main ( int argc, char** argv )
                              bUseMultithreading,
                              bDisableRecording,
                              bDelayPan,
+                             bUseMixMinus,
+                             bUseEncodeOnce,
+                             bPinCores,
+                             bUsePipeline,
+                             bDecodeOnArrival,
+                             iNumRecvSockets,
+                             bUseRtThread,
+                             bUseOverloadControl,
+                             iAdmissionTargetPercent,
                              bDisableIPv6,
                              eLicenceType );
 
+            // the benchmark runs the ticks itself and quits when it is done
+            if ( iBenchmarkNumClients > 0 )
+            {
+                CServerBenchmark Benchmark ( &Server, iBenchmarkNumClients, iBenchmarkNumFrames, strBenchmarkMix );
+
+                Benchmark.Run();
+                return 0;
+            }
+
+            if ( pReplayReader )
+            {
+                CServerReplay Replay ( &Server, pReplayReader.get() );
+
+                Replay.Run();
+                return 0;
+            }
+
+            if ( !strCaptureFileName.isEmpty() )
+            {
+                pCaptureWriter.reset ( new CPacketCaptureWriter ( strCaptureFileName, Server.GetServerFrameSizeSamples() ) );
+                Server.SetPacketCapture ( pCaptureWriter.get() );
+            }
+
 #ifndef NO_JSON_RPC
             if ( pRpcServer )
             {
@@ -1160,24 +1419,51 @@ QString UsageArguments ( char** argv )
            "                          (recommended to leave IPv6 enabled by default)\n"
            "\n"
            "Server only:\n"
+           "      --admission         refuse new Clients (server full) if the predicted\n"
+           "                          tick utilisation would exceed the given percentage\n"
+           "      --benchmark         run the offline benchmark of the audio processing\n"
+           "                          with the given number of synthetic Clients and quit\n"
+           "      --benchmarkframes   number of measured frames of the benchmark\n"
+           "                          (default: 10000)\n"
+           "      --benchmarkmix      Client types of the benchmark, e.g.\n"
+           "                          'opus64-stereo,opus-mono' (default: opus64-mono,opus64-stereo)\n"
+           "      --capture           record all received packets in the given capture file\n"
+           "      --decodeonarrival   decode audio packets when they are received instead\n"
+           "                          of in the audio processing of the Server\n"
            "  -d, --discononquit      disconnect all Clients on quit\n"
            "  -e, --directoryaddress  address of the Directory with which to register\n"
            "                          (or 'localhost' to run as a Directory)\n"
            "      --directoryfile     File to hold server list across Directory restarts. Directories only.\n"
+           "      --encodeonce        mix and encode only once for Clients which get\n"
+           "                          identical mixes\n"
            "  -f, --listfilter        Server list whitelist filter. Directories only. Format:\n"
            "                          [IP address 1];[IP address 2];[IP address 3]; ...\n"
            "  -F, --fastupdate        use 64 samples frame size mode\n"
            "  -l, --log               enable logging, set file name\n"
            "  -L, --licence           show an agreement window before users can connect\n"
+           "      --mixminus          mix Clients with (mostly) default fader settings from\n"
+           "                          a shared sum of all Clients (faster for large sessions)\n"
            "  -o, --serverinfo        registration info for this Server.  Format:\n"
            "                          [name];[city];[country as two-letter ISO country code or Qt5 QLocale ID]\n"
+           "      --overloadcontrol   reduce the audio quality step by step if the Server\n"
+           "                          gets close to its CPU limit\n"
            "      --serverpublicip    public IP address for this Server.  Needed when\n"
            "                          registering with a server list hosted\n"
            "                          behind the same NAT\n"
            "  -P, --delaypan          start with delay panning enabled\n"
+           "      --pincores          pin the multithreading workers to CPU cores (use with -T)\n"
+           "      --pipeline          decode the next frame while mixing the current one\n"
+           "                          (use with -T, adds one frame of server latency)\n"
            "  -R, --recording         set server recording directory; server will record when a session is active by default\n"
            "      --norecord          set server not to record by default when recording is configured\n"
            "      --noraw             disable raw audio\n"
+           "      --recvsockets       number of sockets (each with its own receive thread)\n"
+           "                          which share the server port (Linux only)\n"
+           "      --replay            replay the given capture file as fast as possible,\n"
+           "                          print the digest of the mixes and quit (without\n"
+           "                          overload and admission control)\n"
+           "      --rtthread          run the audio processing directly in the timer thread\n"
+           "                          (SCHED_FIFO and locked memory on Linux if permitted)\n"
            "  -s, --server            start Server\n"
            "      --serverbindip4     IPv4 address the Server will bind to (rather than all)\n"
            "      --serverbindip6     IPv6 address the Server will bind to (rather than all)\n"
@@ -0,0 +1,649 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "mixkernels.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#    define MIXKERNELS_X86
+#    include <immintrin.h>
+#    if defined( _MSC_VER ) && !defined( __clang__ )
+#        include <intrin.h>
+#        define MIXKERNELS_TARGET_SSE2
+#        define MIXKERNELS_TARGET_AVX2
+#    else
+#        define MIXKERNELS_TARGET_SSE2 __attribute__ ( ( target ( "sse2" ) ) )
+#        define MIXKERNELS_TARGET_AVX2 __attribute__ ( ( target ( "avx2" ) ) )
+#    endif
+#elif defined( __ARM_NEON ) || defined( __ARM_NEON__ )
+#    define MIXKERNELS_NEON
+#elif defined( __arm__ ) && defined( __linux__ ) && defined( __GNUC__ ) && !defined( __clang__ ) && ( __GNUC__ >= 8 )
+// 32 bit ARM target without NEON (e.g. armhf): the NEON code is compiled for
+// the NEON FPU only and is used if the CPU supports it
+#    define MIXKERNELS_NEON
+#    define MIXKERNELS_NEON_RUNTIME_CHECK
+#    include <sys/auxv.h>
+#    include <asm/hwcap.h>
+#endif
+
+// The scalar code is the reference and the tail loop of the SIMD code which
+// does not use fused multiply-add. The compiler must therefore not contract
+// the scalar multiply and add to an FMA (e.g., GCC does this by default on
+// aarch64).
+#if defined( __clang__ )
+#    pragma STDC FP_CONTRACT OFF
+#elif defined( __GNUC__ )
+#    pragma GCC optimize( "fp-contract=off" )
+#elif defined( _MSC_VER )
+#    pragma fp_contract( off )
+#endif
+
+/* Plain C++ implementation ***************************************************/
+// Note that the SIMD implementations below use the scalar functions for the
+// samples which do not fill a complete SIMD register. The scalar code is the
+// reference for the SIMD code, i.e., the order of the floating point
+// operations must be the same.
+static void AddMonoScalar ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    for ( int i = 0; i < iNumFrames; i++ )
+    {
+        pfDest[i] += psSrc[i];
+    }
+}
+
+static void AddMonoGainScalar ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    for ( int i = 0; i < iNumFrames; i++ )
+    {
+        pfDest[i] += psSrc[i] * fGain;
+    }
+}
+
+static void AddStereoToMonoScalar ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    for ( int i = 0, k = 0; i < iNumFrames; i++, k += 2 )
+    {
+        pfDest[i] += ( static_cast<float> ( psSrc[k] ) + psSrc[k + 1] ) / 2.0f;
+    }
+}
+
+static void AddStereoToMonoGainScalar ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    for ( int i = 0, k = 0; i < iNumFrames; i++, k += 2 )
+    {
+        pfDest[i] += fGain * ( static_cast<float> ( psSrc[k] ) + psSrc[k + 1] ) / 2.0f;
+    }
+}
+
+static void AddMonoToStereoScalar ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    for ( int i = 0, k = 0; i < iNumFrames; i++, k += 2 )
+    {
+        pfDest[k] += psSrc[i] * fGainL;
+        pfDest[k + 1] += psSrc[i] * fGainR;
+    }
+}
+
+static void AddStereoScalar ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    for ( int i = 0; i < 2 * iNumFrames; i += 2 )
+    {
+        pfDest[i] += psSrc[i] * fGainL;
+        pfDest[i + 1] += psSrc[i + 1] * fGainR;
+    }
+}
+
+static void Float2ShortClipScalar ( int16_t* psDest, const float* pfSrc, const int iNumSamples )
+{
+    for ( int i = 0; i < iNumSamples; i++ )
+    {
+        // same as Float2Short() in util.h
+        if ( pfSrc[i] < -32768.0f )
+        {
+            psDest[i] = -32768;
+        }
+        else if ( pfSrc[i] > 32767.0f )
+        {
+            psDest[i] = 32767;
+        }
+        else
+        {
+            psDest[i] = static_cast<int16_t> ( pfSrc[i] );
+        }
+    }
+}
+
+static const CMixKernels MixKernelsScalar = { "C++",
+                                              AddMonoScalar,
+                                              AddMonoGainScalar,
+                                              AddStereoToMonoScalar,
+                                              AddStereoToMonoGainScalar,
+                                              AddMonoToStereoScalar,
+                                              AddStereoScalar,
+                                              Float2ShortClipScalar };
+
+#ifdef MIXKERNELS_X86
+/* SSE2 implementation ********************************************************/
+// converts 4 16 bit samples to float
+MIXKERNELS_TARGET_SSE2 static inline __m128 LoadInt16x4Sse2 ( const int16_t* psSrc )
+{
+    const __m128i iSrc = _mm_loadl_epi64 ( reinterpret_cast<const __m128i*> ( psSrc ) );
+
+    // sign extension of the 16 bit values to 32 bit
+    return _mm_cvtepi32_ps ( _mm_srai_epi32 ( _mm_unpacklo_epi16 ( iSrc, iSrc ), 16 ) );
+}
+
+// sums up 4 stereo frames to 4 float values (exact since the sum of two 16 bit values fits in float)
+MIXKERNELS_TARGET_SSE2 static inline __m128 LoadStereoSumInt16x4Sse2 ( const int16_t* psSrc )
+{
+    const __m128i iSrc = _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( psSrc ) );
+
+    return _mm_cvtepi32_ps ( _mm_madd_epi16 ( iSrc, _mm_set1_epi16 ( 1 ) ) );
+}
+
+MIXKERNELS_TARGET_SSE2 static void AddMonoSse2 ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        _mm_storeu_ps ( &pfDest[i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[i] ), LoadInt16x4Sse2 ( &psSrc[i] ) ) );
+    }
+
+    AddMonoScalar ( &pfDest[i], &psSrc[i], iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_SSE2 static void AddMonoGainSse2 ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    const __m128 fvGain = _mm_set1_ps ( fGain );
+    int          i      = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        _mm_storeu_ps ( &pfDest[i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[i] ), _mm_mul_ps ( LoadInt16x4Sse2 ( &psSrc[i] ), fvGain ) ) );
+    }
+
+    AddMonoGainScalar ( &pfDest[i], &psSrc[i], fGain, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_SSE2 static void AddStereoToMonoSse2 ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    const __m128 fvHalf = _mm_set1_ps ( 0.5f ); // multiplication with 0.5 is identical to division by 2
+    int          i      = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        _mm_storeu_ps ( &pfDest[i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[i] ), _mm_mul_ps ( LoadStereoSumInt16x4Sse2 ( &psSrc[2 * i] ), fvHalf ) ) );
+    }
+
+    AddStereoToMonoScalar ( &pfDest[i], &psSrc[2 * i], iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_SSE2 static void AddStereoToMonoGainSse2 ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    const __m128 fvGain = _mm_set1_ps ( fGain );
+    const __m128 fvHalf = _mm_set1_ps ( 0.5f );
+    int          i      = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        const __m128 fvMix = _mm_mul_ps ( _mm_mul_ps ( fvGain, LoadStereoSumInt16x4Sse2 ( &psSrc[2 * i] ) ), fvHalf );
+
+        _mm_storeu_ps ( &pfDest[i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddStereoToMonoGainScalar ( &pfDest[i], &psSrc[2 * i], fGain, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_SSE2 static void
+AddMonoToStereoSse2 ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    const __m128 fvGainLR = _mm_setr_ps ( fGainL, fGainR, fGainL, fGainR );
+    int          i        = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        const __m128 fvSrc = LoadInt16x4Sse2 ( &psSrc[i] );
+
+        // duplicate each mono sample for the left and right channel
+        const __m128 fvLo = _mm_mul_ps ( _mm_unpacklo_ps ( fvSrc, fvSrc ), fvGainLR );
+        const __m128 fvHi = _mm_mul_ps ( _mm_unpackhi_ps ( fvSrc, fvSrc ), fvGainLR );
+
+        _mm_storeu_ps ( &pfDest[2 * i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[2 * i] ), fvLo ) );
+        _mm_storeu_ps ( &pfDest[2 * i + 4], _mm_add_ps ( _mm_loadu_ps ( &pfDest[2 * i + 4] ), fvHi ) );
+    }
+
+    AddMonoToStereoScalar ( &pfDest[2 * i], &psSrc[i], fGainL, fGainR, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_SSE2 static void AddStereoSse2 ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    const __m128 fvGainLR = _mm_setr_ps ( fGainL, fGainR, fGainL, fGainR );
+    int          i        = 0;
+
+    for ( ; i + 4 <= 2 * iNumFrames; i += 4 )
+    {
+        _mm_storeu_ps ( &pfDest[i], _mm_add_ps ( _mm_loadu_ps ( &pfDest[i] ), _mm_mul_ps ( LoadInt16x4Sse2 ( &psSrc[i] ), fvGainLR ) ) );
+    }
+
+    AddStereoScalar ( &pfDest[i], &psSrc[i], fGainL, fGainR, iNumFrames - i / 2 );
+}
+
+MIXKERNELS_TARGET_SSE2 static void Float2ShortClipSse2 ( int16_t* psDest, const float* pfSrc, const int iNumSamples )
+{
+    const __m128 fvMin = _mm_set1_ps ( -32768.0f );
+    const __m128 fvMax = _mm_set1_ps ( 32767.0f );
+    int          i     = 0;
+
+    for ( ; i + 8 <= iNumSamples; i += 8 )
+    {
+        // clip and convert with truncation (which is what static_cast<short> does)
+        const __m128i ivLo = _mm_cvttps_epi32 ( _mm_min_ps ( _mm_max_ps ( _mm_loadu_ps ( &pfSrc[i] ), fvMin ), fvMax ) );
+        const __m128i ivHi = _mm_cvttps_epi32 ( _mm_min_ps ( _mm_max_ps ( _mm_loadu_ps ( &pfSrc[i + 4] ), fvMin ), fvMax ) );
+
+        _mm_storeu_si128 ( reinterpret_cast<__m128i*> ( &psDest[i] ), _mm_packs_epi32 ( ivLo, ivHi ) );
+    }
+
+    Float2ShortClipScalar ( &psDest[i], &pfSrc[i], iNumSamples - i );
+}
+
+static const CMixKernels MixKernelsSse2 = { "SSE2",
+                                            AddMonoSse2,
+                                            AddMonoGainSse2,
+                                            AddStereoToMonoSse2,
+                                            AddStereoToMonoGainSse2,
+                                            AddMonoToStereoSse2,
+                                            AddStereoSse2,
+                                            Float2ShortClipSse2 };
+
+/* AVX2 implementation ********************************************************/
+// converts 8 16 bit samples to float
+MIXKERNELS_TARGET_AVX2 static inline __m256 LoadInt16x8Avx2 ( const int16_t* psSrc )
+{
+    return _mm256_cvtepi32_ps ( _mm256_cvtepi16_epi32 ( _mm_loadu_si128 ( reinterpret_cast<const __m128i*> ( psSrc ) ) ) );
+}
+
+// sums up 8 stereo frames to 8 float values
+MIXKERNELS_TARGET_AVX2 static inline __m256 LoadStereoSumInt16x8Avx2 ( const int16_t* psSrc )
+{
+    const __m256i iSrc = _mm256_loadu_si256 ( reinterpret_cast<const __m256i*> ( psSrc ) );
+
+    return _mm256_cvtepi32_ps ( _mm256_madd_epi16 ( iSrc, _mm256_set1_epi16 ( 1 ) ) );
+}
+
+MIXKERNELS_TARGET_AVX2 static void AddMonoAvx2 ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 8 <= iNumFrames; i += 8 )
+    {
+        _mm256_storeu_ps ( &pfDest[i], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[i] ), LoadInt16x8Avx2 ( &psSrc[i] ) ) );
+    }
+
+    AddMonoScalar ( &pfDest[i], &psSrc[i], iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_AVX2 static void AddMonoGainAvx2 ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    const __m256 fvGain = _mm256_set1_ps ( fGain );
+    int          i      = 0;
+
+    for ( ; i + 8 <= iNumFrames; i += 8 )
+    {
+        _mm256_storeu_ps ( &pfDest[i], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[i] ), _mm256_mul_ps ( LoadInt16x8Avx2 ( &psSrc[i] ), fvGain ) ) );
+    }
+
+    AddMonoGainScalar ( &pfDest[i], &psSrc[i], fGain, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_AVX2 static void AddStereoToMonoAvx2 ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    const __m256 fvHalf = _mm256_set1_ps ( 0.5f );
+    int          i      = 0;
+
+    for ( ; i + 8 <= iNumFrames; i += 8 )
+    {
+        _mm256_storeu_ps ( &pfDest[i],
+                           _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[i] ), _mm256_mul_ps ( LoadStereoSumInt16x8Avx2 ( &psSrc[2 * i] ), fvHalf ) ) );
+    }
+
+    AddStereoToMonoScalar ( &pfDest[i], &psSrc[2 * i], iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_AVX2 static void AddStereoToMonoGainAvx2 ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    const __m256 fvGain = _mm256_set1_ps ( fGain );
+    const __m256 fvHalf = _mm256_set1_ps ( 0.5f );
+    int          i      = 0;
+
+    for ( ; i + 8 <= iNumFrames; i += 8 )
+    {
+        const __m256 fvMix = _mm256_mul_ps ( _mm256_mul_ps ( fvGain, LoadStereoSumInt16x8Avx2 ( &psSrc[2 * i] ) ), fvHalf );
+
+        _mm256_storeu_ps ( &pfDest[i], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddStereoToMonoGainScalar ( &pfDest[i], &psSrc[2 * i], fGain, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_AVX2 static void
+AddMonoToStereoAvx2 ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    const __m256 fvGainLR = _mm256_setr_ps ( fGainL, fGainR, fGainL, fGainR, fGainL, fGainR, fGainL, fGainR );
+    int          i        = 0;
+
+    for ( ; i + 8 <= iNumFrames; i += 8 )
+    {
+        // duplicate each mono sample for the left and right channel (note that the AVX unpack
+        // instructions work on 128 bit lanes, the permutation restores the sample order)
+        const __m256 fvSrc = _mm256_permutevar8x32_ps ( LoadInt16x8Avx2 ( &psSrc[i] ), _mm256_setr_epi32 ( 0, 1, 4, 5, 2, 3, 6, 7 ) );
+        const __m256 fvLo  = _mm256_mul_ps ( _mm256_unpacklo_ps ( fvSrc, fvSrc ), fvGainLR );
+        const __m256 fvHi  = _mm256_mul_ps ( _mm256_unpackhi_ps ( fvSrc, fvSrc ), fvGainLR );
+
+        _mm256_storeu_ps ( &pfDest[2 * i], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[2 * i] ), fvLo ) );
+        _mm256_storeu_ps ( &pfDest[2 * i + 8], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[2 * i + 8] ), fvHi ) );
+    }
+
+    AddMonoToStereoScalar ( &pfDest[2 * i], &psSrc[i], fGainL, fGainR, iNumFrames - i );
+}
+
+MIXKERNELS_TARGET_AVX2 static void AddStereoAvx2 ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    const __m256 fvGainLR = _mm256_setr_ps ( fGainL, fGainR, fGainL, fGainR, fGainL, fGainR, fGainL, fGainR );
+    int          i        = 0;
+
+    for ( ; i + 8 <= 2 * iNumFrames; i += 8 )
+    {
+        _mm256_storeu_ps ( &pfDest[i], _mm256_add_ps ( _mm256_loadu_ps ( &pfDest[i] ), _mm256_mul_ps ( LoadInt16x8Avx2 ( &psSrc[i] ), fvGainLR ) ) );
+    }
+
+    AddStereoScalar ( &pfDest[i], &psSrc[i], fGainL, fGainR, iNumFrames - i / 2 );
+}
+
+MIXKERNELS_TARGET_AVX2 static void Float2ShortClipAvx2 ( int16_t* psDest, const float* pfSrc, const int iNumSamples )
+{
+    const __m256 fvMin = _mm256_set1_ps ( -32768.0f );
+    const __m256 fvMax = _mm256_set1_ps ( 32767.0f );
+    int          i     = 0;
+
+    for ( ; i + 16 <= iNumSamples; i += 16 )
+    {
+        const __m256i ivLo = _mm256_cvttps_epi32 ( _mm256_min_ps ( _mm256_max_ps ( _mm256_loadu_ps ( &pfSrc[i] ), fvMin ), fvMax ) );
+        const __m256i ivHi = _mm256_cvttps_epi32 ( _mm256_min_ps ( _mm256_max_ps ( _mm256_loadu_ps ( &pfSrc[i + 8] ), fvMin ), fvMax ) );
+
+        // the pack instruction works on 128 bit lanes, the permutation restores the sample order
+        _mm256_storeu_si256 ( reinterpret_cast<__m256i*> ( &psDest[i] ), _mm256_permute4x64_epi64 ( _mm256_packs_epi32 ( ivLo, ivHi ), 0xD8 ) );
+    }
+
+    Float2ShortClipScalar ( &psDest[i], &pfSrc[i], iNumSamples - i );
+}
+
+static const CMixKernels MixKernelsAvx2 = { "AVX2",
+                                            AddMonoAvx2,
+                                            AddMonoGainAvx2,
+                                            AddStereoToMonoAvx2,
+                                            AddStereoToMonoGainAvx2,
+                                            AddMonoToStereoAvx2,
+                                            AddStereoAvx2,
+                                            Float2ShortClipAvx2 };
+
+static bool CpuSupportsSse2()
+{
+#    if defined( _M_X64 ) || defined( __x86_64__ )
+    return true; // x86_64 implies SSE2
+#    elif defined( _MSC_VER ) && !defined( __clang__ )
+    int iCpuInfo[4];
+    __cpuid ( iCpuInfo, 1 );
+    return ( iCpuInfo[3] & ( 1 << 26 ) ) != 0;
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports ( "sse2" );
+#    endif
+}
+
+static bool CpuSupportsAvx2()
+{
+#    if defined( _MSC_VER ) && !defined( __clang__ )
+    int iCpuInfo[4];
+
+    // AVX2 requires the OS to save the YMM registers (OSXSAVE and XCR0)
+    __cpuid ( iCpuInfo, 0 );
+    if ( iCpuInfo[0] < 7 )
+    {
+        return false;
+    }
+    __cpuid ( iCpuInfo, 1 );
+    if ( ( iCpuInfo[2] & ( 1 << 27 ) ) == 0 || ( _xgetbv ( 0 ) & 6 ) != 6 )
+    {
+        return false;
+    }
+    __cpuidex ( iCpuInfo, 7, 0 );
+    return ( iCpuInfo[1] & ( 1 << 5 ) ) != 0;
+#    else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports ( "avx2" );
+#    endif
+}
+#endif
+
+#ifdef MIXKERNELS_NEON
+/* NEON implementation ********************************************************/
+// Note that vmlaq_f32 is not used on purpose: it might be fused on some
+// compilers/CPUs which would give results different from the C++ code.
+#    ifdef MIXKERNELS_NEON_RUNTIME_CHECK
+#        pragma GCC push_options
+#        pragma GCC target( "fpu=neon" )
+#    endif
+#    include <arm_neon.h>
+
+static void AddMonoNeon ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        vst1q_f32 ( &pfDest[i], vaddq_f32 ( vld1q_f32 ( &pfDest[i] ), vcvtq_f32_s32 ( vmovl_s16 ( vld1_s16 ( &psSrc[i] ) ) ) ) );
+    }
+
+    AddMonoScalar ( &pfDest[i], &psSrc[i], iNumFrames - i );
+}
+
+static void AddMonoGainNeon ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        const float32x4_t fvMix = vmulq_n_f32 ( vcvtq_f32_s32 ( vmovl_s16 ( vld1_s16 ( &psSrc[i] ) ) ), fGain );
+
+        vst1q_f32 ( &pfDest[i], vaddq_f32 ( vld1q_f32 ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddMonoGainScalar ( &pfDest[i], &psSrc[i], fGain, iNumFrames - i );
+}
+
+static void AddStereoToMonoNeon ( float* pfDest, const int16_t* psSrc, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        // pairwise add of left and right channel (exact in 32 bit)
+        const float32x4_t fvMix = vmulq_n_f32 ( vcvtq_f32_s32 ( vpaddlq_s16 ( vld1q_s16 ( &psSrc[2 * i] ) ) ), 0.5f );
+
+        vst1q_f32 ( &pfDest[i], vaddq_f32 ( vld1q_f32 ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddStereoToMonoScalar ( &pfDest[i], &psSrc[2 * i], iNumFrames - i );
+}
+
+static void AddStereoToMonoGainNeon ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        const float32x4_t fvSum = vcvtq_f32_s32 ( vpaddlq_s16 ( vld1q_s16 ( &psSrc[2 * i] ) ) );
+        const float32x4_t fvMix = vmulq_n_f32 ( vmulq_n_f32 ( fvSum, fGain ), 0.5f );
+
+        vst1q_f32 ( &pfDest[i], vaddq_f32 ( vld1q_f32 ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddStereoToMonoGainScalar ( &pfDest[i], &psSrc[2 * i], fGain, iNumFrames - i );
+}
+
+static void AddMonoToStereoNeon ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    int i = 0;
+
+    for ( ; i + 4 <= iNumFrames; i += 4 )
+    {
+        const float32x4_t fvSrc = vcvtq_f32_s32 ( vmovl_s16 ( vld1_s16 ( &psSrc[i] ) ) );
+        float32x4x2_t     fvLR  = vld2q_f32 ( &pfDest[2 * i] ); // de-interleave left/right
+
+        fvLR.val[0] = vaddq_f32 ( fvLR.val[0], vmulq_n_f32 ( fvSrc, fGainL ) );
+        fvLR.val[1] = vaddq_f32 ( fvLR.val[1], vmulq_n_f32 ( fvSrc, fGainR ) );
+
+        vst2q_f32 ( &pfDest[2 * i], fvLR );
+    }
+
+    AddMonoToStereoScalar ( &pfDest[2 * i], &psSrc[i], fGainL, fGainR, iNumFrames - i );
+}
+
+static void AddStereoNeon ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames )
+{
+    const float       fGainLR[4] = { fGainL, fGainR, fGainL, fGainR };
+    const float32x4_t fvGainLR   = vld1q_f32 ( fGainLR );
+    int               i          = 0;
+
+    for ( ; i + 4 <= 2 * iNumFrames; i += 4 )
+    {
+        const float32x4_t fvMix = vmulq_f32 ( vcvtq_f32_s32 ( vmovl_s16 ( vld1_s16 ( &psSrc[i] ) ) ), fvGainLR );
+
+        vst1q_f32 ( &pfDest[i], vaddq_f32 ( vld1q_f32 ( &pfDest[i] ), fvMix ) );
+    }
+
+    AddStereoScalar ( &pfDest[i], &psSrc[i], fGainL, fGainR, iNumFrames - i / 2 );
+}
+
+static void Float2ShortClipNeon ( int16_t* psDest, const float* pfSrc, const int iNumSamples )
+{
+    const float32x4_t fvMin = vdupq_n_f32 ( -32768.0f );
+    const float32x4_t fvMax = vdupq_n_f32 ( 32767.0f );
+    int               i     = 0;
+
+    for ( ; i + 8 <= iNumSamples; i += 8 )
+    {
+        // clip and convert with truncation (which is what static_cast<short> does)
+        const int32x4_t ivLo = vcvtq_s32_f32 ( vminq_f32 ( vmaxq_f32 ( vld1q_f32 ( &pfSrc[i] ), fvMin ), fvMax ) );
+        const int32x4_t ivHi = vcvtq_s32_f32 ( vminq_f32 ( vmaxq_f32 ( vld1q_f32 ( &pfSrc[i + 4] ), fvMin ), fvMax ) );
+
+        vst1q_s16 ( &psDest[i], vcombine_s16 ( vqmovn_s32 ( ivLo ), vqmovn_s32 ( ivHi ) ) );
+    }
+
+    Float2ShortClipScalar ( &psDest[i], &pfSrc[i], iNumSamples - i );
+}
+
+static const CMixKernels MixKernelsNeon = { "NEON",
+                                            AddMonoNeon,
+                                            AddMonoGainNeon,
+                                            AddStereoToMonoNeon,
+                                            AddStereoToMonoGainNeon,
+                                            AddMonoToStereoNeon,
+                                            AddStereoNeon,
+                                            Float2ShortClipNeon };
+
+#    ifdef MIXKERNELS_NEON_RUNTIME_CHECK
+#        pragma GCC pop_options
+
+static bool CpuSupportsNeon()
+{
+    return ( getauxval ( AT_HWCAP ) & HWCAP_NEON ) != 0;
+}
+#    endif
+#endif
+
+/* Runtime selection **********************************************************/
+std::vector<const CMixKernels*> CMixKernels::GetSupported()
+{
+    std::vector<const CMixKernels*> vecSupported;
+
+    vecSupported.push_back ( &MixKernelsScalar );
+
+#ifdef MIXKERNELS_X86
+    if ( CpuSupportsSse2() )
+    {
+        vecSupported.push_back ( &MixKernelsSse2 );
+    }
+
+    if ( CpuSupportsAvx2() )
+    {
+        vecSupported.push_back ( &MixKernelsAvx2 );
+    }
+#endif
+
+#ifdef MIXKERNELS_NEON
+#    ifdef MIXKERNELS_NEON_RUNTIME_CHECK
+    if ( CpuSupportsNeon() )
+    {
+        vecSupported.push_back ( &MixKernelsNeon );
+    }
+#    else
+    // NEON is part of the compile target, no runtime check needed
+    vecSupported.push_back ( &MixKernelsNeon );
+#    endif
+#endif
+
+    return vecSupported;
+}
+
+const CMixKernels& CMixKernels::Get()
+{
+    // the kernels are ordered by their speed, the last one is the fastest
+    // (thread-safe static initialization, only done once)
+    static const CMixKernels& MixKernels = *GetSupported().back();
+
+    return MixKernels;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/* Classes ********************************************************************/
+// Audio mixing kernels of the server. All kernels accumulate 16 bit audio
+// samples with a gain on a float mix buffer or convert the float mix buffer
+// back to 16 bit with clipping. There is a plain C++ implementation and SIMD
+// implementations for SSE2/AVX2 (x86) and NEON (ARM). The best variant for
+// the current CPU is selected once at runtime. All variants perform exactly
+// the same floating point operations per sample (mixkernels.cpp is compiled
+// without FMA contraction) so that the results are bit identical to the plain
+// C++ implementation. The only exception is NEON on 32 bit ARM which flushes
+// denormals to zero.
+class CMixKernels
+{
+public:
+    // name of the kernel set, e.g. "AVX2"
+    const char* strName;
+
+    // mono source on mono target, unity gain
+    void ( *AddMono ) ( float* pfDest, const int16_t* psSrc, const int iNumFrames );
+
+    // mono source on mono target with gain
+    void ( *AddMonoGain ) ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames );
+
+    // stereo source on mono target (stereo-to-mono attenuation), unity gain
+    void ( *AddStereoToMono ) ( float* pfDest, const int16_t* psSrc, const int iNumFrames );
+
+    // stereo source on mono target (stereo-to-mono attenuation) with gain
+    void ( *AddStereoToMonoGain ) ( float* pfDest, const int16_t* psSrc, const float fGain, const int iNumFrames );
+
+    // mono source on stereo target with separate left/right gains
+    void ( *AddMonoToStereo ) ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames );
+
+    // stereo source on stereo target with separate left/right gains
+    void ( *AddStereo ) ( float* pfDest, const int16_t* psSrc, const float fGainL, const float fGainR, const int iNumFrames );
+
+    // convert float to short with clipping (same result as Float2Short())
+    void ( *Float2ShortClip ) ( int16_t* psDest, const float* pfSrc, const int iNumSamples );
+
+    // returns the fastest kernel set supported by the current CPU
+    static const CMixKernels& Get();
+
+    // returns all kernel sets supported by the current CPU, the plain C++
+    // implementation always comes first (used for benchmarking/verification)
+    static std::vector<const CMixKernels*> GetSupported();
+};
@@ -0,0 +1,138 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "overloadcontroller.h"
+#include <algorithm>
+#include <cstring>
+
+/* Implementation *************************************************************/
+void COverloadController::Init ( const int64_t iNewDeadlineNs, const bool bNUseLevels )
+{
+    bUseLevels     = bNUseLevels;
+    iDeadlineNs    = iNewDeadlineNs;
+    iEscalateTicks = static_cast<int> ( std::max<int64_t> ( static_cast<int64_t> ( OVERLOAD_ESCALATE_MS ) * 1000000 / iDeadlineNs, 1 ) );
+    iRevertTicks   = static_cast<int> ( std::max<int64_t> ( static_cast<int64_t> ( OVERLOAD_REVERT_MS ) * 1000000 / iDeadlineNs, 1 ) );
+
+    Reset();
+}
+
+void COverloadController::Update ( const int64_t iTickDurationNs )
+{
+    // exponential smoothing of the utilisation (a missed deadline counts with
+    // more than 100 %)
+    const float fTickUtilisation = static_cast<float> ( iTickDurationNs ) / iDeadlineNs;
+    const float fOldUtilisation  = fUtilisation.load ( std::memory_order_relaxed );
+    const float fNewUtilisation  = fOldUtilisation + ( fTickUtilisation - fOldUtilisation ) / OVERLOAD_SMOOTHING_TICKS;
+
+    fUtilisation.store ( fNewUtilisation, std::memory_order_relaxed );
+
+    if ( !bUseLevels )
+    {
+        return;
+    }
+
+    iNumTicksAbove = ( fNewUtilisation > OVERLOAD_HIGH_UTILISATION ) ? iNumTicksAbove + 1 : 0;
+    iNumTicksBelow = ( fNewUtilisation < OVERLOAD_LOW_UTILISATION ) ? iNumTicksBelow + 1 : 0;
+
+    const int iLevel = GetLevel();
+
+    // after a level change, the time starts again so that the effect of the
+    // new level can be seen before the next change
+    if ( ( iNumTicksAbove >= iEscalateTicks ) && ( iLevel < OL_MAX_LEVEL ) )
+    {
+        eLevel.store ( static_cast<EOverloadLevel> ( iLevel + 1 ), std::memory_order_relaxed );
+        iNumTicksAbove = 0;
+    }
+    else if ( ( iNumTicksBelow >= iRevertTicks ) && ( iLevel > OL_NORMAL ) )
+    {
+        eLevel.store ( static_cast<EOverloadLevel> ( iLevel - 1 ), std::memory_order_relaxed );
+        iNumTicksBelow = 0;
+    }
+}
+
+void COverloadController::Reset()
+{
+    iNumTicksAbove = 0;
+    iNumTicksBelow = 0;
+
+    fUtilisation.store ( 0, std::memory_order_relaxed );
+    eLevel.store ( OL_NORMAL, std::memory_order_relaxed );
+}
+
+uint32_t COverloadController::GetSimilarGainStep ( const float fGain )
+{
+    // the bit pattern of a positive float grows monotonically with its value,
+    // the exponent and the most significant bits of the mantissa are a
+    // logarithmic scale (a negative or zero gain is mapped to step zero)
+    if ( fGain <= 0 )
+    {
+        return 0;
+    }
+
+    uint32_t iBits;
+    memcpy ( &iBits, &fGain, sizeof ( iBits ) );
+
+    return iBits >> ( 23 - OVERLOAD_SIMILAR_GAIN_SUB_BUCKET_BITS );
+}
+
+const char* COverloadController::GetLevelName ( const EOverloadLevel eOverloadLevel )
+{
+    switch ( eOverloadLevel )
+    {
+    case OL_NORMAL:
+        return "normal";
+    case OL_LOW_COMPLEXITY:
+        return "lowComplexity";
+    case OL_MONO_MIXES:
+        return "monoMixes";
+    case OL_SHARED_MIXES:
+        return "sharedMixes";
+    case OL_NO_SILENT_PLC:
+        return "noSilentPlc";
+    }
+
+    return "unknown";
+}
@@ -0,0 +1,135 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "global.h"
+
+/* Definitions ****************************************************************/
+// the utilisation of a tick is its duration relative to the frame duration, it
+// is smoothed with a time constant of about this number of ticks
+#define OVERLOAD_SMOOTHING_TICKS 64
+
+// The next level is applied if the smoothed utilisation stays above the high
+// mark for the escalation time, the last level is reverted if it stays below
+// the low mark for the revert time. The revert time is much longer so that the
+// controller does not oscillate between two levels.
+#define OVERLOAD_HIGH_UTILISATION 0.85f
+#define OVERLOAD_LOW_UTILISATION  0.6f
+#define OVERLOAD_ESCALATE_MS      250
+#define OVERLOAD_REVERT_MS        5000
+
+// similar gains for sharing mixes: 2^OVERLOAD_SIMILAR_GAIN_SUB_BUCKET_BITS
+// steps per octave (about 1.5 dB) and OVERLOAD_SIMILAR_PAN_STEPS pan positions
+#define OVERLOAD_SIMILAR_GAIN_SUB_BUCKET_BITS 2
+#define OVERLOAD_SIMILAR_PAN_STEPS            8
+
+// an input is long-silent if the peak of all its frames in this time is not
+// larger than the threshold (16 bit samples), its lost packets are then not
+// concealed but replaced by silence
+#define OVERLOAD_SILENT_INPUT_MS   2000
+#define OVERLOAD_SILENCE_THRESHOLD 8
+
+// the degradation levels, each level includes all lower levels
+enum EOverloadLevel
+{
+    OL_NORMAL         = 0, // no degradation
+    OL_LOW_COMPLEXITY = 1, // lowest OPUS encoder complexity
+    OL_MONO_MIXES     = 2, // stereo listeners get a mono mix
+    OL_SHARED_MIXES   = 3, // listeners with similar gains share a mix
+    OL_NO_SILENT_PLC  = 4, // no packet loss concealment for long-silent inputs
+    OL_MAX_LEVEL      = OL_NO_SILENT_PLC
+};
+
+/* Classes ********************************************************************/
+// Selects the degradation level of the server from the measured tick
+// durations. The level is updated by the timer thread after each tick and may
+// be read by any thread. Without levels, only the utilisation is measured
+// (e.g. for the admission control).
+class COverloadController
+{
+public:
+    COverloadController() :
+        bUseLevels ( false ),
+        iDeadlineNs ( 1 ),
+        iEscalateTicks ( 1 ),
+        iRevertTicks ( 1 ),
+        iNumTicksAbove ( 0 ),
+        iNumTicksBelow ( 0 ),
+        fUtilisation ( 0 ),
+        eLevel ( OL_NORMAL )
+    {}
+
+    void Init ( const int64_t iNewDeadlineNs, const bool bNUseLevels );
+
+    // called by the timer thread after each tick
+    void Update ( const int64_t iTickDurationNs );
+
+    // back to normal operation (e.g. if the server stops)
+    void Reset();
+
+    EOverloadLevel GetLevel() const { return eLevel.load ( std::memory_order_relaxed ); }
+    float          GetUtilisation() const { return fUtilisation.load ( std::memory_order_relaxed ); }
+
+    // maps a gain or pan to a step so that similar values get the same step
+    static uint32_t GetSimilarGainStep ( const float fGain );
+    static int      GetSimilarPanStep ( const float fPan ) { return static_cast<int> ( fPan * OVERLOAD_SIMILAR_PAN_STEPS + 0.5f ); }
+
+    static const char* GetLevelName ( const EOverloadLevel eOverloadLevel );
+
+protected:
+    bool    bUseLevels;
+    int64_t iDeadlineNs;
+    int     iEscalateTicks;
+    int     iRevertTicks;
+    int     iNumTicksAbove;
+    int     iNumTicksBelow;
+
+    std::atomic<float>          fUtilisation;
+    std::atomic<EOverloadLevel> eLevel;
+};
@@ -0,0 +1,248 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "packetcapture.h"
+
+/* Implementation *************************************************************/
+static void PutLittleEndian ( uint8_t* pDest, const uint32_t iVal, const int iNumOfBytes )
+{
+    for ( int i = 0; i < iNumOfBytes; i++ )
+    {
+        pDest[i] = static_cast<uint8_t> ( ( iVal >> ( 8 * i ) ) & 0xFF );
+    }
+}
+
+static uint32_t GetLittleEndian ( const uint8_t* pSrc, const int iNumOfBytes )
+{
+    uint32_t iVal = 0;
+
+    for ( int i = 0; i < iNumOfBytes; i++ )
+    {
+        iVal |= static_cast<uint32_t> ( pSrc[i] ) << ( 8 * i );
+    }
+
+    return iVal;
+}
+
+CPacketCaptureWriter::CPacketCaptureWriter ( const QString& strFileName, const int iServerFrameSizeSamples ) :
+    File ( strFileName ),
+    iActiveBuffer ( 0 ),
+    LastPacketTime ( std::chrono::steady_clock::now() ),
+    bStop ( false ),
+    iNumPackets ( 0 ),
+    iNumDropped ( 0 )
+{
+    if ( !File.open ( QIODevice::WriteOnly | QIODevice::Truncate ) )
+    {
+        throw CGenErr ( QString ( "The packet capture file '%1' cannot be opened for writing." ).arg ( strFileName ) );
+    }
+
+    uint8_t vecbyHeader[PACKET_CAPTURE_HEADER_LEN];
+
+    memcpy ( vecbyHeader, PACKET_CAPTURE_MAGIC, PACKET_CAPTURE_MAGIC_LEN );
+    PutLittleEndian ( &vecbyHeader[PACKET_CAPTURE_MAGIC_LEN], PACKET_CAPTURE_VERSION, 4 );
+    PutLittleEndian ( &vecbyHeader[PACKET_CAPTURE_MAGIC_LEN + 4], static_cast<uint32_t> ( iServerFrameSizeSamples ), 4 );
+
+    File.write ( reinterpret_cast<const char*> ( vecbyHeader ), PACKET_CAPTURE_HEADER_LEN );
+
+    for ( int i = 0; i < 2; i++ )
+    {
+        vecbyBuffer[i].Init ( PACKET_CAPTURE_BUFFER_SIZE );
+        iBufferFill[i] = 0;
+    }
+
+    Thread = std::thread ( &CPacketCaptureWriter::WriterThread, this );
+}
+
+CPacketCaptureWriter::~CPacketCaptureWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock ( Mutex );
+        bStop = true;
+    }
+    CondWrite.notify_one();
+
+    // the writer thread writes the remaining data before it returns
+    Thread.join();
+
+    File.close();
+}
+
+void CPacketCaptureWriter::Add ( const CVector<uint8_t>& vecbyData, const int iNumBytes, const CHostAddress& HostAddr )
+{
+    bool bWakeUpWriter = false;
+
+    {
+        std::unique_lock<std::mutex> lock ( Mutex );
+
+        CVector<uint8_t>& vecbyActive = vecbyBuffer[iActiveBuffer];
+        int&              iFill       = iBufferFill[iActiveBuffer];
+
+        if ( iFill + PACKET_CAPTURE_RECORD_HEAD_LEN + iNumBytes > vecbyActive.Size() )
+        {
+            iNumDropped.fetch_add ( 1, std::memory_order_relaxed );
+            return;
+        }
+
+        // the time is taken under the mutex so that the times of the packets
+        // of different socket threads are in order (the remainder of the
+        // microsecond is kept so that the rounding errors do not add up)
+        const std::chrono::steady_clock::time_point CurTime = std::chrono::steady_clock::now();
+
+        const int64_t iDeltaUs = std::chrono::duration_cast<std::chrono::microseconds> ( CurTime - LastPacketTime ).count();
+
+        LastPacketTime += std::chrono::microseconds ( iDeltaUs );
+
+        uint8_t* pRecord = &vecbyActive[iFill];
+
+        // a pause of more than an hour is shortened (the server sleeps anyway)
+        PutLittleEndian ( pRecord, static_cast<uint32_t> ( std::min<int64_t> ( iDeltaUs, UINT32_MAX ) ), 4 );
+        memcpy ( pRecord + 4, HostAddr.byAddr, sizeof ( HostAddr.byAddr ) );
+        PutLittleEndian ( pRecord + 20, HostAddr.iPort, 2 );
+        PutLittleEndian ( pRecord + 22, static_cast<uint32_t> ( iNumBytes ), 2 );
+        memcpy ( pRecord + PACKET_CAPTURE_RECORD_HEAD_LEN, &vecbyData[0], static_cast<size_t> ( iNumBytes ) );
+
+        iFill += PACKET_CAPTURE_RECORD_HEAD_LEN + iNumBytes;
+        iNumPackets.fetch_add ( 1, std::memory_order_relaxed );
+
+        // do not wait for the flush interval if the buffer gets full
+        bWakeUpWriter = ( iFill > vecbyActive.Size() / 2 );
+    }
+
+    if ( bWakeUpWriter )
+    {
+        CondWrite.notify_one();
+    }
+}
+
+void CPacketCaptureWriter::WriterThread()
+{
+    for ( ;; )
+    {
+        int  iWriteBuffer;
+        bool bLastWrite;
+
+        {
+            std::unique_lock<std::mutex> lock ( Mutex );
+
+            CondWrite.wait_for ( lock, std::chrono::milliseconds ( PACKET_CAPTURE_FLUSH_INTERVAL_MS ), [this] {
+                return bStop || ( iBufferFill[iActiveBuffer] > vecbyBuffer[iActiveBuffer].Size() / 2 );
+            } );
+
+            // the socket threads continue with the other buffer which was
+            // already written to the file
+            iWriteBuffer  = iActiveBuffer;
+            iActiveBuffer = 1 - iActiveBuffer;
+            bLastWrite    = bStop;
+        }
+
+        if ( iBufferFill[iWriteBuffer] > 0 )
+        {
+            File.write ( reinterpret_cast<const char*> ( &vecbyBuffer[iWriteBuffer][0] ), iBufferFill[iWriteBuffer] );
+            File.flush();
+        }
+
+        {
+            std::unique_lock<std::mutex> lock ( Mutex );
+            iBufferFill[iWriteBuffer] = 0;
+        }
+
+        if ( bLastWrite )
+        {
+            return;
+        }
+    }
+}
+
+CPacketCaptureReader::CPacketCaptureReader ( const QString& strFileName ) : File ( strFileName ), iServerFrameSizeSamples ( 0 ), iCurTimeUs ( 0 )
+{
+    if ( !File.open ( QIODevice::ReadOnly ) )
+    {
+        throw CGenErr ( QString ( "The packet capture file '%1' cannot be opened for reading." ).arg ( strFileName ) );
+    }
+
+    uint8_t vecbyHeader[PACKET_CAPTURE_HEADER_LEN];
+
+    if ( ( File.read ( reinterpret_cast<char*> ( vecbyHeader ), PACKET_CAPTURE_HEADER_LEN ) != PACKET_CAPTURE_HEADER_LEN ) ||
+         ( memcmp ( vecbyHeader, PACKET_CAPTURE_MAGIC, PACKET_CAPTURE_MAGIC_LEN ) != 0 ) ||
+         ( GetLittleEndian ( &vecbyHeader[PACKET_CAPTURE_MAGIC_LEN], 4 ) != PACKET_CAPTURE_VERSION ) )
+    {
+        throw CGenErr ( QString ( "The file '%1' is no valid packet capture file." ).arg ( strFileName ) );
+    }
+
+    iServerFrameSizeSamples = static_cast<int> ( GetLittleEndian ( &vecbyHeader[PACKET_CAPTURE_MAGIC_LEN + 4], 4 ) );
+
+    if ( ( iServerFrameSizeSamples != SYSTEM_FRAME_SIZE_SAMPLES ) && ( iServerFrameSizeSamples != DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES ) )
+    {
+        throw CGenErr ( QString ( "The packet capture file '%1' has an unsupported frame size." ).arg ( strFileName ) );
+    }
+}
+
+bool CPacketCaptureReader::ReadPacket ( int64_t& iTimeNs, CHostAddress& HostAddr, CVector<uint8_t>& vecbyData, int& iNumBytes )
+{
+    uint8_t vecbyRecordHead[PACKET_CAPTURE_RECORD_HEAD_LEN];
+
+    if ( File.read ( reinterpret_cast<char*> ( vecbyRecordHead ), PACKET_CAPTURE_RECORD_HEAD_LEN ) != PACKET_CAPTURE_RECORD_HEAD_LEN )
+    {
+        return false;
+    }
+
+    iCurTimeUs += GetLittleEndian ( vecbyRecordHead, 4 );
+
+    iTimeNs = iCurTimeUs * 1000;
+
+    HostAddr.SetIPv6 ( vecbyRecordHead + 4, static_cast<quint16> ( GetLittleEndian ( vecbyRecordHead + 20, 2 ) ) );
+
+    iNumBytes = static_cast<int> ( GetLittleEndian ( vecbyRecordHead + 22, 2 ) );
+
+    if ( vecbyData.Size() < iNumBytes )
+    {
+        vecbyData.Init ( iNumBytes );
+    }
+
+    // a truncated last record (e.g. the server was killed) ends the capture
+    return ( iNumBytes == 0 ) || ( File.read ( reinterpret_cast<char*> ( &vecbyData[0] ), iNumBytes ) == iNumBytes );
+}
@@ -0,0 +1,132 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QFile>
+#include <QString>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <atomic>
+#include "global.h"
+#include "util.h"
+
+/* Definitions ****************************************************************/
+// The capture file starts with a header (magic, version and the frame size of
+// the server in samples, as 32 bit values) followed by one record per received
+// datagram: time since the previous record in microseconds (32 bit), address
+// (16 bytes, IPv4 addresses are IPv4-mapped), port (16 bit), length of the
+// datagram (16 bit) and the datagram itself. All values are little endian.
+#define PACKET_CAPTURE_MAGIC           "JAMULCAP"
+#define PACKET_CAPTURE_MAGIC_LEN       8
+#define PACKET_CAPTURE_VERSION         1
+#define PACKET_CAPTURE_HEADER_LEN      ( PACKET_CAPTURE_MAGIC_LEN + 8 )
+#define PACKET_CAPTURE_RECORD_HEAD_LEN 24
+
+// size of each of the two memory buffers of the capture writer, if the file
+// cannot be written fast enough, the packets are dropped
+#define PACKET_CAPTURE_BUFFER_SIZE 1048576
+
+// interval in which the writer thread flushes the buffer to the file
+#define PACKET_CAPTURE_FLUSH_INTERVAL_MS 200
+
+/* Classes ********************************************************************/
+// Records all datagrams received by the server. The socket threads only copy
+// the datagram into a preallocated memory buffer, the file is written by a
+// separate thread so that the receive threads are never blocked by the disk.
+class CPacketCaptureWriter
+{
+public:
+    CPacketCaptureWriter ( const QString& strFileName, const int iServerFrameSizeSamples );
+    virtual ~CPacketCaptureWriter();
+
+    // called by the socket threads
+    void Add ( const CVector<uint8_t>& vecbyData, const int iNumBytes, const CHostAddress& HostAddr );
+
+    int64_t GetNumPackets() const { return iNumPackets.load ( std::memory_order_relaxed ); }
+    int64_t GetNumDropped() const { return iNumDropped.load ( std::memory_order_relaxed ); }
+
+protected:
+    void WriterThread();
+
+    QFile File;
+
+    // the socket threads write in the active buffer while the writer thread
+    // writes the other one to the file
+    CVector<uint8_t> vecbyBuffer[2];
+    int              iBufferFill[2];
+    int              iActiveBuffer;
+
+    std::chrono::steady_clock::time_point LastPacketTime;
+
+    std::mutex              Mutex;
+    std::condition_variable CondWrite;
+    bool                    bStop;
+    std::thread             Thread;
+
+    std::atomic<int64_t> iNumPackets;
+    std::atomic<int64_t> iNumDropped;
+};
+
+// Reads the datagrams of a capture file in the order in which they were received.
+class CPacketCaptureReader
+{
+public:
+    CPacketCaptureReader ( const QString& strFileName );
+
+    int GetServerFrameSizeSamples() const { return iServerFrameSizeSamples; }
+
+    // returns false at the end of the file, the time of the datagram is given
+    // relative to the start of the capture
+    bool ReadPacket ( int64_t& iTimeNs, CHostAddress& HostAddr, CVector<uint8_t>& vecbyData, int& iNumBytes );
+
+protected:
+    QFile   File;
+    int     iServerFrameSizeSamples;
+    int64_t iCurTimeUs;
+};
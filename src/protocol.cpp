@@ -1824,7 +1824,7 @@ void CProtocol::CreateCLRegisterServerMes ( const CHostAddress& InetAddr, const
     int iPos = 0; // init position pointer
 
     // convert server info strings to utf-8
-    const QByteArray strUTF8LInetAddr = LInetAddr.InetAddr.toString().toUtf8();
+    const QByteArray strUTF8LInetAddr = LInetAddr.GetQHostAddress().toString().toUtf8();
     const QByteArray strUTF8Name      = ServerInfo.strName.toUtf8();
     const QByteArray strUTF8City      = ServerInfo.strCity.toUtf8();
 
@@ -1879,7 +1879,7 @@ bool CProtocol::EvaluateCLRegisterServerMes ( const CHostAddress& InetAddr, cons
     }
 
     // port number (2 bytes)
-    LInetAddr.iPort = static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) );
+    LInetAddr.SetPort ( static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) ) );
 
     // country (2 bytes)
     RecServerInfo.eCountry = GetCountryFromStream ( vecData, iPos );
@@ -1902,16 +1902,15 @@ bool CProtocol::EvaluateCLRegisterServerMes ( const CHostAddress& InetAddr, cons
         return true; // return error code
     }
 
-    if ( sLocHost.isEmpty() )
-    {
-        // old server, empty "topic", register as local host
-        LInetAddr.InetAddr.setAddress ( QHostAddress::LocalHost );
-    }
-    else if ( !LInetAddr.InetAddr.setAddress ( sLocHost ) )
+    QHostAddress LocHostAddr ( QHostAddress::LocalHost ); // old server, empty "topic", register as local host
+
+    if ( !sLocHost.isEmpty() && !LocHostAddr.setAddress ( sLocHost ) )
     {
         return true; // return error code
     }
 
+    LInetAddr.Set ( LocHostAddr, LInetAddr.iPort );
+
     // server city
     if ( GetStringFromStream ( vecData, iPos, MAX_LEN_SERVER_CITY, RecServerInfo.strCity ) )
     {
@@ -1935,7 +1934,7 @@ void CProtocol::CreateCLRegisterServerExMes ( const CHostAddress& InetAddr, cons
     int iPos = 0; // init position pointer
 
     // convert server info strings to utf-8
-    const QByteArray strUTF8LInetAddr = LInetAddr.InetAddr.toString().toUtf8();
+    const QByteArray strUTF8LInetAddr = LInetAddr.GetQHostAddress().toString().toUtf8();
     const QByteArray strUTF8Name      = ServerInfo.strName.toUtf8();
     const QByteArray strUTF8City      = ServerInfo.strCity.toUtf8();
     const QByteArray strUTF8Version   = QString ( APP_VERSION ).toUtf8();
@@ -1999,7 +1998,7 @@ bool CProtocol::EvaluateCLRegisterServerExMes ( const CHostAddress& InetAddr, co
     }
 
     // port number (2 bytes)
-    LInetAddr.iPort = static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) );
+    LInetAddr.SetPort ( static_cast<quint16> ( GetValFromStream ( vecData, iPos, 2 ) ) );
 
     // country (2 bytes)
     RecServerInfo.eCountry = GetCountryFromStream ( vecData, iPos );
@@ -2022,16 +2021,15 @@ bool CProtocol::EvaluateCLRegisterServerExMes ( const CHostAddress& InetAddr, co
         return true; // return error code
     }
 
-    if ( sLocHost.isEmpty() )
-    {
-        // old server, empty "topic", register as local host
-        LInetAddr.InetAddr.setAddress ( QHostAddress::LocalHost );
-    }
-    else if ( !LInetAddr.InetAddr.setAddress ( sLocHost ) )
+    QHostAddress LocHostAddr ( QHostAddress::LocalHost ); // old server, empty "topic", register as local host
+
+    if ( !sLocHost.isEmpty() && !LocHostAddr.setAddress ( sLocHost ) )
     {
         return true; // return error code
     }
 
+    LInetAddr.Set ( LocHostAddr, LInetAddr.iPort );
+
     // server city
     if ( GetStringFromStream ( vecData, iPos, MAX_LEN_SERVER_CITY, RecServerInfo.strCity ) )
     {
@@ -2109,7 +2107,7 @@ void CProtocol::CreateCLServerListMes ( const CHostAddress& InetAddr, const CVec
 
         // IP address (4 bytes)
         // note the Server List manager has put the internal details in HostAddr where required
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.InetAddr.toIPv4Address() ), 4 );
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.GetIPv4() ), 4 );
 
         // port number (2 bytes)
         // note the Server List manager has put the internal details in HostAddr where required
@@ -2187,14 +2185,11 @@ bool CProtocol::EvaluateCLServerListMes ( const CHostAddress& InetAddr, const CV
             return true; // return error code
         }
 
+        CHostAddress HostAddr;
+        HostAddr.SetIPv4 ( iIpAddr, iPort );
+
         // add server information to vector
-        vecServerInfo.Add ( CServerInfo ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
-                                          CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
-                                          strName,
-                                          eCountry,
-                                          strCity,
-                                          iMaxNumClients,
-                                          bPermanentOnline ) );
+        vecServerInfo.Add ( CServerInfo ( HostAddr, HostAddr, strName, eCountry, strCity, iMaxNumClients, bPermanentOnline ) );
     }
 
     // check size: all data is read, the position must now be at the end
@@ -2232,7 +2227,7 @@ void CProtocol::CreateCLRedServerListMes ( const CHostAddress& InetAddr, const C
 
         // IP address (4 bytes)
         // note the Server List manager has put the internal details in HostAddr where required
-        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.InetAddr.toIPv4Address() ), 4 );
+        PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( vecServerInfo[i].HostAddr.GetIPv4() ), 4 );
 
         // port number (2 bytes)
         // note the Server List manager has put the internal details in HostAddr where required
@@ -2272,9 +2267,12 @@ bool CProtocol::EvaluateCLRedServerListMes ( const CHostAddress& InetAddr, const
             return true; // return error code
         }
 
+        CHostAddress HostAddr;
+        HostAddr.SetIPv4 ( iIpAddr, iPort );
+
         // add server information to vector
-        vecServerInfo.Add ( CServerInfo ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
-                                          CHostAddress ( QHostAddress ( iIpAddr ), iPort ),
+        vecServerInfo.Add ( CServerInfo ( HostAddr,
+                                          HostAddr,
                                           strName,
                                           QLocale::AnyCountry, // set to any country since the information is not transmitted
                                           "",                  // empty city name since the information is not transmitted
@@ -2315,7 +2313,7 @@ void CProtocol::CreateCLSendEmptyMesMes ( const CHostAddress& InetAddr, const CH
     CVector<uint8_t> vecData ( 6 );
 
     // IP address (4 bytes)
-    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( TargetInetAddr.InetAddr.toIPv4Address() ), 4 );
+    PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( TargetInetAddr.GetIPv4() ), 4 );
 
     // port number (2 bytes)
     PutValOnStream ( vecData, iPos, static_cast<uint32_t> ( TargetInetAddr.iPort ), 2 );
@@ -2339,8 +2337,11 @@ bool CProtocol::EvaluateCLSendEmptyMesMes ( const CVector<uint8_t>& vecData )
     // port number (2 bytes)
     const quint16 iPort = static_cast<int> ( GetValFromStream ( vecData, iPos, 2 ) );
 
+    CHostAddress TargetInetAddr;
+    TargetInetAddr.SetIPv4 ( iIpAddr, iPort );
+
     // invoke message action
-    emit CLSendEmptyMes ( CHostAddress ( QHostAddress ( iIpAddr ), iPort ) );
+    emit CLSendEmptyMes ( TargetInetAddr );
 
     return false; // no error
 }
@@ -2709,7 +2710,6 @@ bool CProtocol::ParseMessageFrame ( const CVector<uint8_t>& vecbyData,
                                     int&                    iCnt,
                                     int&                    iID )
 {
-    int i;
     int iCurPos;
 
     // vector must be at least "MESS_LEN_WITHOUT_DATA_BYTE" bytes long
@@ -2746,16 +2746,14 @@ bool CProtocol::ParseMessageFrame ( const CVector<uint8_t>& vecbyData,
     }
 
     // Now check CRC -----------------------------------------------------------
+    // the CRC is calculated directly on the received buffer
     CCRC CRCObj;
 
     const int iLenCRCCalc = MESS_HEADER_LENGTH_BYTE + iLenBy;
 
-    iCurPos = 0; // start from the beginning
+    CRCObj.AddBytes ( &vecbyData[0], iLenCRCCalc );
 
-    for ( i = 0; i < iLenCRCCalc; i++ )
-    {
-        CRCObj.AddByte ( static_cast<uint8_t> ( GetValFromStream ( vecbyData, iCurPos, 1 ) ) );
-    }
+    iCurPos = iLenCRCCalc;
 
     if ( CRCObj.GetCRC() != GetValFromStream ( vecbyData, iCurPos, 2 ) )
     {
@@ -2764,18 +2762,13 @@ bool CProtocol::ParseMessageFrame ( const CVector<uint8_t>& vecbyData,
 
     // Extract actual data -----------------------------------------------------
 
-    //### TODO: BEGIN ###//
-    // this memory allocation is done in the real time thread but should be
-    // done in the low priority protocol management thread
+    // this function is called in the real time thread, no memory is allocated
+    // if the capacity of the body vector is large enough (see CSocket)
     vecbyMesBodyData.Init ( iLenBy );
-    //### TODO: END ###//
 
-    iCurPos = MESS_HEADER_LENGTH_BYTE; // start from beginning of data
+    const uint8_t* pbyMesBody = &vecbyData[MESS_HEADER_LENGTH_BYTE];
 
-    for ( i = 0; i < iLenBy; i++ )
-    {
-        vecbyMesBodyData[i] = static_cast<uint8_t> ( GetValFromStream ( vecbyData, iCurPos, 1 ) );
-    }
+    std::copy ( pbyMesBody, pbyMesBody + iLenBy, vecbyMesBodyData.begin() );
 
     return false; // no error
 }
@@ -2894,8 +2887,6 @@ QLocale::Country CProtocol::GetCountryFromStream ( const CVector<uint8_t>& vecIn
 
 void CProtocol::GenMessageFrame ( CVector<uint8_t>& vecOut, const int iCnt, const int iID, const CVector<uint8_t>& vecData )
 {
-    int i;
-
     // query length of data vector
     const int iDataLenByte = vecData.Size();
 
@@ -2921,22 +2912,13 @@ void CProtocol::GenMessageFrame ( CVector<uint8_t>& vecOut, const int iCnt, cons
     PutValOnStream ( vecOut, iCurPos, static_cast<uint32_t> ( iDataLenByte ), 2 );
 
     // encode data -----
-    for ( i = 0; i < iDataLenByte; i++ )
-    {
-        PutValOnStream ( vecOut, iCurPos, static_cast<uint32_t> ( vecData[i] ), 1 );
-    }
+    std::copy ( vecData.begin(), vecData.end(), vecOut.begin() + iCurPos );
+    iCurPos += iDataLenByte;
 
     // Encode CRC --------------------------------------------------------------
     CCRC CRCObj;
 
-    iCurPos = 0; // start from beginning
-
-    const int iLenCRCCalc = MESS_HEADER_LENGTH_BYTE + iDataLenByte;
-
-    for ( i = 0; i < iLenCRCCalc; i++ )
-    {
-        CRCObj.AddByte ( static_cast<uint8_t> ( GetValFromStream ( vecOut, iCurPos, 1 ) ) );
-    }
+    CRCObj.AddBytes ( &vecOut[0], iCurPos );
 
     PutValOnStream ( vecOut, iCurPos, static_cast<uint32_t> ( CRCObj.GetCRC() ), 2 );
 }
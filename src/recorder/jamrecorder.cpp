@@ -267,8 +267,7 @@ void CJamSession::Frame ( const int              iChID,
         vecptrJamClients[iChID] = new CJamClient ( currentFrame, numAudioChannels, name, address, sessionDir );
     }
     else if ( numAudioChannels != vecptrJamClients[iChID]->NumAudioChannels() ||
-              address.InetAddr != vecptrJamClients[iChID]->ClientAddress().InetAddr ||
-              address.iPort != vecptrJamClients[iChID]->ClientAddress().iPort )
+              address != vecptrJamClients[iChID]->ClientAddress() )
     {
         DisconnectClient ( iChID );
         if ( numAudioChannels == 0 )
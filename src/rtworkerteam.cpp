@@ -0,0 +1,230 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "rtworkerteam.h"
+
+#if defined( _WIN32 )
+#    include <windows.h>
+#elif defined( __linux__ )
+#    include <pthread.h>
+#    include <sched.h>
+#endif
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+#    include <immintrin.h>
+#endif
+
+/* Implementation *************************************************************/
+// time a thread spins on the generation counter (or the barrier) before it
+// parks, the number of polls is not usable since the duration of a CPU pause
+// instruction differs a lot between CPUs (e.g. about 140 cycles on Skylake)
+#define RT_WORKER_SPIN_US 30
+
+CRtWorkerTeam::CRtWorkerTeam ( const int iNewNumWorkers, const bool bNPinCores ) :
+    iNumWorkers ( std::max ( iNewNumWorkers, 1 ) ),
+    bCoresArePinned ( bNPinCores ),
+    pTaskFunc ( nullptr ),
+    pArg ( nullptr ),
+    iGeneration ( 0 ),
+    iNumDone ( 0 ),
+    iNumParked ( 0 ),
+    bRunnerParked ( false ),
+    bStop ( false )
+{
+    // the calling thread is worker 0, therefore we need one thread less
+    vecThreads.reserve ( iNumWorkers - 1 );
+
+    for ( int i = 1; i < iNumWorkers; i++ )
+    {
+        vecThreads.emplace_back ( &CRtWorkerTeam::WorkerThread, this, i );
+
+        // worker i is pinned to core i, the calling thread is not pinned
+        // since it is owned by the timer
+        if ( bCoresArePinned )
+        {
+            bCoresArePinned = PinToCore ( vecThreads.back(), i );
+        }
+    }
+}
+
+CRtWorkerTeam::~CRtWorkerTeam()
+{
+    {
+        std::unique_lock<std::mutex> lock ( MutexPark );
+        bStop = true;
+        iGeneration++;
+    }
+    CondPark.notify_all();
+
+    for ( std::thread& Thread : vecThreads )
+    {
+        Thread.join();
+    }
+}
+
+void CRtWorkerTeam::Run ( TTaskFunc pNewTaskFunc, void* pNewArg )
+{
+    if ( iNumWorkers == 1 )
+    {
+        pNewTaskFunc ( pNewArg, 0 );
+        return;
+    }
+
+    pTaskFunc = pNewTaskFunc;
+    pArg      = pNewArg;
+    iNumDone.store ( 0, std::memory_order_relaxed );
+
+    // start the region, spinning workers see the new generation directly,
+    // parked workers must be woken up (note that the sequentially consistent
+    // ordering of the generation increment and the parked counter read makes
+    // sure that a worker which is about to park either sees the new generation
+    // or is seen as parked)
+    iGeneration.fetch_add ( 1 );
+
+    if ( iNumParked.load() > 0 )
+    {
+        std::unique_lock<std::mutex> lock ( MutexPark );
+        CondPark.notify_all();
+    }
+
+    // do our own share of the work
+    pNewTaskFunc ( pNewArg, 0 );
+
+    // barrier: wait for all other workers (see the worker thread for the
+    // ordering of the parked flag and the done counter)
+    const auto SpinEnd = std::chrono::steady_clock::now() + std::chrono::microseconds ( RT_WORKER_SPIN_US );
+
+    while ( iNumDone.load ( std::memory_order_acquire ) < iNumWorkers - 1 )
+    {
+        if ( std::chrono::steady_clock::now() < SpinEnd )
+        {
+            CpuRelax();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock ( MutexDone );
+            bRunnerParked.store ( true );
+            CondDone.wait ( lock, [this] { return iNumDone.load() >= iNumWorkers - 1; } );
+            bRunnerParked.store ( false );
+        }
+    }
+}
+
+void CRtWorkerTeam::WorkerThread ( const int iWorker )
+{
+    unsigned int iLastGeneration = 0;
+
+    for ( ;; )
+    {
+        // spin for a short time, then park until the next region starts
+        const auto SpinEnd = std::chrono::steady_clock::now() + std::chrono::microseconds ( RT_WORKER_SPIN_US );
+
+        while ( iGeneration.load ( std::memory_order_acquire ) == iLastGeneration )
+        {
+            if ( std::chrono::steady_clock::now() < SpinEnd )
+            {
+                CpuRelax();
+            }
+            else
+            {
+                std::unique_lock<std::mutex> lock ( MutexPark );
+                iNumParked++;
+                CondPark.wait ( lock, [this, iLastGeneration] { return iGeneration.load() != iLastGeneration; } );
+                iNumParked--;
+            }
+        }
+
+        iLastGeneration = iGeneration.load ( std::memory_order_acquire );
+
+        if ( bStop )
+        {
+            return;
+        }
+
+        pTaskFunc ( pArg, iWorker );
+
+        // the last worker wakes up a parked caller of Run(), the sequentially
+        // consistent ordering of the done counter increment and the parked flag
+        // read makes sure that the caller either sees the counter or is woken up
+        if ( ( iNumDone.fetch_add ( 1 ) == iNumWorkers - 2 ) && bRunnerParked.load() )
+        {
+            std::unique_lock<std::mutex> lock ( MutexDone );
+            CondDone.notify_one();
+        }
+    }
+}
+
+bool CRtWorkerTeam::PinToCore ( std::thread& Thread, const int iCore )
+{
+    const int iNumCores = static_cast<int> ( std::thread::hardware_concurrency() );
+
+    if ( iNumCores <= 0 )
+    {
+        return false;
+    }
+
+#if defined( _WIN32 )
+    return SetThreadAffinityMask ( Thread.native_handle(), static_cast<DWORD_PTR> ( 1 ) << ( iCore % iNumCores ) ) != 0;
+#elif defined( __linux__ )
+    cpu_set_t CpuSet;
+    CPU_ZERO ( &CpuSet );
+    CPU_SET ( iCore % iNumCores, &CpuSet );
+    return pthread_setaffinity_np ( Thread.native_handle(), sizeof ( cpu_set_t ), &CpuSet ) == 0;
+#else
+    // e.g. macOS does not support pinning threads to cores
+    ( void ) Thread;
+    ( void ) iCore;
+    return false;
+#endif
+}
+
+void CRtWorkerTeam::CpuRelax()
+{
+#if defined( __x86_64__ ) || defined( __i386__ ) || defined( _M_X64 ) || defined( _M_IX86 )
+    _mm_pause();
+#elif ( defined( __aarch64__ ) || defined( __arm__ ) ) && defined( __GNUC__ )
+    __asm__ __volatile__ ( "yield" );
+#endif
+}
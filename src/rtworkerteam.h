@@ -0,0 +1,105 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+/* Classes ********************************************************************/
+// A fixed team of worker threads for the real-time processing. The calling
+// thread is part of the team (worker 0). A parallel region is started with
+// Run() which returns after all workers have finished the task (barrier). No
+// memory is allocated and no future/task objects are created per region. While
+// waiting for the next region (or at the barrier), the threads spin for a short
+// time before they park on a condition variable so that back-to-back regions
+// within one timer tick do not pay for a wakeup.
+class CRtWorkerTeam
+{
+public:
+    typedef void ( *TTaskFunc ) ( void* pArg, const int iWorker );
+
+    CRtWorkerTeam ( const int iNewNumWorkers, const bool bNPinCores );
+    ~CRtWorkerTeam();
+
+    int  GetNumWorkers() const { return iNumWorkers; }
+    bool GetCoresArePinned() const { return bCoresArePinned; }
+
+    // calls pTaskFunc ( pArg, iWorker ) once on each worker, iWorker = 0 is the
+    // calling thread, must only be called from one thread at a time
+    void Run ( TTaskFunc pNewTaskFunc, void* pNewArg );
+
+protected:
+    void        WorkerThread ( const int iWorker );
+    bool        PinToCore ( std::thread& Thread, const int iCore );
+    static void CpuRelax();
+
+    int                      iNumWorkers;
+    bool                     bCoresArePinned;
+    std::vector<std::thread> vecThreads;
+
+    // current task, only written by Run() before the generation is incremented
+    TTaskFunc pTaskFunc;
+    void*     pArg;
+
+    std::atomic<unsigned int> iGeneration;
+    std::atomic<int>          iNumDone;
+    std::atomic<int>          iNumParked;
+    std::atomic<bool>         bRunnerParked;
+    std::atomic<bool>         bStop;
+
+    std::mutex              MutexPark;
+    std::condition_variable CondPark;
+
+    // the thread which called Run() parks here if the barrier takes longer
+    std::mutex              MutexDone;
+    std::condition_variable CondDone;
+};
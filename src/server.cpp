@@ -47,6 +47,51 @@
 #include "server.h"
 #include "util.h"
 
+// CServerFrame implementation *************************************************
+void CServerFrame::Init ( const int iMaxNumChannels )
+{
+    iNumClients = 0;
+
+    vecChanIDsCurConChan.Init ( iMaxNumChannels );
+    vecvecfGains.Init ( iMaxNumChannels );
+    vecvecfPannings.Init ( iMaxNumChannels );
+    vecvecfGainsL.Init ( iMaxNumChannels );
+    vecvecfGainsR.Init ( iMaxNumChannels );
+    vecvecsData.Init ( iMaxNumChannels );
+    vecNumAudioChannels.Init ( iMaxNumChannels );
+    vecNumFrameSizeConvBlocks.Init ( iMaxNumChannels );
+    vecUseDoubleSysFraSizeConvBuf.Init ( iMaxNumChannels );
+    vecAudioComprType.Init ( iMaxNumChannels );
+    vecCeltNumCodedBytes.Init ( iMaxNumChannels );
+    vecvecbyCodedData.Init ( iMaxNumChannels );
+    vecNumMixMinusCorr.Init ( iMaxNumChannels, INVALID_INDEX );
+    vecfMixMinusBusMono.Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
+    vecfMixMinusBusStereo.Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
+    vecMixRowHash.Init ( iMaxNumChannels );
+    vecMixGroupLeader.Init ( iMaxNumChannels );
+    vecMixGroupNext.Init ( iMaxNumChannels, INVALID_INDEX );
+    vecMixGroupLast.Init ( iMaxNumChannels );
+
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        // each listener creates its own mix if encode-once is not used
+        vecMixGroupLeader[i] = i;
+        vecMixGroupLast[i]   = i;
+
+        // init vectors storing information of all channels
+        vecvecfGains[i].Init ( iMaxNumChannels );
+        vecvecfPannings[i].Init ( iMaxNumChannels );
+        vecvecfGainsL[i].Init ( iMaxNumChannels );
+        vecvecfGainsR[i].Init ( iMaxNumChannels );
+
+        // we always use stereo audio buffers (which is the worst case)
+        vecvecsData[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
+
+        // allocate worst case memory for the coded data
+        vecvecbyCodedData[i].Init ( MAX_SIZE_BYTES_NETW_BUF );
+    }
+}
+
 // CServer implementation ******************************************************
 CServer::CServer ( const int          iNewMaxNumChan,
                    const QString&     strLoggingFileName,
@@ -67,18 +112,44 @@ CServer::CServer ( const int          iNewMaxNumChan,
                    const bool         bNUseMultithreading,
                    const bool         bDisableRecording,
                    const bool         bNDelayPan,
+                   const bool         bNUseMixMinus,
+                   const bool         bNUseEncodeOnce,
+                   const bool         bNPinCores,
+                   const bool         bNUsePipeline,
+                   const bool         bNDecodeOnArrival,
+                   const int          iNNumRecvSockets,
+                   const bool         bNUseRtThread,
+                   const bool         bNUseOverloadControl,
+                   const int          iNAdmissionTargetPercent,
                    const bool         bNDisableIPv6,
                    const ELicenceType eNLicenceType ) :
     bUseDoubleSystemFrameSize ( bNUseDoubleSystemFrameSize ),
     bUseMultithreading ( bNUseMultithreading ),
+    bPinCores ( bNPinCores ),
     iMaxNumChannels ( iNewMaxNumChan ),
-    iCurNumChannels ( 0 ),
     bDisableRaw ( bNDisableRaw ),
+    iDecFrame ( 0 ),
+    iMixFrame ( 0 ),
+    bUsePipeline ( bNUsePipeline ),
+    bDecodeOnArrival ( bNDecodeOnArrival ),
+    MixKernels ( CMixKernels::Get() ),
+    bUseMixMinus ( bNUseMixMinus ),
+    bUseEncodeOnce ( bNUseEncodeOnce ),
+    iNumEncodesSaved ( 0 ),
     bIPv6Available ( false ),
-    Socket ( this, iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bNDisableIPv6, bIPv6Available ),
+    Socket ( this, iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bNDisableIPv6, bIPv6Available, iNNumRecvSockets ),
     Logging(),
     iFrameCount ( 0 ),
-    HighPrecisionTimer ( bNUseDoubleSystemFrameSize ),
+    HighPrecisionTimer ( bNUseDoubleSystemFrameSize, bNUseRtThread ),
+    bStopRequested ( false ),
+    bDisconnectEventPending ( false ),
+    iNextTickNs ( 0 ),
+    bUseOverloadControl ( bNUseOverloadControl ),
+    iOpus64DefaultComplexity ( 0 ),
+    iSilentInputFrames ( 0 ),
+    iAdmissionTargetPercent ( iNAdmissionTargetPercent ),
+    iNumAdmissionsRefused ( 0 ),
+    iNumAdmittedSinceTick ( 0 ),
     ServerListManager ( this,
                         iPortNumber,
                         strDirectoryAddress,
@@ -139,6 +210,10 @@ CServer::CServer ( const int          iNewMaxNumChan,
         opus_custom_encoder_ctl ( OpusEncoderMono[i], OPUS_SET_COMPLEXITY ( 1 ) );
         opus_custom_encoder_ctl ( OpusEncoderStereo[i], OPUS_SET_COMPLEXITY ( 1 ) );
 
+        veciChanSilentFrames[i]     = 0;
+        veciChanAdmissionNs[i]      = 0;
+        vecbEncoderLowComplexity[i] = false;
+
         // init double-to-normal frame size conversion buffers -----------------
         // use worst case memory initialization to avoid allocating memory in
         // the time-critical thread
@@ -146,6 +221,9 @@ CServer::CServer ( const int          iNewMaxNumChan,
         DoubleFrameSizeConvBufOut[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
     }
 
+    // the overload control restores the default complexity of the OPUS64 encoders
+    opus_custom_encoder_ctl ( Opus64EncoderMono[0], OPUS_GET_COMPLEXITY ( &iOpus64DefaultComplexity ) );
+
     // define colors for chat window identifiers
     vstrChatColors.Init ( 6 );
     vstrChatColors[0] = "mediumblue";
@@ -165,33 +243,23 @@ CServer::CServer ( const int          iNewMaxNumChan,
         iServerFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
     }
 
+    qInfo() << qUtf8Printable ( QString ( "- using %1 audio mix kernels" ).arg ( MixKernels.strName ) );
+
     // To avoid audio clitches, in the entire realtime timer audio processing
     // routine including the ProcessData no memory must be allocated. Since we
     // do not know the required sizes for the vectors, we allocate memory for
     // the worst case here:
 
     // allocate worst case memory for the temporary vectors
-    vecChanIDsCurConChan.Init ( iMaxNumChannels );
-    vecvecfGains.Init ( iMaxNumChannels );
-    vecvecfPannings.Init ( iMaxNumChannels );
-    vecvecsData.Init ( iMaxNumChannels );
+    Frames[0].Init ( iMaxNumChannels );
+    Frames[1].Init ( iMaxNumChannels );
     vecvecsData2.Init ( iMaxNumChannels );
     vecvecsSendData.Init ( iMaxNumChannels );
     vecvecfIntermediateProcBuf.Init ( iMaxNumChannels );
-    vecvecbyCodedData.Init ( iMaxNumChannels );
-    vecNumAudioChannels.Init ( iMaxNumChannels );
-    vecNumFrameSizeConvBlocks.Init ( iMaxNumChannels );
-    vecUseDoubleSysFraSizeConvBuf.Init ( iMaxNumChannels );
-    vecAudioComprType.Init ( iMaxNumChannels );
 
     for ( i = 0; i < iMaxNumChannels; i++ )
     {
-        // init vectors storing information of all channels
-        vecvecfGains[i].Init ( iMaxNumChannels );
-        vecvecfPannings[i].Init ( iMaxNumChannels );
-
         // we always use stereo audio buffers (which is the worst case)
-        vecvecsData[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
         vecvecsData2[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
 
         // (note that we only allocate iMaxNumChannels buffers for the send
@@ -200,9 +268,6 @@ CServer::CServer ( const int          iNewMaxNumChan,
 
         // allocate worst case memory for intermediate processing buffers in float precision
         vecvecfIntermediateProcBuf[i].Init ( 2 /* stereo */ * DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES /* worst case buffer size */ );
-
-        // allocate worst case memory for the coded data
-        vecvecbyCodedData[i].Init ( MAX_SIZE_BYTES_NETW_BUF );
     }
 
     // allocate worst case memory for the channel levels
@@ -238,13 +303,25 @@ CServer::CServer ( const int          iNewMaxNumChan,
     // entire life time of the software)
     for ( i = 0; i < iMaxNumChannels; i++ )
     {
+        vecChannels[i].SetDecodeOnArrival ( bDecodeOnArrival );
         vecChannels[i].SetEnable ( true );
-        vecChannelOrder[i] = i;
+    }
+
+    ChannelTable.Init ( iMaxNumChannels );
+
+    for ( i = 0; i < MAX_NUM_CHANNELS; i++ )
+    {
+        vecbDisconnectPending[i]   = false;
+        vecbConvBufResetPending[i] = false;
+        veciChanArrivalDecodeNs[i] = 0;
+        vecfChanDecodeCostUs[i]    = 0;
+        vecfChanMixCostUs[i]       = 0;
+        vecfChanEncodeCostUs[i]    = 0;
     }
 
     int iAvailableCores = QThread::idealThreadCount();
 
-    // setup CThreadPool if multithreading is active and possible
+    // setup the real-time worker team if multithreading is active and possible
     if ( bUseMultithreading )
     {
         if ( iAvailableCores == 1 )
@@ -254,18 +331,101 @@ CServer::CServer ( const int          iNewMaxNumChan,
         }
         else
         {
-            // set maximum thread count to available cores; other threads will share at random
-            iMaxNumThreads = iAvailableCores;
-            qDebug() << "multithreading enabled, setting thread count to" << iMaxNumThreads;
+            // one worker per available core, note that the timer thread is one of the workers
+            qDebug() << "multithreading enabled, setting thread count to" << iAvailableCores;
+
+            pWorkerTeam = std::unique_ptr<CRtWorkerTeam> ( new CRtWorkerTeam ( iAvailableCores, bPinCores ) );
+
+            if ( bPinCores )
+            {
+                if ( pWorkerTeam->GetCoresArePinned() )
+                {
+                    qInfo() << "- multithreading workers are pinned to CPU cores";
+                }
+                else
+                {
+                    qWarning() << "- pinning multithreading workers to CPU cores is not supported";
+                }
+            }
+
+            // allocate the per worker channel lists for the worst case
+            vecChanIDWorker.Init ( MAX_NUM_CHANNELS, INVALID_INDEX );
+            vecfWorkerLoadUs.Init ( iAvailableCores );
+            vecfChanCostUs.Init ( MAX_NUM_CHANNELS );
+            vecfChanTickCostUs.Init ( MAX_NUM_CHANNELS );
+            vecfChanMixTickCostUs.Init ( MAX_NUM_CHANNELS );
+            vecNewChanCnts.Init ( iMaxNumChannels );
+
+            for ( CServerFrame& Frame : Frames )
+            {
+                Frame.vecWorkerNumChans.Init ( iAvailableCores );
+                Frame.vecvecWorkerChanCnts.Init ( iAvailableCores );
+
+                for ( i = 0; i < iAvailableCores; i++ )
+                {
+                    Frame.vecvecWorkerChanCnts[i].Init ( iMaxNumChannels );
+                }
+            }
+        }
+    }
+
+    // one batch of audio packets per worker, the worst case is that a worker
+    // sends two packets per tick to all channels (two conversion blocks)
+    vecSendBatches.Init ( bUseMultithreading ? pWorkerTeam->GetNumWorkers() : 1 );
+
+    for ( CSocketSendBatch& SendBatch : vecSendBatches )
+    {
+        SendBatch.Init ( 2 * iMaxNumChannels );
+    }
+
+    // the deadline of a tick is the frame duration (same rounding as in the timer)
+    TickProfiler.Init ( vecSendBatches.Size(), static_cast<int64_t> ( iServerFrameSizeSamples ) * 1000000000 / SYSTEM_SAMPLE_RATE_HZ );
+
+    // the admission control only needs the tick utilisation of the overload controller
+    OverloadController.Init ( TickProfiler.GetDeadlineNs(), bUseOverloadControl );
+
+    AdmissionPrediction = CAdmissionPrediction();
+
+    for ( i = 0; i < ADMISSION_REFUSAL_CACHE_SIZE; i++ )
+    {
+        veciRefusedNs[i] = 0;
+    }
+
+    if ( bUseOverloadControl )
+    {
+        iSilentInputFrames = OVERLOAD_SILENT_INPUT_MS * SYSTEM_SAMPLE_RATE_HZ / 1000 / iServerFrameSizeSamples;
+
+        qInfo() << "- overload control: the audio quality is reduced step by step if the server gets close to its CPU limit";
+    }
 
-            pThreadPool = std::unique_ptr<CThreadPool> ( new CThreadPool{ static_cast<size_t> ( iMaxNumThreads ) } );
-            Futures.reserve ( iMaxNumThreads );
+    // pipelining needs at least a second worker which decodes while the mix is created
+    if ( bUsePipeline )
+    {
+        if ( bUseMultithreading )
+        {
+            qInfo() << qUtf8Printable ( QString ( "- pipelined processing adds %1 ms of server latency" ).arg ( GetPipelineLatencyMs(), 0, 'f', 2 ) );
+        }
+        else
+        {
+            qWarning() << "- pipelined processing needs multithreading on a multi-core CPU, pipelining is disabled";
+            bUsePipeline = false;
         }
     }
 
+    // the real-time mode needs a timer thread (not available on Windows)
+    if ( bNUseRtThread && !HighPrecisionTimer.IsRealTime() )
+    {
+        qWarning() << "- the real-time thread is not supported on this platform, the tick runs in the main thread";
+    }
+
     // Connections -------------------------------------------------------------
-    // connect timer timeout signal
-    QObject::connect ( &HighPrecisionTimer, &CHighPrecisionTimer::timeout, this, &CServer::OnTimer );
+    // connect timer timeout signal, in real-time mode the tick runs directly in
+    // the timer thread instead of the main event loop
+    QObject::connect ( &HighPrecisionTimer,
+                       &CHighPrecisionTimer::timeout,
+                       this,
+                       &CServer::OnTimer,
+                       HighPrecisionTimer.IsRealTime() ? Qt::DirectConnection : Qt::AutoConnection );
 
     QObject::connect ( &ConnLessProtocol, &CProtocol::CLMessReadyForSending, this, &CServer::OnSendCLProtMessage );
 
@@ -396,7 +556,7 @@ void CServer::SendProtMessage ( int iChID, CVector<uint8_t> vecMessage )
 
 void CServer::OnNewConnection ( int iChID, int iTotChans, CHostAddress RecHostAddr )
 {
-    QMutexLocker locker ( &Mutex );
+    QMutexLocker locker ( &MutexControl );
 
     // inform the client about its own ID at the server (note that this
     // must be the first message to be sent for a new connection)
@@ -470,14 +630,13 @@ void CServer::OnNewConnection ( int iChID, int iTotChans, CHostAddress RecHostAd
     // send recording state message on connection
     vecChannels[iChID].CreateRecorderStateMes ( JamController.GetRecorderState() );
 
-    // reset the conversion buffers
-    DoubleFrameSizeConvBufIn[iChID].Reset();
-    DoubleFrameSizeConvBufOut[iChID].Reset();
+    // reset the conversion buffers (done by the tick which uses them without a lock)
+    vecbConvBufResetPending[iChID] = true;
 
     // logging of new connected channel
-    Logging.AddNewConnection ( RecHostAddr.InetAddr, iTotChans );
+    Logging.AddNewConnection ( RecHostAddr.GetQHostAddress(), iTotChans );
 
-    emit ClientConnected ( iChID, RecHostAddr.InetAddr, iTotChans );
+    emit ClientConnected ( iChID, RecHostAddr.GetQHostAddress(), iTotChans );
 }
 
 void CServer::OnCLReqServerFeatures ( CHostAddress RecHostAddr )
@@ -567,12 +726,45 @@ void CServer::OnCLDisconnection ( CHostAddress InetAddr )
     }
 }
 
+void CServer::OnChannelsDisconnected()
+{
+    // channels which are disconnected after this point post a new event
+    bDisconnectEventPending = false;
+
+    CVector<int> veciDisconnectedChanIDs;
+
+    {
+        QMutexLocker locker ( &MutexControl );
+
+        for ( int i = 0; i < iMaxNumChannels; i++ )
+        {
+            if ( vecbDisconnectPending[i].exchange ( false ) )
+            {
+                FreeChannel ( i ); // note that the channel is now not in use
+                veciDisconnectedChanIDs.Add ( i );
+            }
+        }
+
+        // update channel list for all currently connected clients
+        if ( veciDisconnectedChanIDs.Size() > 0 )
+        {
+            CreateAndSendChanListForAllConChannels();
+        }
+    }
+
+    // the signals are emitted outside the lock
+    for ( int i = 0; i < veciDisconnectedChanIDs.Size(); i++ )
+    {
+        emit ClientDisconnected ( veciDisconnectedChanIDs[i] );
+    }
+}
+
 void CServer::OnAboutToQuit()
 {
     // if enabled, disconnect all clients on quit
     if ( bDisconnectAllClientsOnQuit )
     {
-        QMutexLocker locker ( &Mutex );
+        QMutexLocker locker ( &MutexControl );
         for ( int i = 0; i < iMaxNumChannels; i++ )
         {
             if ( vecChannels[i].IsConnected() )
@@ -622,6 +814,9 @@ void CServer::Start()
     // only start if not already running
     if ( !IsRunning() )
     {
+        // the ideal tick times start with the first tick
+        iNextTickNs = 0;
+
         // start timer
         HighPrecisionTimer.Start();
 
@@ -644,6 +839,36 @@ void CServer::Stop()
         // logging (add "server stopped" logging entry)
         Logging.AddServerStopped();
 
+        // receive statistics (since the start of the server process)
+        qInfo() << qUtf8Printable ( QString ( "- average receive batch size: %1 packets" ).arg ( GetAvgRecvBatchSize(), 0, 'f', 1 ) );
+
+        int     iProtMessQueueMaxUsed;
+        int64_t iProtMessDropped;
+
+        GetProtMessageQueueStats ( iProtMessQueueMaxUsed, iProtMessDropped );
+
+        qInfo() << qUtf8Printable ( QString ( "- protocol message buffers: at most %1 of %2 in use, %3 messages dropped" )
+                                        .arg ( iProtMessQueueMaxUsed )
+                                        .arg ( PROT_MESS_QUEUE_SIZE )
+                                        .arg ( static_cast<qint64> ( iProtMessDropped ) ) );
+
+#ifndef _WIN32
+        // the timer wakeup lateness is only measured by the timer thread
+        double dTimerJitterAvgUs;
+        double dTimerJitterMaxUs;
+
+        GetTimerWakeUpJitter ( dTimerJitterAvgUs, dTimerJitterMaxUs );
+
+        qInfo() << qUtf8Printable ( QString ( "- timer wakeup lateness: %1 us on average, %2 us at most" )
+                                        .arg ( dTimerJitterAvgUs, 0, 'f', 1 )
+                                        .arg ( dTimerJitterMaxUs, 0, 'f', 1 ) );
+#endif
+
+        if ( iAdmissionTargetPercent > 0 )
+        {
+            qInfo() << qUtf8Printable ( QString ( "- admission control: %1 new clients refused" ).arg ( GetNumAdmissionsRefused() ) );
+        }
+
         // emit stopped signal
         emit Stopped();
     }
@@ -651,79 +876,112 @@ void CServer::Stop()
 
 void CServer::OnTimer()
 {
-    //### TEST: BEGIN ###//
-    // uncomment next line to do a timer Jitter measurement
-    // static CTimingMeas JitterMeas ( 1000, "test2.dat" ); JitterMeas.Measure();
-    //### TEST: END ###//
+    const int64_t iTickStartNs = CTickProfiler::Now();
+
+    // wakeup lateness compared to the ideal tick time (the timer catches up
+    // if it is late), the ideal tick times restart after a server start or a
+    // very large lateness
+    if ( ( iNextTickNs == 0 ) || ( iTickStartNs - iNextTickNs > PERF_MAX_WAKEUP_LATENESS_NS ) )
+    {
+        iNextTickNs = iTickStartNs;
+    }
+    else
+    {
+        TickProfiler.AddDuration ( 0, PP_WAKEUP_LATENESS, std::max ( iTickStartNs - iNextTickNs, static_cast<int64_t> ( 0 ) ) );
+    }
+
+    iNextTickNs += TickProfiler.GetDeadlineNs();
+
+    ProcessTick();
+}
+
+void CServer::ProcessTick()
+{
+    const int64_t iTickStartNs = CTickProfiler::Now();
+
+    // With pipelining, the decoded data of this tick is only mixed in the next
+    // tick, together with the decoding of the next frame. Otherwise both frame
+    // indices point to the same frame.
+    CServerFrame& DecFrame = Frames[iDecFrame];
+    CServerFrame& MixFrame = Frames[iMixFrame];
 
     // Get data from all connected clients -------------------------------------
     // some inits
     int  iNumClients          = 0; // init connected client counter
     bool bUseMT               = false;
-    int  iNumBlocks           = 0;     // init number of blocks for multithreading
-    int  iMTBlockSize         = 0;     // init block size for multithreading
-    bChannelIsNowDisconnected = false; // note that the flag must be a member function since QtConcurrent::run can only take 5 params
+    bChannelIsNowDisconnected = false; // note that the flag must be a member since the workers must be able to set it
 
-    {
-        // Make put and get calls thread safe.
-        QMutexLocker locker ( &Mutex );
+    // The tick does not take a server wide lock: the connection state, the audio
+    // properties and the mix row snapshots of the channels have their own
+    // synchronisation, the control plane uses MutexControl only.
 
-        // first, get number and IDs of connected channels
-        for ( int i = 0; i < iMaxNumChannels; i++ )
+    // first, get number and IDs of connected channels
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        if ( vecChannels[i].IsConnected() )
         {
-            if ( vecChannels[i].IsConnected() )
-            {
-                // add ID and increment counter (note that the vector length is
-                // according to the worst case scenario, if the number of
-                // connected clients is less, only a subset of elements of this
-                // vector are actually used and the others are dummy elements)
-                vecChanIDsCurConChan[iNumClients] = i;
-                iNumClients++;
-            }
+            // add ID and increment counter (note that the vector length is
+            // according to the worst case scenario, if the number of
+            // connected clients is less, only a subset of elements of this
+            // vector are actually used and the others are dummy elements)
+            DecFrame.vecChanIDsCurConChan[iNumClients] = i;
+            iNumClients++;
         }
-
-        // use multithreading for any non-zero number of clients
-        // (overhead is low and it is worth doing for all numbers)
-        bUseMT = bUseMultithreading && iNumClients > 0;
-
-        // prepare and decode connected channels
-        if ( !bUseMT )
+        else if ( bUseMultithreading )
         {
-            // run the OPUS decoder for all data blocks
-            DecodeReceiveDataBlocks ( this, 0, iNumClients - 1, iNumClients );
+            // a new connection on this channel gets a new worker assignment
+            vecChanIDWorker[i] = INVALID_INDEX;
         }
-        else
-        {
-            // spread work equally among available threads
-            iNumBlocks   = std::min ( iNumClients, iMaxNumThreads );
-            iMTBlockSize = ( iNumClients - 1 ) / iNumBlocks + 1;
+    }
 
-            // processing with multithreading
-            for ( int iBlockCnt = 0; iBlockCnt < iNumBlocks; iBlockCnt++ )
-            {
-                // The work for OPUS decoding is distributed over all available processor cores.
-                // By using the future synchronizer we make sure that all
-                // threads are done when we leave the timer callback function.
-                const int iStartChanCnt = iBlockCnt * iMTBlockSize;
-                const int iStopChanCnt  = std::min ( ( iBlockCnt + 1 ) * iMTBlockSize - 1, iNumClients - 1 );
+    DecFrame.iNumClients    = iNumClients;
+    DecFrame.eOverloadLevel = OverloadController.GetLevel();
 
-                Futures.push_back ( pThreadPool->enqueue ( CServer::DecodeReceiveDataBlocks, this, iStartChanCnt, iStopChanCnt, iNumClients ) );
-            }
+    // use multithreading for any non-zero number of clients
+    // (overhead is low and it is worth doing for all numbers), with
+    // pipelining the previous frame may still have to be mixed
+    bUseMT = bUseMultithreading && ( ( iNumClients > 0 ) || ( bUsePipeline && ( MixFrame.iNumClients > 0 ) ) );
 
-            // make sure all concurrent run threads have finished when we leave this function
-            for ( auto& future : Futures )
-            {
-                future.wait();
-            }
-            Futures.clear();
+    // prepare and decode connected channels
+    if ( !bUseMT )
+    {
+        const int64_t iDecodeStartNs = CTickProfiler::Now();
+
+        // run the OPUS decoder for all channels
+        for ( int iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+        {
+            DecodeReceiveData ( iChanCnt, iNumClients );
         }
 
-        // a channel is now disconnected, take action on it
-        if ( bChannelIsNowDisconnected )
+        if ( iNumClients > 0 )
         {
-            // update channel list for all currently connected clients
-            CreateAndSendChanListForAllConChannels();
+            TickProfiler.AddDuration ( 0, PP_DECODE, CTickProfiler::Now() - iDecodeStartNs );
+        }
+    }
+    else
+    {
+        // The work for OPUS decoding is distributed over all workers. Run()
+        // only returns after all workers are done.
+        AssignChannelsToWorkers ( iNumClients );
+
+        if ( bUsePipeline )
+        {
+            // each worker mixes, encodes and transmits the previous frame
+            // and then decodes the current frame
+            pWorkerTeam->Run ( CServer::PipelineWorker, this );
         }
+        else
+        {
+            pWorkerTeam->Run ( CServer::DecodeReceiveDataWorker, this );
+        }
+    }
+
+    // a channel is now disconnected, the channel is freed and the channel list
+    // is sent to all other clients outside the tick (only one event is
+    // posted until the main thread has processed it)
+    if ( bChannelIsNowDisconnected && !bDisconnectEventPending.exchange ( true ) )
+    {
+        QCoreApplication::postEvent ( this, new CCustomEvent ( MS_CHAN_DISCONNECTED, 0, 0 ) );
     }
 
     // Process data ------------------------------------------------------------
@@ -731,13 +989,30 @@ void CServer::OnTimer()
     // one client is connected.
     if ( iNumClients > 0 )
     {
+        const int64_t iLevelsStartNs = CTickProfiler::Now();
+
         // calculate levels for all connected clients
         const bool bSendChannelLevels = CreateLevelsForAllConChannels ( iNumClients );
 
+        // find listeners which get identical mixes (with overload control,
+        // the mixes may be shared only at some levels)
+        if ( bUseEncodeOnce || bUseOverloadControl )
+        {
+            GroupIdenticalMixes ( iNumClients );
+        }
+
+        // the shared mix-minus bus must be ready before any mix is generated
+        if ( bUseMixMinus )
+        {
+            CreateMixMinusBus ( iNumClients );
+        }
+
+        TickProfiler.AddDuration ( 0, PP_LEVELS, CTickProfiler::Now() - iLevelsStartNs );
+
         for ( int iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
         {
             // get actual ID of current channel
-            const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
+            const int iCurChanID = DecFrame.vecChanIDsCurConChan[iChanCnt];
 
             // update socket buffer size
             vecChannels[iCurChanID].UpdateSocketBufferSize();
@@ -754,8 +1029,8 @@ void CServer::OnTimer()
                 emit AudioFrame ( iCurChanID,
                                   vecChannels[iCurChanID].GetName(),
                                   vecChannels[iCurChanID].GetAddress(),
-                                  vecNumAudioChannels[iChanCnt],
-                                  vecvecsData[iChanCnt] );
+                                  DecFrame.vecNumAudioChannels[iChanCnt],
+                                  DecFrame.vecvecsData[iChanCnt] );
             }
 
             // processing without multithreading
@@ -763,186 +1038,464 @@ void CServer::OnTimer()
             {
                 // generate a separate mix for each channel, OPUS encode the
                 // audio data and transmit the network packet
-                MixEncodeTransmitData ( iChanCnt, iNumClients );
+                MixEncodeTransmitData ( iChanCnt, iNumClients, 0 );
             }
         }
 
-        // processing with multithreading
-        if ( bUseMT )
+        // send all audio packets of this frame
+        if ( !bUseMT )
         {
-            for ( int iBlockCnt = 0; iBlockCnt < iNumBlocks; iBlockCnt++ )
-            {
-                // Generate a separate mix for each channel, OPUS encode the
-                // audio data and transmit the network packet. The work is
-                // distributed over all available processor cores.
-                // By using the future synchronizer we make sure that all
-                // threads are done when we leave the timer callback function.
-                const int iStartChanCnt = iBlockCnt * iMTBlockSize;
-                const int iStopChanCnt  = std::min ( ( iBlockCnt + 1 ) * iMTBlockSize - 1, iNumClients - 1 );
-
-                Futures.push_back ( pThreadPool->enqueue ( CServer::MixEncodeTransmitDataBlocks, this, iStartChanCnt, iStopChanCnt, iNumClients ) );
-            }
+            const int64_t iSendStartNs = CTickProfiler::Now();
 
-            // make sure all concurrent run threads have finished when we leave this function
-            for ( auto& fFuture : Futures )
-            {
-                fFuture.wait();
-            }
-            Futures.clear();
+            Socket.SendBatch ( vecSendBatches[0] );
+
+            TickProfiler.AddDuration ( 0, PP_SEND, CTickProfiler::Now() - iSendStartNs );
         }
-        if ( bDelayPan )
+
+        // processing with multithreading (with pipelining, the mix of this
+        // frame is created in the next tick)
+        if ( bUseMT && !bUsePipeline )
         {
-            for ( int i = 0; i < iNumClients; i++ )
-            {
-                for ( int j = 0; j < 2 * ( iServerFrameSizeSamples ); j++ )
-                {
-                    vecvecsData2[i][j] = vecvecsData[i][j];
-                }
-            }
+            // Generate a separate mix for each channel, OPUS encode the
+            // audio data and transmit the network packet. The work is
+            // distributed over all workers with the same channel assignment
+            // as for the decoding. Run() only returns after all workers are done.
+            pWorkerTeam->Run ( CServer::MixEncodeTransmitDataWorker, this );
         }
     }
     else
     {
         // Disable server if no clients are connected. In this case the server
         // does not consume any significant CPU when no client is connected.
-        Stop();
+        if ( HighPrecisionTimer.IsRealTime() )
+        {
+            // the timer thread cannot stop itself, this is done by the main thread
+            if ( !bStopRequested.exchange ( true ) )
+            {
+                QCoreApplication::postEvent ( this, new CCustomEvent ( MS_NO_CLIENTS, 0, 0 ) );
+            }
+        }
+        else
+        {
+            Stop();
+        }
     }
-}
 
-// This is a static method used as a callback, and does not inherit a "this" pointer,
-// so it is necessary for the server instance to be passed as a parameter.
-void CServer::DecodeReceiveDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients )
-{
-    // loop over all channels in the current block, needed for multithreading support
-    for ( int iChanCnt = iStartChanCnt; iChanCnt <= iStopChanCnt; iChanCnt++ )
+    // store the data of the frame which was mixed in this tick for the delayed panning
+    if ( bDelayPan )
     {
-        pServer->DecodeReceiveData ( iChanCnt, iNumClients );
+        for ( int i = 0; i < MixFrame.iNumClients; i++ )
+        {
+            for ( int j = 0; j < 2 * ( iServerFrameSizeSamples ); j++ )
+            {
+                vecvecsData2[i][j] = MixFrame.vecvecsData[i][j];
+            }
+        }
     }
-}
 
-// This is a static method used as a callback, and does not inherit a "this" pointer,
-// so it is necessary for the server instance to be passed as a parameter.
-void CServer::MixEncodeTransmitDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients )
-{
-    // loop over all channels in the current block, needed for multithreading support
-    for ( int iChanCnt = iStartChanCnt; iChanCnt <= iStopChanCnt; iChanCnt++ )
+    // the frame decoded in this tick is mixed in the next tick
+    if ( bUsePipeline )
     {
-        pServer->MixEncodeTransmitData ( iChanCnt, iNumClients );
+        iMixFrame = iDecFrame;
+        iDecFrame = 1 - iDecFrame;
     }
-}
-
-void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
-{
-    int                iUnused;
-    int                iClientFrameSizeSamples = 0; // initialize to avoid a compiler warning
-    OpusCustomDecoder* CurOpusDecoder;
-    unsigned char*     pCurCodedData;
-
-    // get actual ID of current channel
-    const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
-
-    // get and store number of audio channels and compression type
-    vecNumAudioChannels[iChanCnt] = vecChannels[iCurChanID].GetNumAudioChannels();
-    vecAudioComprType[iChanCnt]   = vecChannels[iCurChanID].GetAudioCompressionType();
-
-    // get info about required frame size conversion properties
-    vecUseDoubleSysFraSizeConvBuf[iChanCnt] = ( !bUseDoubleSystemFrameSize && ( vecAudioComprType[iChanCnt] == CT_OPUS ) );
 
-    if ( bUseDoubleSystemFrameSize && ( vecAudioComprType[iChanCnt] == CT_OPUS64 ) )
-    {
-        vecNumFrameSizeConvBlocks[iChanCnt] = 2;
-    }
-    else
-    {
-        vecNumFrameSizeConvBlocks[iChanCnt] = 1;
-    }
+    // all workers are done at this point
+    const int64_t iTickDurationNs = CTickProfiler::Now() - iTickStartNs;
 
-    // update conversion buffer size (nothing will happen if the size stays the same)
-    if ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] )
-    {
-        DoubleFrameSizeConvBufIn[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
-        DoubleFrameSizeConvBufOut[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
-    }
+    TickProfiler.FinishTick ( iTickDurationNs );
 
-    // select the opus decoder and raw audio frame length
-    if ( vecAudioComprType[iChanCnt] == CT_OPUS )
+    if ( bUseOverloadControl || ( iAdmissionTargetPercent > 0 ) )
     {
-        iClientFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+        const EOverloadLevel eOldLevel = OverloadController.GetLevel();
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
+        // the server stops if no client is connected, it starts again without degradation
+        if ( iNumClients > 0 )
         {
-            CurOpusDecoder = OpusDecoderMono[iCurChanID];
+            OverloadController.Update ( iTickDurationNs );
         }
         else
         {
-            CurOpusDecoder = OpusDecoderStereo[iCurChanID];
+            OverloadController.Reset();
         }
-    }
-    else if ( vecAudioComprType[iChanCnt] == CT_OPUS64 )
-    {
-        iClientFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
+        if ( OverloadController.GetLevel() != eOldLevel )
         {
-            CurOpusDecoder = Opus64DecoderMono[iCurChanID];
-        }
-        else
-        {
-            CurOpusDecoder = Opus64DecoderStereo[iCurChanID];
+            ApplyOverloadLevel ( OverloadController.GetLevel() );
         }
     }
-    else
+
+    // the admission control reads the prediction if an unknown address sends audio
+    if ( iAdmissionTargetPercent > 0 )
     {
-        CurOpusDecoder = nullptr;
+        UpdateAdmissionPrediction ( DecFrame, iNumClients );
     }
+}
 
-    // get gains of all connected channels
-    for ( int j = 0; j < iNumClients; j++ )
-    {
-        // The second index of "vecvecdGains" does not represent
-        // the channel ID! Therefore we have to use
-        // "vecChanIDsCurConChan" to query the IDs of the currently
-        // connected channels
-        vecvecfGains[iChanCnt][j] = vecChannels[iCurChanID].GetGain ( vecChanIDsCurConChan[j] );
+void CServer::ApplyOverloadLevel ( const EOverloadLevel eNewLevel )
+{
+    // all levels are applied by the next frame which is decoded (see
+    // CServerFrame::eOverloadLevel), the encoder complexity of a channel is
+    // changed before its next encoding (see MixEncodeTransmitData); the change
+    // is announced by the main thread
+    QCoreApplication::postEvent ( this, new CCustomEvent ( MS_OVERLOAD_LEVEL_CHANGED, eNewLevel, 0 ) );
+}
 
-        // consider audio fade-in
-        vecvecfGains[iChanCnt][j] *= vecChannels[vecChanIDsCurConChan[j]].GetFadeInGain();
+void CServer::SetEncoderComplexity ( const int iChanID, const bool bLowComplexity )
+{
+    opus_custom_encoder_ctl ( OpusEncoderMono[iChanID], OPUS_SET_COMPLEXITY ( bLowComplexity ? 0 : 1 ) );
+    opus_custom_encoder_ctl ( OpusEncoderStereo[iChanID], OPUS_SET_COMPLEXITY ( bLowComplexity ? 0 : 1 ) );
+    opus_custom_encoder_ctl ( Opus64EncoderMono[iChanID], OPUS_SET_COMPLEXITY ( bLowComplexity ? 0 : iOpus64DefaultComplexity ) );
+    opus_custom_encoder_ctl ( Opus64EncoderStereo[iChanID], OPUS_SET_COMPLEXITY ( bLowComplexity ? 0 : iOpus64DefaultComplexity ) );
 
-        // use the fade in of the current channel for all other connected clients
-        // as well to avoid the client volumes are at 100% when joining a server (#628)
-        if ( j != iChanCnt )
-        {
-            vecvecfGains[iChanCnt][j] *= vecChannels[iCurChanID].GetFadeInGain();
+    vecbEncoderLowComplexity[iChanID] = bLowComplexity;
+}
+
+// This is a static method used as a callback, and does not inherit a "this" pointer,
+// so it is necessary for the server instance to be passed as a parameter.
+void CServer::DecodeReceiveDataWorker ( void* pArg, const int iWorker )
+{
+    CServer*            pServer     = static_cast<CServer*> ( pArg );
+    const CServerFrame& Frame       = pServer->Frames[pServer->iDecFrame];
+    const CVector<int>& vecChanCnts = Frame.vecvecWorkerChanCnts[iWorker];
+
+    // loop over all channels assigned to the current worker and measure the
+    // processing time of each channel for the work partitioning
+    for ( int i = 0; i < Frame.vecWorkerNumChans[iWorker]; i++ )
+    {
+        const int64_t iStartNs = CTickProfiler::Now();
+
+        pServer->DecodeReceiveData ( vecChanCnts[i], Frame.iNumClients );
+
+        const int64_t iDurationNs = CTickProfiler::Now() - iStartNs;
+
+        pServer->vecfChanTickCostUs[Frame.vecChanIDsCurConChan[vecChanCnts[i]]] += iDurationNs / 1000.0f;
+        pServer->TickProfiler.AddDuration ( iWorker, PP_DECODE, iDurationNs );
+    }
+}
+
+// This is a static method used as a callback, and does not inherit a "this" pointer,
+// so it is necessary for the server instance to be passed as a parameter.
+void CServer::MixEncodeTransmitDataWorker ( void* pArg, const int iWorker )
+{
+    CServer*            pServer     = static_cast<CServer*> ( pArg );
+    const CServerFrame& Frame       = pServer->Frames[pServer->iMixFrame];
+    const CVector<int>& vecChanCnts = Frame.vecvecWorkerChanCnts[iWorker];
+
+    // loop over all channels assigned to the current worker and measure the
+    // processing time of each channel for the work partitioning
+    for ( int i = 0; i < Frame.vecWorkerNumChans[iWorker]; i++ )
+    {
+        const int64_t iStartNs = CTickProfiler::Now();
+
+        pServer->MixEncodeTransmitData ( vecChanCnts[i], Frame.iNumClients, iWorker );
+
+        pServer->vecfChanMixTickCostUs[Frame.vecChanIDsCurConChan[vecChanCnts[i]]] += ( CTickProfiler::Now() - iStartNs ) / 1000.0f;
+    }
+
+    // send all audio packets of this worker with as few system calls as possible
+    if ( Frame.vecWorkerNumChans[iWorker] > 0 )
+    {
+        const int64_t iSendStartNs = CTickProfiler::Now();
+
+        pServer->Socket.SendBatch ( pServer->vecSendBatches[iWorker] );
+
+        pServer->TickProfiler.AddDuration ( iWorker, PP_SEND, CTickProfiler::Now() - iSendStartNs );
+    }
+}
+
+// This is a static method used as a callback, and does not inherit a "this" pointer,
+// so it is necessary for the server instance to be passed as a parameter.
+void CServer::PipelineWorker ( void* pArg, const int iWorker )
+{
+    // first finish the previous frame so that its packets leave as early as
+    // possible, then decode the current frame (the two frames do not share
+    // any data so no worker has to wait for another one in between)
+    MixEncodeTransmitDataWorker ( pArg, iWorker );
+    DecodeReceiveDataWorker ( pArg, iWorker );
+}
+
+void CServer::AssignChannelsToWorkers ( const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    const int iNumWorkers  = pWorkerTeam->GetNumWorkers();
+    int       iNumNewChans = 0;
+    int       iChanCnt;
+    int       iWorker;
+
+    // A channel keeps its worker as long as possible so that the OPUS coder
+    // states of the channel stay in the cache of one core. First update the
+    // cost of each channel with the processing time measured in the last tick
+    // and sum up the load of the workers with their current channels.
+    vecfWorkerLoadUs.Reset ( 0 );
+
+    for ( iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+    {
+        const int iCurChanID = Frame.vecChanIDsCurConChan[iChanCnt];
+
+        iWorker = vecChanIDWorker[iCurChanID];
+
+        if ( iWorker == INVALID_INDEX )
+        {
+            // new channel, we do not have a measurement yet
+            vecfChanCostUs[iCurChanID]   = EstimateChannelCostUs ( iCurChanID, iNumClients );
+            vecNewChanCnts[iNumNewChans] = iChanCnt;
+            iNumNewChans++;
+        }
+        else
+        {
+            const float fTickCostUs = vecfChanTickCostUs[iCurChanID] + vecfChanMixTickCostUs[iCurChanID];
+
+            if ( fTickCostUs > 0 )
+            {
+                vecfChanCostUs[iCurChanID] += MT_COST_MEAS_SMOOTH_FACTOR * ( fTickCostUs - vecfChanCostUs[iCurChanID] );
+            }
+
+            vecfWorkerLoadUs[iWorker] += vecfChanCostUs[iCurChanID];
+        }
+
+        vecfChanTickCostUs[iCurChanID]    = 0;
+        vecfChanMixTickCostUs[iCurChanID] = 0;
+    }
+
+    // new channels are distributed with the largest first to the least loaded
+    // worker (note that std::sort does not allocate memory)
+    std::sort ( vecNewChanCnts.begin(), vecNewChanCnts.begin() + iNumNewChans, [this, &Frame] ( const int iA, const int iB ) {
+        return vecfChanCostUs[Frame.vecChanIDsCurConChan[iA]] > vecfChanCostUs[Frame.vecChanIDsCurConChan[iB]];
+    } );
+
+    for ( int i = 0; i < iNumNewChans; i++ )
+    {
+        const int iCurChanID = Frame.vecChanIDsCurConChan[vecNewChanCnts[i]];
+
+        iWorker = static_cast<int> ( std::min_element ( vecfWorkerLoadUs.begin(), vecfWorkerLoadUs.end() ) - vecfWorkerLoadUs.begin() );
+
+        vecChanIDWorker[iCurChanID] = iWorker;
+        vecfWorkerLoadUs[iWorker] += vecfChanCostUs[iCurChanID];
+    }
+
+    // If the workers are unbalanced (e.g. after disconnects or changed codec
+    // settings), move at most one channel per tick from the most to the least
+    // loaded worker. We take the channel which gives the best balance. The
+    // hysteresis avoids channels moving back and forth because of measurement
+    // noise.
+    const int iMinWorker = static_cast<int> ( std::min_element ( vecfWorkerLoadUs.begin(), vecfWorkerLoadUs.end() ) - vecfWorkerLoadUs.begin() );
+    const int iMaxWorker = static_cast<int> ( std::max_element ( vecfWorkerLoadUs.begin(), vecfWorkerLoadUs.end() ) - vecfWorkerLoadUs.begin() );
+
+    const float fImbalance  = vecfWorkerLoadUs[iMaxWorker] - vecfWorkerLoadUs[iMinWorker];
+    const float fHysteresis = std::max ( MT_REBALANCE_MIN_US,
+                                         MT_REBALANCE_REL_HYSTERESIS * std::accumulate ( vecfWorkerLoadUs.begin(), vecfWorkerLoadUs.end(), 0.0f ) /
+                                             iNumWorkers );
+
+    if ( fImbalance > fHysteresis )
+    {
+        int   iBestChanID    = INVALID_INDEX;
+        float fBestImbalance = fImbalance - fHysteresis;
+
+        for ( iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+        {
+            const int iCurChanID = Frame.vecChanIDsCurConChan[iChanCnt];
+
+            if ( vecChanIDWorker[iCurChanID] == iMaxWorker )
+            {
+                const float fNewImbalance = std::abs ( fImbalance - 2 * vecfChanCostUs[iCurChanID] );
+
+                if ( fNewImbalance < fBestImbalance )
+                {
+                    iBestChanID    = iCurChanID;
+                    fBestImbalance = fNewImbalance;
+                }
+            }
+        }
+
+        if ( iBestChanID != INVALID_INDEX )
+        {
+            vecChanIDWorker[iBestChanID] = iMinWorker;
+        }
+    }
+
+    // create the channel lists of the workers
+    Frame.vecWorkerNumChans.Reset ( 0 );
+
+    for ( iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+    {
+        iWorker = vecChanIDWorker[Frame.vecChanIDsCurConChan[iChanCnt]];
+
+        Frame.vecvecWorkerChanCnts[iWorker][Frame.vecWorkerNumChans[iWorker]] = iChanCnt;
+        Frame.vecWorkerNumChans[iWorker]++;
+    }
+}
+
+float CServer::EstimateChannelCostUs ( const int iCurChanID, const int iNumClients )
+{
+    CChannel& Channel = vecChannels[iCurChanID];
+
+    return EstimateClientCostUs ( Channel.GetAudioCompressionType(), Channel.GetNumAudioChannels(), Channel.GetCeltNumCodedBytes(), iNumClients );
+}
+
+float CServer::EstimateClientCostUs ( const EAudComprType eAudComprType,
+                                     const int           iNumAudioChannels,
+                                     const int           iCeltNumCodedBytes,
+                                     const int           iNumClients )
+{
+    // the mix of this listener contains all connected channels
+    float fCostUs = MT_COST_MIX_US_PER_SOURCE * iNumClients * iNumAudioChannels;
+
+    // OPUS decoding and encoding (raw audio is only copied)
+    if ( ( eAudComprType == CT_OPUS ) || ( eAudComprType == CT_OPUS64 ) )
+    {
+        const int iClientFrameSizeSamples = ( eAudComprType == CT_OPUS ) ? DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES : SYSTEM_FRAME_SIZE_SAMPLES;
+
+        if ( iCeltNumCodedBytes != static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * iNumAudioChannels ) )
+        {
+            const float fNumFramesPerTick = static_cast<float> ( iServerFrameSizeSamples ) / iClientFrameSizeSamples;
+
+            fCostUs += 2 /* decode and encode */ * fNumFramesPerTick * iNumAudioChannels *
+                       ( MT_COST_OPUS_US_PER_FRAME + MT_COST_OPUS_US_PER_BYTE * iCeltNumCodedBytes );
+        }
+    }
+
+    return fCostUs;
+}
+
+void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    int                iUnused;
+    int                iClientFrameSizeSamples = 0; // initialize to avoid a compiler warning
+    OpusCustomDecoder* CurOpusDecoder;
+    unsigned char*     pCurCodedData;
+
+    // get actual ID of current channel
+    const int iCurChanID = Frame.vecChanIDsCurConChan[iChanCnt];
+
+    // get and store number of audio channels and compression type
+    Frame.vecNumAudioChannels[iChanCnt] = vecChannels[iCurChanID].GetNumAudioChannels();
+    Frame.vecAudioComprType[iChanCnt]   = vecChannels[iCurChanID].GetAudioCompressionType();
+
+    // get current number of OPUS coded bytes (used for the decoder and the encoder in this frame)
+    Frame.vecCeltNumCodedBytes[iChanCnt] = vecChannels[iCurChanID].GetCeltNumCodedBytes();
+
+    // get info about required frame size conversion properties
+    Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] = ( !bUseDoubleSystemFrameSize && ( Frame.vecAudioComprType[iChanCnt] == CT_OPUS ) );
+
+    if ( bUseDoubleSystemFrameSize && ( Frame.vecAudioComprType[iChanCnt] == CT_OPUS64 ) )
+    {
+        Frame.vecNumFrameSizeConvBlocks[iChanCnt] = 2;
+    }
+    else
+    {
+        Frame.vecNumFrameSizeConvBlocks[iChanCnt] = 1;
+    }
+
+    // reset the conversion buffers of a new connection
+    if ( vecbConvBufResetPending[iCurChanID].exchange ( false ) )
+    {
+        DoubleFrameSizeConvBufIn[iCurChanID].Reset();
+        DoubleFrameSizeConvBufOut[iCurChanID].Reset();
+    }
+
+    // update conversion buffer size (nothing will happen if the size stays the same)
+    if ( Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] )
+    {
+        DoubleFrameSizeConvBufIn[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] );
+        DoubleFrameSizeConvBufOut[iCurChanID].SetBufferSize ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] );
+    }
+
+    // select the opus decoder and raw audio frame length
+    CurOpusDecoder = GetOpusDecoder ( iCurChanID, Frame.vecAudioComprType[iChanCnt], Frame.vecNumAudioChannels[iChanCnt], iClientFrameSizeSamples );
+
+    // get gains of all connected channels, note that the gain/pan settings are
+    // read from a snapshot which is published by the protocol so that no lock
+    // is needed here
+    const CChannelMixRow& MixRow             = vecChannels[iCurChanID].GetMixRow();
+    const float           fFadeInGainCurChan = vecChannels[iCurChanID].GetFadeInGain();
+
+    for ( int j = 0; j < iNumClients; j++ )
+    {
+        // The second index of "vecvecdGains" does not represent
+        // the channel ID! Therefore we have to use
+        // "vecChanIDsCurConChan" to query the IDs of the currently
+        // connected channels
+        const int iOtherChanID = Frame.vecChanIDsCurConChan[j];
+
+        // consider audio fade-in
+        float fFadeInGain = vecChannels[iOtherChanID].GetFadeInGain();
+
+        // use the fade in of the current channel for all other connected clients
+        // as well to avoid the client volumes are at 100% when joining a server (#628)
+        if ( j != iChanCnt )
+        {
+            fFadeInGain *= fFadeInGainCurChan;
+        }
+
+        Frame.vecvecfGains[iChanCnt][j]    = MixRow.fGain[iOtherChanID] * fFadeInGain;
+        Frame.vecvecfPannings[iChanCnt][j] = MixRow.fPan[iOtherChanID];
+
+        // combined gain/pan for each stereo channel, with delay panning the
+        // pan is applied as a delay instead and both channels get full gain
+        if ( bDelayPan )
+        {
+            Frame.vecvecfGainsL[iChanCnt][j] = Frame.vecvecfGains[iChanCnt][j];
+            Frame.vecvecfGainsR[iChanCnt][j] = Frame.vecvecfGains[iChanCnt][j];
+        }
+        else
+        {
+            Frame.vecvecfGainsL[iChanCnt][j] = MixRow.fGainL[iOtherChanID] * fFadeInGain;
+            Frame.vecvecfGainsR[iChanCnt][j] = MixRow.fGainR[iOtherChanID] * fFadeInGain;
         }
+    }
 
-        // panning
-        vecvecfPannings[iChanCnt][j] = vecChannels[iCurChanID].GetPan ( vecChanIDsCurConChan[j] );
+    // check if this listener can be served from the shared mix-minus bus
+    if ( bUseMixMinus )
+    {
+        ClassifyMixMinusRow ( iChanCnt, iNumClients );
+    }
+
+    // needed for finding listeners with identical (or similar on overload) mixes
+    if ( bUseEncodeOnce || ( Frame.eOverloadLevel >= OL_SHARED_MIXES ) )
+    {
+        CalcMixRowHash ( iChanCnt, iNumClients );
     }
 
+    // time spent in the OPUS decoder for this client in this tick (including
+    // the decoding on arrival since the last tick)
+    int64_t iDecodeNs = veciChanArrivalDecodeNs[iCurChanID].exchange ( 0, std::memory_order_relaxed );
+
     // If the server frame size is smaller than the received OPUS frame size, we need a conversion
     // buffer which stores the large buffer.
     // Note that we have a shortcut here. If the conversion buffer is not needed, the boolean flag
     // is false and the Get() function is not called at all. Therefore if the buffer is not needed
     // we do not spend any time in the function but go directly inside the if condition.
-    if ( ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] == 0 ) ||
-         !DoubleFrameSizeConvBufIn[iCurChanID].Get ( vecvecsData[iChanCnt], SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] ) )
+    if ( ( Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] == 0 ) ||
+         !DoubleFrameSizeConvBufIn[iCurChanID].Get ( Frame.vecvecsData[iChanCnt], SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] ) )
     {
-        // get current number of OPUS coded bytes
-        const int iCeltNumCodedBytes = vecChannels[iCurChanID].GetCeltNumCodedBytes();
+        const int iCeltNumCodedBytes = Frame.vecCeltNumCodedBytes[iChanCnt];
 
-        for ( int iB = 0; iB < vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
+        for ( int iB = 0; iB < Frame.vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
         {
-            // get data
-            const EGetDataStat eGetStat = vecChannels[iCurChanID].GetData ( vecvecbyCodedData[iChanCnt], iCeltNumCodedBytes );
-
-            // if channel was just disconnected, set flag that connected
-            // client list is sent to all other clients
-            // and emit the client disconnected signal
+            const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt];
+
+            // With decode-on-arrival, the decoder lock is held from getting the
+            // block until its concealment is done, otherwise the socket thread
+            // could decode a later block in between and the decoder would not
+            // see the frames in playback order.
+            QMutexLocker locker ( bDecodeOnArrival ? &MutexDecoder[iCurChanID] : nullptr );
+
+            // get data (with decode-on-arrival, we may directly get the decoded audio)
+            const EGetDataStat eGetStat = vecChannels[iCurChanID].GetData ( Frame.vecvecbyCodedData[iChanCnt],
+                                                                            iCeltNumCodedBytes,
+                                                                            bDecodeOnArrival ? &Frame.vecvecsData[iChanCnt][iOffset] : nullptr,
+                                                                            iClientFrameSizeSamples * Frame.vecNumAudioChannels[iChanCnt] );
+
+            // if channel was just disconnected, the channel is freed, the
+            // client disconnected signal is emitted and the connected client
+            // list is sent to all other clients by the main thread
             if ( eGetStat == GS_CHAN_NOW_DISCONNECTED )
             {
-                emit ClientDisconnected ( iCurChanID ); // TODO do this outside the mutex lock?
-
-                FreeChannel ( iCurChanID ); // note that the channel is now not in use
+                vecbDisconnectPending[iCurChanID] = true;
 
                 // note that no mutex is needed for this shared resource since it is a
                 // std::atomic write (not a read-modify-write operation) and also each
@@ -953,10 +1506,16 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
                 return;
             }
 
+            // the audio was already decoded when the packet was received
+            if ( eGetStat == GS_BUFFER_OK_DECODED )
+            {
+                continue;
+            }
+
             // get pointer to coded data
             if ( eGetStat == GS_BUFFER_OK )
             {
-                pCurCodedData = &vecvecbyCodedData[iChanCnt][0];
+                pCurCodedData = &Frame.vecvecbyCodedData[iChanCnt][0];
             }
             else
             {
@@ -974,114 +1533,220 @@ void CServer::DecodeReceiveData ( const int iChanCnt, const int iNumClients )
             // sizeof ( int16_t ) is the size in bytes for the raw pcm audio data = 2
             // Sizes other than that are considered OPUS coded because those depend on hardcoded sizes in client.h
             const bool bIsRawAudio =
-                ( iCeltNumCodedBytes == static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * vecNumAudioChannels[iChanCnt] ) );
-
-            const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt];
+                ( iCeltNumCodedBytes == static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * Frame.vecNumAudioChannels[iChanCnt] ) );
 
             if ( !bIsRawAudio )
             {
+                // on overload, the packet loss concealment of an input which is silent
+                // anyway is not worth its cost
+                if ( ( pCurCodedData == nullptr ) && ( Frame.eOverloadLevel >= OL_NO_SILENT_PLC ) &&
+                     ( veciChanSilentFrames[iCurChanID] >= iSilentInputFrames ) )
+                {
+                    memset ( &Frame.vecvecsData[iChanCnt][iOffset],
+                             0,
+                             sizeof ( int16_t ) * iClientFrameSizeSamples * Frame.vecNumAudioChannels[iChanCnt] );
+                }
                 // OPUS decode received data stream
-                if ( CurOpusDecoder != nullptr )
+                else if ( CurOpusDecoder != nullptr )
                 {
+                    const int64_t iStartNs = CTickProfiler::Now();
+
                     iUnused = opus_custom_decode ( CurOpusDecoder,
                                                    pCurCodedData,
                                                    iCeltNumCodedBytes,
-                                                   &vecvecsData[iChanCnt][iOffset],
+                                                   &Frame.vecvecsData[iChanCnt][iOffset],
                                                    iClientFrameSizeSamples );
+
+                    iDecodeNs += CTickProfiler::Now() - iStartNs;
                 }
             }
             else if ( pCurCodedData != nullptr )
             {
                 // copy received raw data stream
-                memcpy ( &vecvecsData[iChanCnt][iOffset], pCurCodedData, iCeltNumCodedBytes );
+                memcpy ( &Frame.vecvecsData[iChanCnt][iOffset], pCurCodedData, iCeltNumCodedBytes );
             }
             else
             {
                 // lost packet - fill with silence
-                memset ( &vecvecsData[iChanCnt][iOffset], 0, iCeltNumCodedBytes );
+                memset ( &Frame.vecvecsData[iChanCnt][iOffset], 0, iCeltNumCodedBytes );
             }
         }
 
         // a new large frame is ready, if the conversion buffer is required, put it in the buffer
         // and read out the small frame size immediately for further processing
-        if ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] != 0 )
+        if ( Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] != 0 )
         {
-            DoubleFrameSizeConvBufIn[iCurChanID].PutAll ( vecvecsData[iChanCnt] );
-            DoubleFrameSizeConvBufIn[iCurChanID].Get ( vecvecsData[iChanCnt], SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
+            DoubleFrameSizeConvBufIn[iCurChanID].PutAll ( Frame.vecvecsData[iChanCnt] );
+            DoubleFrameSizeConvBufIn[iCurChanID].Get ( Frame.vecvecsData[iChanCnt], SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] );
+        }
+    }
+
+    UpdateClientCostUs ( vecfChanDecodeCostUs[iCurChanID], iDecodeNs );
+
+    // track how long the input is silent for the overload control
+    if ( bUseOverloadControl )
+    {
+        const int16_t* psData = &Frame.vecvecsData[iChanCnt][0];
+        int            iPeak  = 0;
+
+        for ( int i = 0; i < iServerFrameSizeSamples * Frame.vecNumAudioChannels[iChanCnt]; i++ )
+        {
+            iPeak = std::max ( iPeak, std::abs ( static_cast<int> ( psData[i] ) ) );
+        }
+
+        if ( iPeak <= OVERLOAD_SILENCE_THRESHOLD )
+        {
+            veciChanSilentFrames[iCurChanID]++;
+        }
+        else
+        {
+            veciChanSilentFrames[iCurChanID] = 0;
         }
     }
 
     Q_UNUSED ( iUnused )
 }
 
+OpusCustomDecoder* CServer::GetOpusDecoder ( const int           iCurChanID,
+                                            const EAudComprType eAudComprType,
+                                            const int           iNumAudioChannels,
+                                            int&                iClientFrameSizeSamples )
+{
+    if ( eAudComprType == CT_OPUS )
+    {
+        iClientFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+
+        return ( iNumAudioChannels == 1 ) ? OpusDecoderMono[iCurChanID] : OpusDecoderStereo[iCurChanID];
+    }
+    else if ( eAudComprType == CT_OPUS64 )
+    {
+        iClientFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
+
+        return ( iNumAudioChannels == 1 ) ? Opus64DecoderMono[iCurChanID] : Opus64DecoderStereo[iCurChanID];
+    }
+
+    return nullptr;
+}
+
+void CServer::DecodeOnArrival ( const int iCurChanID )
+{
+    CChannel&           Channel                 = vecChannels[iCurChanID];
+    const EAudComprType eAudComprType           = Channel.GetAudioCompressionType();
+    const int           iNumAudioChannels       = Channel.GetNumAudioChannels();
+    const int           iCeltNumCodedBytes      = Channel.GetCeltNumCodedBytes();
+    int                 iClientFrameSizeSamples = 0;
+    OpusCustomDecoder*  CurOpusDecoder          = GetOpusDecoder ( iCurChanID, eAudComprType, iNumAudioChannels, iClientFrameSizeSamples );
+
+    // raw audio is only copied in the tick, there is nothing to gain
+    if ( ( CurOpusDecoder == nullptr ) ||
+         ( iCeltNumCodedBytes == static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * iNumAudioChannels ) ) )
+    {
+        return;
+    }
+
+    // the tick may conceal a lost packet with the same decoder at the same time
+    QMutexLocker locker ( &MutexDecoder[iCurChanID] );
+
+    Channel.DecodeNewAudioData ( [=] ( const uint8_t* pCodedData, const int iNumCodedBytes, int16_t* psDecData, const int iDecDataSize ) {
+        // the stream properties may have changed since we have read them
+        if ( ( iNumCodedBytes != iCeltNumCodedBytes ) || ( iDecDataSize != iClientFrameSizeSamples * iNumAudioChannels ) )
+        {
+            return false;
+        }
+
+        const int64_t iStartNs = CTickProfiler::Now();
+
+        opus_custom_decode ( CurOpusDecoder, pCodedData, iNumCodedBytes, psDecData, iClientFrameSizeSamples );
+
+        // the time is added to the decoding cost of the client by the next tick
+        veciChanArrivalDecodeNs[iCurChanID].fetch_add ( CTickProfiler::Now() - iStartNs, std::memory_order_relaxed );
+
+        return true;
+    } );
+}
+
 /// @brief Mix all audio data from all clients together, encode and transmit
-void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients )
+void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients, const int iWorker )
 {
+    CServerFrame&     Frame     = Frames[iMixFrame];
+    CSocketSendBatch& SendBatch = vecSendBatches[iWorker];
+
     int               i, j, k, iUnused;
     CVector<float>&   vecfIntermProcBuf = vecvecfIntermediateProcBuf[iChanCnt]; // use reference for faster access
     CVector<int16_t>& vecsSendData      = vecvecsSendData[iChanCnt];            // use reference for faster access
 
     // get actual ID of current channel
-    const int iCurChanID = vecChanIDsCurConChan[iChanCnt];
+    const int iCurChanID = Frame.vecChanIDsCurConChan[iChanCnt];
+
+    // if the listener shares the mix of another listener, the mix is created and sent by the group leader
+    if ( Frame.vecMixGroupLeader[iChanCnt] != iChanCnt )
+    {
+        UpdateClientCostUs ( vecfChanMixCostUs[iCurChanID], 0 );
+        UpdateClientCostUs ( vecfChanEncodeCostUs[iCurChanID], 0 );
+        return;
+    }
+
+    const int64_t iMixStartNs = CTickProfiler::Now();
 
     // init intermediate processing vector with zeros since we mix all channels on that vector
     vecfIntermProcBuf.Reset ( 0 );
 
-    // distinguish between stereo and mono mode
-    if ( vecNumAudioChannels[iChanCnt] == 1 )
+    // distinguish between mix-minus, stereo and mono mode
+    if ( Frame.vecNumMixMinusCorr[iChanCnt] != INVALID_INDEX )
+    {
+        // Mix-minus target channel --------------------------------------------
+        MixFromMixMinusBus ( iChanCnt, iNumClients );
+    }
+    else if ( ( Frame.vecNumAudioChannels[iChanCnt] == 1 ) || ( Frame.eOverloadLevel >= OL_MONO_MIXES ) )
     {
-        // Mono target channel -------------------------------------------------
+        // Mono target channel (or mono mix for a stereo listener on overload) -
         for ( j = 0; j < iNumClients; j++ )
         {
             // get a reference to the audio data and gain of the current client
-            const CVector<int16_t>& vecsData = vecvecsData[j];
-            const float             fGain    = vecvecfGains[iChanCnt][j];
+            const CVector<int16_t>& vecsData = Frame.vecvecsData[j];
+            const float             fGain    = Frame.vecvecfGains[iChanCnt][j];
 
             // if channel gain is 1, avoid multiplication for speed optimization
             if ( fGain == 1.0f )
             {
-                if ( vecNumAudioChannels[j] == 1 )
+                if ( Frame.vecNumAudioChannels[j] == 1 )
                 {
                     // mono
-                    for ( i = 0; i < iServerFrameSizeSamples; i++ )
-                    {
-                        vecfIntermProcBuf[i] += vecsData[i];
-                    }
+                    MixKernels.AddMono ( &vecfIntermProcBuf[0], &vecsData[0], iServerFrameSizeSamples );
                 }
                 else
                 {
                     // stereo: apply stereo-to-mono attenuation
-                    for ( i = 0, k = 0; i < iServerFrameSizeSamples; i++, k += 2 )
-                    {
-                        vecfIntermProcBuf[i] += ( static_cast<float> ( vecsData[k] ) + vecsData[k + 1] ) / 2.0f;
-                    }
+                    MixKernels.AddStereoToMono ( &vecfIntermProcBuf[0], &vecsData[0], iServerFrameSizeSamples );
                 }
             }
             else
             {
-                if ( vecNumAudioChannels[j] == 1 )
+                if ( Frame.vecNumAudioChannels[j] == 1 )
                 {
                     // mono
-                    for ( i = 0; i < iServerFrameSizeSamples; i++ )
-                    {
-                        vecfIntermProcBuf[i] += vecsData[i] * fGain;
-                    }
+                    MixKernels.AddMonoGain ( &vecfIntermProcBuf[0], &vecsData[0], fGain, iServerFrameSizeSamples );
                 }
                 else
                 {
                     // stereo: apply stereo-to-mono attenuation
-                    for ( i = 0, k = 0; i < iServerFrameSizeSamples; i++, k += 2 )
-                    {
-                        vecfIntermProcBuf[i] += fGain * ( static_cast<float> ( vecsData[k] ) + vecsData[k + 1] ) / 2.0f;
-                    }
+                    MixKernels.AddStereoToMonoGain ( &vecfIntermProcBuf[0], &vecsData[0], fGain, iServerFrameSizeSamples );
                 }
             }
         }
 
         // convert from double to short with clipping
-        for ( i = 0; i < iServerFrameSizeSamples; i++ )
+        MixKernels.Float2ShortClip ( &vecsSendData[0], &vecfIntermProcBuf[0], iServerFrameSizeSamples );
+
+        // a stereo listener still expects stereo data, copy the mono mix in both
+        // channels (backwards so that it can be done in place)
+        if ( Frame.vecNumAudioChannels[iChanCnt] != 1 )
         {
-            vecsSendData[i] = Float2Short ( vecfIntermProcBuf[i] );
+            for ( i = iServerFrameSizeSamples - 1; i >= 0; i-- )
+            {
+                vecsSendData[2 * i]     = vecsSendData[i];
+                vecsSendData[2 * i + 1] = vecsSendData[i];
+            }
         }
     }
     else
@@ -1096,22 +1761,19 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
         for ( j = 0; j < iNumClients; j++ )
         {
             // get a reference to the audio data and gain/pan of the current client
-            const CVector<int16_t>& vecsData  = vecvecsData[j];
+            const CVector<int16_t>& vecsData  = Frame.vecvecsData[j];
             const CVector<int16_t>& vecsData2 = vecvecsData2[j];
 
-            const float fGain = vecvecfGains[iChanCnt][j];
-            const float fPan  = bDelayPan ? 0.5f : vecvecfPannings[iChanCnt][j];
-
-            // calculate combined gain/pan for each stereo channel where we define
-            // the panning that center equals full gain for both channels
-            const float fGainL = MathUtils::GetLeftPan ( fPan, false ) * fGain;
-            const float fGainR = MathUtils::GetRightPan ( fPan, false ) * fGain;
+            // combined gain/pan for each stereo channel where we define the
+            // panning that center equals full gain for both channels
+            const float fGainL = Frame.vecvecfGainsL[iChanCnt][j];
+            const float fGainR = Frame.vecvecfGainsR[iChanCnt][j];
 
-            const bool isMono = vecNumAudioChannels[j] == 1;
+            const bool isMono = Frame.vecNumAudioChannels[j] == 1;
 
             if ( bDelayPan )
             {
-                iPanDel  = lround ( (float) ( 2 * maxPanDelay - 2 ) * ( vecvecfPannings[iChanCnt][j] - 0.5f ) );
+                iPanDel  = lround ( (float) ( 2 * maxPanDelay - 2 ) * ( Frame.vecvecfPannings[iChanCnt][j] - 0.5f ) );
                 iPanDelL = ( iPanDel > 0 ) ? iPanDel : 0;
                 iPanDelR = ( iPanDel < 0 ) ? -iPanDel : 0;
 
@@ -1190,121 +1852,477 @@ void CServer::MixEncodeTransmitData ( const int iChanCnt, const int iNumClients
                 if ( isMono )
                 {
                     // mono: copy same mono data in both out stereo audio channels
-                    for ( i = 0, k = 0; i < iServerFrameSizeSamples; i++, k += 2 )
-                    {
-                        vecfIntermProcBuf[k] += vecsData[i] * fGainL;
-                        vecfIntermProcBuf[k + 1] += vecsData[i] * fGainR;
-                    }
+                    MixKernels.AddMonoToStereo ( &vecfIntermProcBuf[0], &vecsData[0], fGainL, fGainR, iServerFrameSizeSamples );
                 }
                 else
                 {
-                    for ( i = 0; i < ( 2 * iServerFrameSizeSamples ); i += 2 )
+                    // left/right channel
+                    MixKernels.AddStereo ( &vecfIntermProcBuf[0], &vecsData[0], fGainL, fGainR, iServerFrameSizeSamples );
+                }
+            }
+        }
+
+        // convert from double to short with clipping
+        MixKernels.Float2ShortClip ( &vecsSendData[0], &vecfIntermProcBuf[0], 2 * iServerFrameSizeSamples );
+    }
+
+    const int64_t iEncodeStartNs = CTickProfiler::Now();
+
+    TickProfiler.AddDuration ( iWorker, PP_MIX, iEncodeStartNs - iMixStartNs );
+    UpdateClientCostUs ( vecfChanMixCostUs[iCurChanID], iEncodeStartNs - iMixStartNs );
+
+    int                iClientFrameSizeSamples = 0; // initialize to avoid a compiler warning
+    OpusCustomEncoder* CurOpusEncoder          = nullptr;
+
+    // get current number of CELT coded bytes
+    const int iCeltNumCodedBytes = Frame.vecCeltNumCodedBytes[iChanCnt];
+
+    // select the opus encoder and raw audio frame length
+    if ( Frame.vecAudioComprType[iChanCnt] == CT_OPUS )
+    {
+        iClientFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+
+        if ( Frame.vecNumAudioChannels[iChanCnt] == 1 )
+        {
+            CurOpusEncoder = OpusEncoderMono[iCurChanID];
+        }
+        else
+        {
+            CurOpusEncoder = OpusEncoderStereo[iCurChanID];
+        }
+    }
+    else if ( Frame.vecAudioComprType[iChanCnt] == CT_OPUS64 )
+    {
+        iClientFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
+
+        if ( Frame.vecNumAudioChannels[iChanCnt] == 1 )
+        {
+            CurOpusEncoder = Opus64EncoderMono[iCurChanID];
+        }
+        else
+        {
+            CurOpusEncoder = Opus64EncoderStereo[iCurChanID];
+        }
+    }
+
+    // If the server frame size is smaller than the received OPUS frame size, we need a conversion
+    // buffer which stores the large buffer.
+    // Note that we have a shortcut here. If the conversion buffer is not needed, the boolean flag
+    // is false and the Get() function is not called at all. Therefore if the buffer is not needed
+    // we do not spend any time in the function but go directly inside the if condition.
+    if ( ( Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] == 0 ) ||
+         DoubleFrameSizeConvBufOut[iCurChanID].Put ( vecsSendData, SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] ) )
+    {
+        if ( Frame.vecUseDoubleSysFraSizeConvBuf[iChanCnt] != 0 )
+        {
+            // get the large frame from the conversion buffer
+            DoubleFrameSizeConvBufOut[iCurChanID].GetAll ( vecsSendData, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt] );
+        }
+
+        if ( iCeltNumCodedBytes != static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * Frame.vecNumAudioChannels[iChanCnt] ) )
+        {
+            // OPUS encoding
+            if ( CurOpusEncoder != nullptr )
+            {
+                // only the encoders of the channels which are actually encoded
+                // follow the overload level
+                const bool bLowComplexity = ( Frame.eOverloadLevel >= OL_LOW_COMPLEXITY );
+
+                if ( vecbEncoderLowComplexity[iCurChanID] != bLowComplexity )
+                {
+                    SetEncoderComplexity ( iCurChanID, bLowComplexity );
+                }
+
+                //### TODO: BEGIN ###//
+                // find a better place than this: the setting does not change all the time so for speed
+                // optimization it would be better to set it only if the network frame size is changed
+                opus_custom_encoder_ctl ( CurOpusEncoder,
+                                          OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, iClientFrameSizeSamples ) ) );
+                //### TODO: END ###//
+
+                for ( int iB = 0; iB < Frame.vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
+                {
+                    const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt];
+
+                    iUnused = opus_custom_encode ( CurOpusEncoder,
+                                                   &vecsSendData[iOffset],
+                                                   iClientFrameSizeSamples,
+                                                   &Frame.vecvecbyCodedData[iChanCnt][0],
+                                                   iCeltNumCodedBytes );
+
+                    // send separate mix to current clients (and to the listeners sharing it)
+                    SendMixToGroup ( iChanCnt, iCeltNumCodedBytes, SendBatch );
+
+                    // the next block reuses the conversion buffers of the channels
+                    if ( iB + 1 < Frame.vecNumFrameSizeConvBlocks[iChanCnt] )
                     {
-                        // left/right channel
-                        vecfIntermProcBuf[i] += vecsData[i] * fGainL;
-                        vecfIntermProcBuf[i + 1] += vecsData[i + 1] * fGainR;
+                        Socket.SendBatch ( SendBatch );
                     }
                 }
             }
         }
+        else
+        {
+            for ( int iB = 0; iB < Frame.vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
+            {
+                const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * Frame.vecNumAudioChannels[iChanCnt];
+
+                memcpy ( &Frame.vecvecbyCodedData[iChanCnt][0], &vecsSendData[iOffset], iCeltNumCodedBytes );
+
+                // send separate mix to current clients (and to the listeners sharing it)
+                SendMixToGroup ( iChanCnt, iCeltNumCodedBytes, SendBatch );
+
+                // the next block reuses the conversion buffers of the channels
+                if ( iB + 1 < Frame.vecNumFrameSizeConvBlocks[iChanCnt] )
+                {
+                    Socket.SendBatch ( SendBatch );
+                }
+            }
+        }
+    }
+
+    const int64_t iEncodeNs = CTickProfiler::Now() - iEncodeStartNs;
+
+    TickProfiler.AddDuration ( iWorker, PP_ENCODE, iEncodeNs );
+    UpdateClientCostUs ( vecfChanEncodeCostUs[iCurChanID], iEncodeNs );
+
+    Q_UNUSED ( iUnused )
+}
+
+void CServer::ClassifyMixMinusRow ( const int iChanCnt, const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    // on overload, stereo listeners get a mono mix (from the mono bus)
+    const bool bStereoTarget   = ( Frame.vecNumAudioChannels[iChanCnt] != 1 ) && ( Frame.eOverloadLevel < OL_MONO_MIXES );
+    int        iNumCorrections = 0;
+
+    for ( int j = 0; j < iNumClients; j++ )
+    {
+        if ( bStereoTarget )
+        {
+            // with delay panning a non-center pan is a delay which cannot be
+            // expressed as a correction term, use the full mix in that case
+            if ( bDelayPan && ( Frame.vecvecfPannings[iChanCnt][j] != 0.5f ) )
+            {
+                Frame.vecNumMixMinusCorr[iChanCnt] = INVALID_INDEX;
+                return;
+            }
+
+            if ( ( Frame.vecvecfGainsL[iChanCnt][j] != 1.0f ) || ( Frame.vecvecfGainsR[iChanCnt][j] != 1.0f ) )
+            {
+                iNumCorrections++;
+            }
+        }
+        else if ( Frame.vecvecfGains[iChanCnt][j] != 1.0f )
+        {
+            iNumCorrections++;
+        }
+    }
+
+    // the bus is only worth it if the corrections are less work than the full mix
+    if ( iNumCorrections < iNumClients / 2 )
+    {
+        Frame.vecNumMixMinusCorr[iChanCnt] = iNumCorrections;
+    }
+    else
+    {
+        Frame.vecNumMixMinusCorr[iChanCnt] = INVALID_INDEX;
+    }
+}
+
+void CServer::CreateMixMinusBus ( const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    bool bMonoBusNeeded   = false;
+    bool bStereoBusNeeded = false;
+
+    // only create the busses which are actually used by a listener
+    for ( int i = 0; i < iNumClients; i++ )
+    {
+        if ( Frame.vecNumMixMinusCorr[i] != INVALID_INDEX )
+        {
+            if ( ( Frame.vecNumAudioChannels[i] == 1 ) || ( Frame.eOverloadLevel >= OL_MONO_MIXES ) )
+            {
+                bMonoBusNeeded = true;
+            }
+            else
+            {
+                bStereoBusNeeded = true;
+            }
+        }
+    }
+
+    // The busses contain all sources with unity gain and center pan. Note that
+    // the sums are exact since all values are integers (or halves of integers
+    // for the stereo-to-mono attenuation) which fit in the float mantissa.
+    if ( bMonoBusNeeded )
+    {
+        Frame.vecfMixMinusBusMono.Reset ( 0 );
+
+        for ( int j = 0; j < iNumClients; j++ )
+        {
+            if ( Frame.vecNumAudioChannels[j] == 1 )
+            {
+                MixKernels.AddMono ( &Frame.vecfMixMinusBusMono[0], &Frame.vecvecsData[j][0], iServerFrameSizeSamples );
+            }
+            else
+            {
+                MixKernels.AddStereoToMono ( &Frame.vecfMixMinusBusMono[0], &Frame.vecvecsData[j][0], iServerFrameSizeSamples );
+            }
+        }
+    }
+
+    if ( bStereoBusNeeded )
+    {
+        Frame.vecfMixMinusBusStereo.Reset ( 0 );
+
+        for ( int j = 0; j < iNumClients; j++ )
+        {
+            if ( Frame.vecNumAudioChannels[j] == 1 )
+            {
+                MixKernels.AddMonoToStereo ( &Frame.vecfMixMinusBusStereo[0], &Frame.vecvecsData[j][0], 1.0f, 1.0f, iServerFrameSizeSamples );
+            }
+            else
+            {
+                MixKernels.AddStereo ( &Frame.vecfMixMinusBusStereo[0], &Frame.vecvecsData[j][0], 1.0f, 1.0f, iServerFrameSizeSamples );
+            }
+        }
+    }
+}
+
+/// @brief Create the mix of a listener from the shared bus plus a correction
+///        term (gain - 1) for each source with a non-default gain/pan
+void CServer::MixFromMixMinusBus ( const int iChanCnt, const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iMixFrame];
+
+    CVector<float>&   vecfIntermProcBuf = vecvecfIntermediateProcBuf[iChanCnt];
+    CVector<int16_t>& vecsSendData      = vecvecsSendData[iChanCnt];
+
+    if ( ( Frame.vecNumAudioChannels[iChanCnt] == 1 ) || ( Frame.eOverloadLevel >= OL_MONO_MIXES ) )
+    {
+        std::copy ( Frame.vecfMixMinusBusMono.begin(), Frame.vecfMixMinusBusMono.begin() + iServerFrameSizeSamples, vecfIntermProcBuf.begin() );
+
+        for ( int j = 0; j < iNumClients; j++ )
+        {
+            const float fGain = Frame.vecvecfGains[iChanCnt][j];
+
+            if ( fGain != 1.0f )
+            {
+                if ( Frame.vecNumAudioChannels[j] == 1 )
+                {
+                    MixKernels.AddMonoGain ( &vecfIntermProcBuf[0], &Frame.vecvecsData[j][0], fGain - 1.0f, iServerFrameSizeSamples );
+                }
+                else
+                {
+                    MixKernels.AddStereoToMonoGain ( &vecfIntermProcBuf[0], &Frame.vecvecsData[j][0], fGain - 1.0f, iServerFrameSizeSamples );
+                }
+            }
+        }
+
+        MixKernels.Float2ShortClip ( &vecsSendData[0], &vecfIntermProcBuf[0], iServerFrameSizeSamples );
+
+        // mono mix for a stereo listener on overload (see MixEncodeTransmitData)
+        if ( Frame.vecNumAudioChannels[iChanCnt] != 1 )
+        {
+            for ( int i = iServerFrameSizeSamples - 1; i >= 0; i-- )
+            {
+                vecsSendData[2 * i]     = vecsSendData[i];
+                vecsSendData[2 * i + 1] = vecsSendData[i];
+            }
+        }
+    }
+    else
+    {
+        std::copy ( Frame.vecfMixMinusBusStereo.begin(),
+                    Frame.vecfMixMinusBusStereo.begin() + 2 * iServerFrameSizeSamples,
+                    vecfIntermProcBuf.begin() );
+
+        for ( int j = 0; j < iNumClients; j++ )
+        {
+            // note that with delay panning only rows with center pan use the bus
+            const float fGainL = Frame.vecvecfGainsL[iChanCnt][j];
+            const float fGainR = Frame.vecvecfGainsR[iChanCnt][j];
+
+            if ( ( fGainL != 1.0f ) || ( fGainR != 1.0f ) )
+            {
+                if ( Frame.vecNumAudioChannels[j] == 1 )
+                {
+                    MixKernels.AddMonoToStereo ( &vecfIntermProcBuf[0],
+                                                 &Frame.vecvecsData[j][0],
+                                                 fGainL - 1.0f,
+                                                 fGainR - 1.0f,
+                                                 iServerFrameSizeSamples );
+                }
+                else
+                {
+                    MixKernels.AddStereo ( &vecfIntermProcBuf[0], &Frame.vecvecsData[j][0], fGainL - 1.0f, fGainR - 1.0f, iServerFrameSizeSamples );
+                }
+            }
+        }
+
+        MixKernels.Float2ShortClip ( &vecsSendData[0], &vecfIntermProcBuf[0], 2 * iServerFrameSizeSamples );
+    }
+}
+
+void CServer::CalcMixRowHash ( const int iChanCnt, const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    // FNV-1a hash over everything which defines the mix and its coding, the pan
+    // is only relevant for stereo listeners (and not if all mixes are mono on overload)
+    const bool bUsePan     = ( Frame.vecNumAudioChannels[iChanCnt] != 1 ) && ( Frame.eOverloadLevel < OL_MONO_MIXES );
+    const bool bUseSimilar = ( Frame.eOverloadLevel >= OL_SHARED_MIXES );
+    uint32_t   iHash       = 2166136261u;
+
+    auto HashAdd = [&iHash] ( const void* pData, const size_t iSize ) {
+        const uint8_t* pbyData = static_cast<const uint8_t*> ( pData );
+
+        for ( size_t i = 0; i < iSize; i++ )
+        {
+            iHash = ( iHash ^ pbyData[i] ) * 16777619u;
+        }
+    };
+
+    HashAdd ( &Frame.vecNumAudioChannels[iChanCnt], sizeof ( int ) );
+    HashAdd ( &Frame.vecAudioComprType[iChanCnt], sizeof ( EAudComprType ) );
+    HashAdd ( &Frame.vecCeltNumCodedBytes[iChanCnt], sizeof ( int ) );
+
+    if ( bUseSimilar )
+    {
+        // on overload, similar mixes are shared so the hash must only see the quantised values
+        for ( int j = 0; j < iNumClients; j++ )
+        {
+            const uint32_t iGainStep = COverloadController::GetSimilarGainStep ( Frame.vecvecfGains[iChanCnt][j] );
+            HashAdd ( &iGainStep, sizeof ( uint32_t ) );
+
+            if ( bUsePan )
+            {
+                const int iPanStep = COverloadController::GetSimilarPanStep ( Frame.vecvecfPannings[iChanCnt][j] );
+                HashAdd ( &iPanStep, sizeof ( int ) );
+            }
+        }
+    }
+    else
+    {
+        HashAdd ( &Frame.vecvecfGains[iChanCnt][0], iNumClients * sizeof ( float ) );
 
-        // convert from double to short with clipping
-        for ( i = 0; i < ( 2 * iServerFrameSizeSamples ); i++ )
+        if ( bUsePan )
         {
-            vecsSendData[i] = Float2Short ( vecfIntermProcBuf[i] );
+            HashAdd ( &Frame.vecvecfPannings[iChanCnt][0], iNumClients * sizeof ( float ) );
         }
     }
 
-    int                iClientFrameSizeSamples = 0; // initialize to avoid a compiler warning
-    OpusCustomEncoder* CurOpusEncoder          = nullptr;
+    Frame.vecMixRowHash[iChanCnt] = iHash;
+}
 
-    // get current number of CELT coded bytes
-    const int iCeltNumCodedBytes = vecChannels[iCurChanID].GetCeltNumCodedBytes();
+bool CServer::IsSameMix ( const int iChanCnt, const int iOtherChanCnt, const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
 
-    // select the opus encoder and raw audio frame length
-    if ( vecAudioComprType[iChanCnt] == CT_OPUS )
+    if ( ( Frame.vecMixRowHash[iChanCnt] != Frame.vecMixRowHash[iOtherChanCnt] ) ||
+         ( Frame.vecNumAudioChannels[iChanCnt] != Frame.vecNumAudioChannels[iOtherChanCnt] ) ||
+         ( Frame.vecAudioComprType[iChanCnt] != Frame.vecAudioComprType[iOtherChanCnt] ) ||
+         ( Frame.vecCeltNumCodedBytes[iChanCnt] != Frame.vecCeltNumCodedBytes[iOtherChanCnt] ) )
     {
-        iClientFrameSizeSamples = DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES;
+        return false;
+    }
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
+    const bool bUsePan     = ( Frame.vecNumAudioChannels[iChanCnt] != 1 ) && ( Frame.eOverloadLevel < OL_MONO_MIXES );
+    const bool bUseSimilar = ( Frame.eOverloadLevel >= OL_SHARED_MIXES );
+
+    for ( int j = 0; j < iNumClients; j++ )
+    {
+        const float fGain      = Frame.vecvecfGains[iChanCnt][j];
+        const float fGainOther = Frame.vecvecfGains[iOtherChanCnt][j];
+        const float fPan       = Frame.vecvecfPannings[iChanCnt][j];
+        const float fPanOther  = Frame.vecvecfPannings[iOtherChanCnt][j];
+
+        if ( bUseSimilar )
         {
-            CurOpusEncoder = OpusEncoderMono[iCurChanID];
+            if ( ( COverloadController::GetSimilarGainStep ( fGain ) != COverloadController::GetSimilarGainStep ( fGainOther ) ) ||
+                 ( bUsePan && ( COverloadController::GetSimilarPanStep ( fPan ) != COverloadController::GetSimilarPanStep ( fPanOther ) ) ) )
+            {
+                return false;
+            }
         }
-        else
+        else if ( ( fGain != fGainOther ) || ( bUsePan && ( fPan != fPanOther ) ) )
         {
-            CurOpusEncoder = OpusEncoderStereo[iCurChanID];
+            return false;
         }
     }
-    else if ( vecAudioComprType[iChanCnt] == CT_OPUS64 )
+
+    return true;
+}
+
+void CServer::GroupIdenticalMixes ( const int iNumClients )
+{
+    CServerFrame& Frame = Frames[iDecFrame];
+
+    qint64 iNumEncodesSavedInFrame = 0;
+
+    for ( int i = 0; i < iNumClients; i++ )
     {
-        iClientFrameSizeSamples = SYSTEM_FRAME_SIZE_SAMPLES;
+        // init as single listener group
+        Frame.vecMixGroupLeader[i] = i;
+        Frame.vecMixGroupNext[i]   = INVALID_INDEX;
+        Frame.vecMixGroupLast[i]   = i;
 
-        if ( vecNumAudioChannels[iChanCnt] == 1 )
-        {
-            CurOpusEncoder = Opus64EncoderMono[iCurChanID];
-        }
-        else
+        // listeners using the frame size conversion buffer have their own buffer state and cannot share a mix
+        if ( Frame.vecUseDoubleSysFraSizeConvBuf[i] != 0 )
         {
-            CurOpusEncoder = Opus64EncoderStereo[iCurChanID];
+            continue;
         }
-    }
 
-    // If the server frame size is smaller than the received OPUS frame size, we need a conversion
-    // buffer which stores the large buffer.
-    // Note that we have a shortcut here. If the conversion buffer is not needed, the boolean flag
-    // is false and the Get() function is not called at all. Therefore if the buffer is not needed
-    // we do not spend any time in the function but go directly inside the if condition.
-    if ( ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] == 0 ) ||
-         DoubleFrameSizeConvBufOut[iCurChanID].Put ( vecsSendData, SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] ) )
-    {
-        if ( vecUseDoubleSysFraSizeConvBuf[iChanCnt] != 0 )
+        // mixes are only shared with encode once or on overload, otherwise the
+        // groups are only initialised so that no stale groups are left over
+        if ( !bUseEncodeOnce && ( Frame.eOverloadLevel < OL_SHARED_MIXES ) )
         {
-            // get the large frame from the conversion buffer
-            DoubleFrameSizeConvBufOut[iCurChanID].GetAll ( vecsSendData, DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt] );
+            continue;
         }
 
-        if ( iCeltNumCodedBytes != static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * vecNumAudioChannels[iChanCnt] ) )
+        // search for a group leader with the same mix
+        for ( int k = 0; k < i; k++ )
         {
-            // OPUS encoding
-            if ( CurOpusEncoder != nullptr )
+            if ( ( Frame.vecMixGroupLeader[k] == k ) && ( Frame.vecUseDoubleSysFraSizeConvBuf[k] == 0 ) && IsSameMix ( k, i, iNumClients ) )
             {
-                //### TODO: BEGIN ###//
-                // find a better place than this: the setting does not change all the time so for speed
-                // optimization it would be better to set it only if the network frame size is changed
-                opus_custom_encoder_ctl ( CurOpusEncoder,
-                                          OPUS_SET_BITRATE ( CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, iClientFrameSizeSamples ) ) );
-                //### TODO: END ###//
-
-                for ( int iB = 0; iB < vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
-                {
-                    const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt];
+                // append listener to the group
+                Frame.vecMixGroupLeader[i]                      = k;
+                Frame.vecMixGroupNext[Frame.vecMixGroupLast[k]] = i;
+                Frame.vecMixGroupLast[k]                        = i;
 
-                    iUnused = opus_custom_encode ( CurOpusEncoder,
-                                                   &vecsSendData[iOffset],
-                                                   iClientFrameSizeSamples,
-                                                   &vecvecbyCodedData[iChanCnt][0],
-                                                   iCeltNumCodedBytes );
+                // count the saved OPUS encodings (raw audio is not encoded)
+                const int iClientFrameSizeSamples =
+                    ( Frame.vecAudioComprType[i] == CT_OPUS ) ? DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES : SYSTEM_FRAME_SIZE_SAMPLES;
 
-                    // send separate mix to current clients
-                    vecChannels[iCurChanID].PrepAndSendPacket ( &Socket, vecvecbyCodedData[iChanCnt], iCeltNumCodedBytes );
+                if ( Frame.vecCeltNumCodedBytes[i] !=
+                     static_cast<int> ( sizeof ( int16_t ) * iClientFrameSizeSamples * Frame.vecNumAudioChannels[i] ) )
+                {
+                    iNumEncodesSavedInFrame += Frame.vecNumFrameSizeConvBlocks[i];
                 }
+                break;
             }
         }
-        else
-        {
-            for ( int iB = 0; iB < vecNumFrameSizeConvBlocks[iChanCnt]; iB++ )
-            {
-                const int iOffset = iB * SYSTEM_FRAME_SIZE_SAMPLES * vecNumAudioChannels[iChanCnt];
-
-                memcpy ( &vecvecbyCodedData[iChanCnt][0], &vecsSendData[iOffset], iCeltNumCodedBytes );
+    }
 
-                // send separate mix to current clients
-                vecChannels[iCurChanID].PrepAndSendPacket ( &Socket, vecvecbyCodedData[iChanCnt], iCeltNumCodedBytes );
-            }
-        }
+    if ( iNumEncodesSavedInFrame > 0 )
+    {
+        iNumEncodesSaved.fetch_add ( iNumEncodesSavedInFrame, std::memory_order_relaxed );
     }
+}
 
-    Q_UNUSED ( iUnused )
+void CServer::SendMixToGroup ( const int iChanCnt, const int iNumCodedBytes, CSocketSendBatch& SendBatch )
+{
+    CServerFrame& Frame = Frames[iMixFrame];
+
+    // the coded data of the group leader is sent to all listeners of the group,
+    // each channel adds its own sequence number
+    for ( int i = iChanCnt; i != INVALID_INDEX; i = Frame.vecMixGroupNext[i] )
+    {
+        vecChannels[Frame.vecChanIDsCurConChan[i]].PrepAndSendPacket ( &Socket, SendBatch, Frame.vecvecbyCodedData[iChanCnt], iNumCodedBytes );
+    }
 }
 
 CVector<CChannelInfo> CServer::CreateChannelList()
@@ -1417,129 +2435,100 @@ void CServer::CreateOtherMuteStateChanged ( const int iCurChanID, const int iOth
     }
 }
 
-int CServer::GetNumberOfConnectedClients()
-{
-    QMutexLocker locker ( &MutexChanOrder );
-
-    return iCurNumChannels;
-}
-
 // CServer::FindChannel() is called for every received audio packet or connected protocol
 // packet, to find the channel ID associated with the source IP address and port.
-// In order to search as efficiently as possible, a list of active channel IDs is stored
-// in vecChannelOrder[], sorted by IP and port (according to CHostAddress::Compare()),
-// and a binary search is used to find either the existing channel, or the position at
-// which a new channel should be inserted.
+// The lookup in the channel table does not need a lock. Only if a new channel is
+// allocated, the table is modified with MutexChanTable locked.
 
 int CServer::FindChannel ( const CHostAddress& CheckAddr, const bool bAllowNew )
 {
-    int iNewChanID = INVALID_CHANNEL_ID;
-
-    QMutexLocker locker ( &MutexChanOrder );
+    int iChanID = ChannelTable.Find ( CheckAddr );
 
-    int l = 0, r = iCurNumChannels, i;
-
-    // use binary search to find the channel
-    while ( r > l )
+    if ( iChanID != INVALID_INDEX )
     {
-        int t   = ( r + l ) / 2;
-        int cmp = CheckAddr.Compare ( vecChannels[vecChannelOrder[t]].GetAddress() );
-
-        if ( cmp == 0 )
-        {
-            // address and port match
-            return vecChannelOrder[t];
-        }
-
-        if ( cmp > 0 )
-        {
-            l = t + 1;
-        }
-        else
-        {
-            r = t;
-        }
+        return iChanID;
     }
 
     // existing channel not found - return if we cannot create a new channel
-    if ( !bAllowNew || iCurNumChannels >= iMaxNumChannels )
+    if ( !bAllowNew )
     {
         return INVALID_CHANNEL_ID;
     }
 
+    QMutexLocker locker ( &MutexChanTable );
+
+    // another thread may have allocated the channel in the meantime
+    iChanID = ChannelTable.Find ( CheckAddr );
+
+    if ( iChanID != INVALID_INDEX )
+    {
+        return iChanID;
+    }
+
     // allocate a new channel
-    i          = iCurNumChannels++; // save index of free channel and increment count
-    iNewChanID = vecChannelOrder[i];
-    InitChannel ( iNewChanID, CheckAddr );
+    iChanID = ChannelTable.GetFreeChannel();
 
-    // now l == r == position in vecChannelOrder to insert iNewChanID
-    // move channel IDs up by one starting at the top and working down
-    while ( i > r )
+    if ( iChanID == INVALID_INDEX )
     {
-        int j              = i--;
-        vecChannelOrder[j] = vecChannelOrder[i];
+        return INVALID_CHANNEL_ID;
     }
-    // insert the new channel ID in the correct place
-    vecChannelOrder[i] = iNewChanID;
+
+    // the channel must be initialised before other threads can find it
+    InitChannel ( iChanID, CheckAddr );
+    ChannelTable.Add ( CheckAddr, iChanID );
 
     // DumpChannels ( __FUNCTION__ );
 
-    return iNewChanID;
+    return iChanID;
 }
 
 void CServer::InitChannel ( const int iNewChanID, const CHostAddress& InetAddr )
 {
     // initialize new channel by storing the calling host address
-    vecChannels[iNewChanID].SetAddress ( InetAddr );
+    vecChannels[iNewChanID].Allocate ( InetAddr );
 
     // reset channel info
     vecChannels[iNewChanID].ResetInfo();
 
+    // the processing cost of the previous client is not relevant anymore
+    vecfChanDecodeCostUs[iNewChanID] = 0;
+    vecfChanMixCostUs[iNewChanID]    = 0;
+    vecfChanEncodeCostUs[iNewChanID] = 0;
+    veciChanSilentFrames[iNewChanID] = 0;
+    veciChanAdmissionNs[iNewChanID]  = CTickProfiler::Now();
+
     // reset the channel gains/pans of current channel, at the same
     // time reset gains/pans of this channel ID for all other channels
+    vecChannels[iNewChanID].ResetGainsAndPans();
+
     for ( int i = 0; i < iMaxNumChannels; i++ )
     {
-        vecChannels[iNewChanID].SetGain ( i, 1.0 );
-        vecChannels[iNewChanID].SetPan ( i, 0.5 );
-
         // other channels (we do not distinguish the case if
         // i == iCurChanID for simplicity)
-        vecChannels[i].SetGain ( iNewChanID, 1.0 );
-        vecChannels[i].SetPan ( iNewChanID, 0.5 );
+        vecChannels[i].SetGainAndPan ( iNewChanID, 1.0f, 0.5f );
     }
 }
 
 // CServer::FreeChannel() is called to remove a channel from the list of active channels.
-// The remaining ordered IDs are moved down by one space, and the freed ID is moved to the
-// end, ready to be reused by the next new connection.
+// The freed ID is ready to be reused by the next new connection. An audio packet may
+// have connected the channel again since it was disconnected, in this case it is kept.
 
 void CServer::FreeChannel ( const int iCurChanID )
 {
-    QMutexLocker locker ( &MutexChanOrder );
+    QMutexLocker locker ( &MutexChanTable );
 
-    for ( int i = 0; i < iCurNumChannels; i++ )
+    if ( !ChannelTable.IsUsed ( iCurChanID ) )
     {
-        if ( vecChannelOrder[i] == iCurChanID )
-        {
-            --iCurNumChannels;
-
-            // move channel IDs down by one starting at the freed channel and working up the active channels
-            // and then the free channels until its position in the free list is reached
-            while ( i < iCurNumChannels || ( i + 1 < iMaxNumChannels && vecChannelOrder[i + 1] < iCurChanID ) )
-            {
-                int j              = i++;
-                vecChannelOrder[j] = vecChannelOrder[i];
-            }
-            // put deleted channel in the vacated position ready for re-use
-            vecChannelOrder[i] = iCurChanID;
-
-            // DumpChannels ( __FUNCTION__ );
+        qWarning() << "FreeChannel() called with invalid channel ID";
+        return;
+    }
 
-            return;
-        }
+    if ( vecChannels[iCurChanID].Release() )
+    {
+        ChannelTable.Remove ( iCurChanID );
     }
 
-    qWarning() << "FreeChannel() called with invalid channel ID";
+    // DumpChannels ( __FUNCTION__ );
 }
 
 void CServer::DumpChannels ( const QString& title )
@@ -1548,28 +2537,24 @@ void CServer::DumpChannels ( const QString& title )
 
     for ( int i = 0; i < iMaxNumChannels; i++ )
     {
-        int iChanID = vecChannelOrder[i];
-
-        if ( i == iCurNumChannels )
+        if ( ChannelTable.IsUsed ( i ) )
         {
-            qDebug() << "----------";
+            qDebug() << qUtf8Printable ( QString ( "[%1] %2" ).arg ( i ).arg ( vecChannels[i].GetAddress().toString() ) );
         }
-
-        qDebug() << qUtf8Printable ( QString ( "%1: [%2] %3" ).arg ( i, 3 ).arg ( iChanID ).arg ( vecChannels[iChanID].GetAddress().toString() ) );
     }
 }
 
-void CServer::OnProtocolCLMessageReceived ( int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
+void CServer::OnProtocolCLMessageReceived ( int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr )
 {
-    QMutexLocker locker ( &Mutex );
+    QMutexLocker locker ( &MutexControl );
 
     // connection less messages are always processed
     ConnLessProtocol.ParseConnectionLessMessageBody ( vecbyMesBodyData, iRecID, RecHostAddr );
 }
 
-void CServer::OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr )
+void CServer::OnProtocolMessageReceived ( int iRecCounter, int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr )
 {
-    QMutexLocker locker ( &Mutex );
+    QMutexLocker locker ( &MutexControl );
 
     // find the channel with the received address
     const int iCurChanID = FindChannel ( RecHostAddr );
@@ -1581,29 +2566,88 @@ void CServer::OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<u
     }
 }
 
-bool CServer::PutAudioData ( const CVector<uint8_t>& vecbyRecBuf, const int iNumBytesRead, const CHostAddress& HostAdr, int& iCurChanID )
+int CServer::AddSyntheticClient ( const CHostAddress&           InetAddr,
+                                  const CNetworkTransportProps& NetworkTransportProps,
+                                  const CChannelCoreInfo&       ChanInfo )
+{
+    QMutexLocker locker ( &MutexControl );
+
+    const int iCurChanID = FindChannel ( InetAddr, true /* allow new */ );
+
+    // the same as the protocol messages of a real client, the channel is
+    // connected by its first audio packet
+    if ( iCurChanID != INVALID_CHANNEL_ID )
+    {
+        vecChannels[iCurChanID].OnNetTranspPropsReceived ( NetworkTransportProps );
+        vecChannels[iCurChanID].SetChanInfo ( ChanInfo );
+    }
+
+    return iCurChanID;
+}
+
+void CServer::RemoveAllClients()
 {
-    QMutexLocker locker ( &Mutex );
+    for ( int i = 0; i < iMaxNumChannels; i++ )
+    {
+        vecChannels[i].Disconnect();
+    }
+
+    // the disconnection is detected by the next query of the audio data of the
+    // channel (with 64 samples frames, an OPUS channel is only queried every
+    // second tick)
+    for ( int iTick = 0; ( iTick < 4 ) && ( GetNumberOfConnectedClients() > 0 ); iTick++ )
+    {
+        ProcessTick();
+        OnChannelsDisconnected();
+    }
+}
 
-    bool bNewConnection = false; // init return value
+bool CServer::PutAudioData ( const CVector<uint8_t>& vecbyRecBuf, const int iNumBytesRead, const CHostAddress& HostAdr, int& iCurChanID )
+{
+    EPutDataStat ePutStat = PS_AUDIO_INVALID;
 
     // Get channel ID ------------------------------------------------------
-    // check address
-    iCurChanID = FindChannel ( HostAdr, true /* allow new */ );
+    // for known addresses, neither the channel table nor the server is locked
+    iCurChanID = ChannelTable.Find ( HostAdr );
 
-    // If channel is valid or new, put received audio data in jitter buffer ----------------------------
-    if ( iCurChanID != INVALID_CHANNEL_ID )
+    if ( iCurChanID != INVALID_INDEX )
+    {
+        ePutStat = vecChannels[iCurChanID].PutAudioData ( vecbyRecBuf, iNumBytesRead, HostAdr );
+    }
+
+    // The address is unknown or the channel was released at the same time, a
+    // new channel is allocated. This changes the gains of all channels,
+    // therefore the control mutex is needed.
+    if ( ePutStat == PS_AUDIO_INVALID )
     {
-        // put packet in socket buffer
-        if ( vecChannels[iCurChanID].PutAudioData ( vecbyRecBuf, iNumBytesRead, HostAdr ) == PS_NEW_CONNECTION )
+        // with admission control, a new client is refused (server full) if it would
+        // overload the server (this does not need the control mutex)
+        if ( ( iAdmissionTargetPercent > 0 ) && ( ChannelTable.Find ( HostAdr ) == INVALID_INDEX ) && !AdmitNewClient ( HostAdr, iNumBytesRead ) )
+        {
+            iCurChanID = INVALID_CHANNEL_ID;
+            return false;
+        }
+
+        QMutexLocker locker ( &MutexControl );
+
+        iCurChanID = FindChannel ( HostAdr, true /* allow new */ );
+
+        if ( iCurChanID == INVALID_CHANNEL_ID )
         {
-            // in case we have a new connection return this information
-            bNewConnection = true;
+            return false;
         }
+
+        ePutStat = vecChannels[iCurChanID].PutAudioData ( vecbyRecBuf, iNumBytesRead, HostAdr );
     }
 
-    // return the state if a new connection was happening
-    return bNewConnection;
+    // decode the new packet now instead of in the next tick
+    if ( bDecodeOnArrival )
+    {
+        DecodeOnArrival ( iCurChanID );
+    }
+
+    // in case we have a new connection return this information
+    return ePutStat == PS_NEW_CONNECTION;
 }
 
 void CServer::GetConCliParam ( CVector<CHostAddress>&     vecHostAddresses,
@@ -1634,6 +2678,209 @@ void CServer::GetConCliParam ( CVector<CHostAddress>&     vecHostAddresses,
     }
 }
 
+// CServer::UpdateAdmissionPrediction() predicts the additional tick utilisation of a
+// new client. The codec, the number of audio channels and the frame size of a new
+// client are only known after the protocol negotiation. But the size of its audio
+// packets is known and clients sending audio packets of the same size use the same
+// settings, therefore the mean measured cost of these clients is used for the prediction.
+
+void CServer::UpdateAdmissionPrediction ( const CServerFrame& Frame, const int iNumClients )
+{
+    const int64_t iNowNs     = CTickProfiler::Now();
+    const int64_t iSettledNs = iNowNs - static_cast<int64_t> ( ADMISSION_SETTLE_MS ) * 1000000;
+
+    // the work of a tick is shared by the workers
+    const float fUsToUtilisation = 1000.0f / TickProfiler.GetDeadlineNs() / vecSendBatches.Size();
+
+    CAdmissionPrediction Prediction;
+    int                  veciNumPerPacketSize[ADMISSION_NUM_PACKET_SIZES];
+    float                fSumCost     = 0;
+    float                fSumMixCost  = 0;
+    int                  iNumMeasured = 0;
+    int                  iNumSettling = 0;
+
+    Prediction.iNumPacketSizes = 0;
+
+    for ( int iChanCnt = 0; iChanCnt < iNumClients; iChanCnt++ )
+    {
+        const int iCurChanID = Frame.vecChanIDsCurConChan[iChanCnt];
+
+        // the cost of recently admitted clients is not yet contained in the tick utilisation
+        if ( veciChanAdmissionNs[iCurChanID].load ( std::memory_order_relaxed ) > iSettledNs )
+        {
+            iNumSettling++;
+        }
+
+        float fDecodeUs, fMixUs, fEncodeUs;
+
+        GetClientCostUs ( iCurChanID, fDecodeUs, fMixUs, fEncodeUs );
+
+        const float fCost = ( fDecodeUs + fMixUs + fEncodeUs ) * fUsToUtilisation;
+
+        fSumMixCost += fMixUs * fUsToUtilisation;
+
+        if ( fCost <= 0 )
+        {
+            continue;
+        }
+
+        fSumCost += fCost;
+        iNumMeasured++;
+
+        // sum of the cost per audio packet size (if the table is full, the mean of all clients is used for the other sizes)
+        const int iPacketSize = vecChannels[iCurChanID].GetNetwFrameSize() * vecChannels[iCurChanID].GetNetwFrameSizeFact();
+        int       iSizeIdx    = 0;
+
+        while ( ( iSizeIdx < Prediction.iNumPacketSizes ) && ( Prediction.veciPacketSize[iSizeIdx] != iPacketSize ) )
+        {
+            iSizeIdx++;
+        }
+
+        if ( iSizeIdx == Prediction.iNumPacketSizes )
+        {
+            if ( iSizeIdx == ADMISSION_NUM_PACKET_SIZES )
+            {
+                continue;
+            }
+
+            Prediction.veciPacketSize[iSizeIdx] = iPacketSize;
+            Prediction.vecfMeanCost[iSizeIdx]   = 0;
+            veciNumPerPacketSize[iSizeIdx]      = 0;
+            Prediction.iNumPacketSizes++;
+        }
+
+        Prediction.vecfMeanCost[iSizeIdx] += fCost;
+        veciNumPerPacketSize[iSizeIdx]++;
+    }
+
+    for ( int iSizeIdx = 0; iSizeIdx < Prediction.iNumPacketSizes; iSizeIdx++ )
+    {
+        Prediction.vecfMeanCost[iSizeIdx] /= veciNumPerPacketSize[iSizeIdx];
+    }
+
+    // if nothing is measured yet, the a-priori estimation of a stereo high quality client is used
+    if ( iNumMeasured > 0 )
+    {
+        Prediction.fMeanCost = fSumCost / iNumMeasured;
+    }
+    else
+    {
+        const EAudComprType eAudComprType      = bUseDoubleSystemFrameSize ? CT_OPUS : CT_OPUS64;
+        const int           iCeltNumCodedBytes =
+            bUseDoubleSystemFrameSize ? OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
+
+        Prediction.fMeanCost = EstimateClientCostUs ( eAudComprType, 2, iCeltNumCodedBytes, iNumClients + 1 ) * fUsToUtilisation;
+    }
+
+    // each connected listener has to mix one more source
+    Prediction.fMixGrowth       = ( iNumClients > 0 ) ? fSumMixCost / iNumClients : 0;
+    Prediction.fBaseUtilisation = OverloadController.GetUtilisation() + iNumSettling * ( Prediction.fMeanCost + Prediction.fMixGrowth );
+
+    // the tick never waits for the lock, in this case the previous prediction is used one tick longer
+    if ( MutexAdmission.tryLock() )
+    {
+        AdmissionPrediction   = Prediction;
+        iNumAdmittedSinceTick = 0;
+        MutexAdmission.unlock();
+    }
+}
+
+// CServer::AdmitNewClient() is called for an audio packet of an unknown address. It only
+// reads the prediction of the last tick. A refused address is refused again without a
+// new check for some time since a client sends an audio packet every frame.
+
+bool CServer::AdmitNewClient ( const CHostAddress& HostAdr, const int iNumBytesRead )
+{
+    // the server is not running if no client is connected, there is nothing to predict
+    if ( GetNumberOfConnectedClients() == 0 )
+    {
+        return true;
+    }
+
+    QMutexLocker locker ( &MutexAdmission );
+
+    const int64_t iNowNs    = CTickProfiler::Now();
+    int           iCacheIdx = INVALID_INDEX;
+    int           iOldest   = 0;
+
+    for ( int i = 0; i < ADMISSION_REFUSAL_CACHE_SIZE; i++ )
+    {
+        if ( vecRefusedAddr[i] == HostAdr )
+        {
+            if ( iNowNs - veciRefusedNs[i] < static_cast<int64_t> ( ADMISSION_REFUSAL_HOLD_MS ) * 1000000 )
+            {
+                return false;
+            }
+
+            iCacheIdx = i;
+            break;
+        }
+
+        if ( veciRefusedNs[i] < veciRefusedNs[iOldest] )
+        {
+            iOldest = i;
+        }
+    }
+
+    // cost of the new client itself
+    float fNewClientCost = AdmissionPrediction.fMeanCost;
+
+    for ( int iSizeIdx = 0; iSizeIdx < AdmissionPrediction.iNumPacketSizes; iSizeIdx++ )
+    {
+        if ( AdmissionPrediction.veciPacketSize[iSizeIdx] == iNumBytesRead )
+        {
+            fNewClientCost = AdmissionPrediction.vecfMeanCost[iSizeIdx];
+            break;
+        }
+    }
+
+    // the clients admitted since the last tick are not yet contained in the prediction
+    const float fPredictedUtilisation =
+        AdmissionPrediction.fBaseUtilisation + ( iNumAdmittedSinceTick + 1 ) * ( fNewClientCost + AdmissionPrediction.fMixGrowth );
+
+    if ( fPredictedUtilisation * 100 <= iAdmissionTargetPercent )
+    {
+        iNumAdmittedSinceTick++;
+
+        if ( iCacheIdx != INVALID_INDEX )
+        {
+            vecRefusedAddr[iCacheIdx] = CHostAddress();
+            veciRefusedNs[iCacheIdx]  = 0;
+        }
+
+        return true;
+    }
+
+    // each refused address is only counted once
+    if ( iCacheIdx == INVALID_INDEX )
+    {
+        iNumAdmissionsRefused.fetch_add ( 1, std::memory_order_relaxed );
+
+        iCacheIdx                 = iOldest;
+        vecRefusedAddr[iCacheIdx] = HostAdr;
+    }
+
+    veciRefusedNs[iCacheIdx] = iNowNs;
+
+    return false;
+}
+
+void CServer::GetClientCostUs ( const int iChanNum, float& fDecodeUs, float& fMixUs, float& fEncodeUs ) const
+{
+    fDecodeUs = vecfChanDecodeCostUs[iChanNum].load ( std::memory_order_relaxed );
+    fMixUs    = vecfChanMixCostUs[iChanNum].load ( std::memory_order_relaxed );
+    fEncodeUs = vecfChanEncodeCostUs[iChanNum].load ( std::memory_order_relaxed );
+}
+
+void CServer::UpdateClientCostUs ( std::atomic<float>& fCostUs, const int64_t iTickCostNs )
+{
+    // each cost is only written by one thread at a time, the tick order is
+    // guaranteed by the worker team barrier
+    const float fOldCostUs = fCostUs.load ( std::memory_order_relaxed );
+
+    fCostUs.store ( fOldCostUs + CLIENT_COST_SMOOTH_FACTOR * ( iTickCostNs / 1000.0f - fOldCostUs ), std::memory_order_relaxed );
+}
+
 void CServer::SetEnableRecording ( bool bNewEnableRecording )
 {
     JamController.SetEnableRecording ( bNewEnableRecording, IsRunning() );
@@ -1669,6 +2916,28 @@ void CServer::customEvent ( QEvent* pEvent )
             // no effect
             Start();
             break;
+
+        case MS_CHAN_DISCONNECTED:
+            OnChannelsDisconnected();
+            break;
+
+        case MS_NO_CLIENTS:
+            // the real-time timer thread found no connected client, a client
+            // may have connected in the meantime
+            bStopRequested = false;
+
+            if ( GetNumberOfConnectedClients() == 0 )
+            {
+                Stop();
+            }
+            break;
+
+        case MS_OVERLOAD_LEVEL_CHANGED:
+            // the level which was set by the tick (the current level may already be different)
+            Logging.AddOverloadLevelChanged ( static_cast<EOverloadLevel> ( ( (CCustomEvent*) pEvent )->iStatus ), GetTickUtilisation() );
+
+            emit OverloadLevelChanged ( ( (CCustomEvent*) pEvent )->iStatus, GetTickUtilisation() );
+            break;
         }
     }
 }
@@ -1676,6 +2945,8 @@ void CServer::customEvent ( QEvent* pEvent )
 /// @brief Compute frame peak level for each client
 bool CServer::CreateLevelsForAllConChannels ( const int iNumClients )
 {
+    CServerFrame& Frame = Frames[iDecFrame];
+
     bool bLevelsWereUpdated = false;
 
     // low frequency updates
@@ -1687,9 +2958,10 @@ bool CServer::CreateLevelsForAllConChannels ( const int iNumClients )
         for ( int j = 0; j < iNumClients; j++ )
         {
             // update and get signal level for meter in dB for each channel
-            const double dCurSigLevelForMeterdB = vecChannels[vecChanIDsCurConChan[j]].UpdateAndGetLevelForMeterdB ( vecvecsData[j],
-                                                                                                                     iServerFrameSizeSamples,
-                                                                                                                     vecNumAudioChannels[j] > 1 );
+            const double dCurSigLevelForMeterdB =
+                vecChannels[Frame.vecChanIDsCurConChan[j]].UpdateAndGetLevelForMeterdB ( Frame.vecvecsData[j],
+                                                                                         iServerFrameSizeSamples,
+                                                                                         Frame.vecNumAudioChannels[j] > 1 );
 
             // map value to integer for transmission via the protocol (4 bit available)
             vecChannelLevels[j] = static_cast<uint16_t> ( std::ceil ( dCurSigLevelForMeterdB ) );
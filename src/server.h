@@ -51,7 +51,10 @@
 #include <QHostAddress>
 #include <QFileInfo>
 #include <algorithm>
+#include <numeric>
 #include <atomic>
+#include <chrono>
+#include <memory>
 #ifdef USE_OPUS_SHARED_LIB
 #    include "opus/opus_custom.h"
 #else
@@ -63,17 +66,113 @@
 #include "socket.h"
 #include "channel.h"
 #include "util.h"
+#include "mixkernels.h"
 #include "serverlogging.h"
 #include "serverlist.h"
 #include "recorder/jamcontroller.h"
-
-#include "threadpool.h"
+#include "rtworkerteam.h"
+#include "channeltable.h"
+#include "tickprofiler.h"
+#include "overloadcontroller.h"
 
 /* Definitions ****************************************************************/
 // no valid channel number
 #define INVALID_CHANNEL_ID ( MAX_NUM_CHANNELS + 1 )
 
+// a-priori processing cost estimation of a new channel for the multithreading
+// work partitioning (in microseconds), later the measured times are used
+#define MT_COST_MIX_US_PER_SOURCE  0.05f
+#define MT_COST_OPUS_US_PER_FRAME  10.0f
+#define MT_COST_OPUS_US_PER_BYTE   0.2f
+#define MT_COST_MEAS_SMOOTH_FACTOR 0.05f
+
+// the channels are only moved to other workers if the imbalance is larger
+// than this part of the average worker load (or the minimum in microseconds)
+#define MT_REBALANCE_REL_HYSTERESIS 0.1f
+#define MT_REBALANCE_MIN_US         5.0f
+
+// a larger timer wakeup lateness is not measured but restarts the ideal tick
+// times (e.g. after the process was suspended), in nanoseconds
+#define PERF_MAX_WAKEUP_LATENESS_NS 1000000000
+
+// smoothing factor of the per client processing cost (time constant of about
+// 200 ticks)
+#define CLIENT_COST_SMOOTH_FACTOR 0.005f
+
+// admission control: the cost of a client which was admitted less than this
+// time ago is not yet contained in the smoothed tick utilisation (the protocol
+// negotiation and the smoothing take some time), its predicted cost is added
+#define ADMISSION_SETTLE_MS 2000
+
+// admission control: number of different audio packet sizes with a separate
+// cost prediction and the recently refused addresses, these are refused again
+// without a new prediction for the hold time (a client sends an audio packet
+// every frame) and are only counted once
+#define ADMISSION_NUM_PACKET_SIZES   8
+#define ADMISSION_REFUSAL_CACHE_SIZE 16
+#define ADMISSION_REFUSAL_HOLD_MS    1000
+
 /* Classes ********************************************************************/
+// Cost prediction of the admission control for a new client, it is calculated
+// by the tick from the measured per client processing cost
+class CAdmissionPrediction
+{
+public:
+    float fBaseUtilisation; // smoothed tick utilisation plus the predicted cost of the settling clients
+    float fMixGrowth;       // utilisation added because each connected listener mixes one more source
+    float fMeanCost;        // mean utilisation of one measured client (or the a-priori estimation)
+    int   iNumPacketSizes;
+    int   veciPacketSize[ADMISSION_NUM_PACKET_SIZES];
+    float vecfMeanCost[ADMISSION_NUM_PACKET_SIZES]; // mean utilisation of the clients with this audio packet size
+};
+
+// Audio and mixer data of one frame which is filled by the decoding and used by
+// the mixing. In pipelined mode the next frame is decoded while the previous
+// frame is mixed, therefore the server has two of them.
+class CServerFrame
+{
+public:
+    CServerFrame() : iNumClients ( 0 ), eOverloadLevel ( OL_NORMAL ) {}
+
+    void Init ( const int iMaxNumChannels );
+
+    int          iNumClients;
+    CVector<int> vecChanIDsCurConChan;
+
+    // the overload level is taken when the frame is decoded so that the
+    // decoding and the mixing of a frame use the same level
+    EOverloadLevel eOverloadLevel;
+
+    CVector<CVector<float>>   vecvecfGains;
+    CVector<CVector<float>>   vecvecfPannings;
+    CVector<CVector<float>>   vecvecfGainsL;
+    CVector<CVector<float>>   vecvecfGainsR;
+    CVector<CVector<int16_t>> vecvecsData;
+    CVector<int>              vecNumAudioChannels;
+    CVector<int>              vecNumFrameSizeConvBlocks;
+    CVector<int>              vecUseDoubleSysFraSizeConvBuf;
+    CVector<EAudComprType>    vecAudioComprType;
+    CVector<int>              vecCeltNumCodedBytes;
+    CVector<CVector<uint8_t>> vecvecbyCodedData;
+
+    // mix-minus: listeners with (mostly) default gain/pan rows get the shared
+    // bus sum of all sources plus correction terms for the non-default sources
+    CVector<int>   vecNumMixMinusCorr; // number of corrections per listener, INVALID_INDEX if full mix is used
+    CVector<float> vecfMixMinusBusMono;
+    CVector<float> vecfMixMinusBusStereo;
+
+    // encode-once: listeners with identical mixes share one mix/encode, the
+    // group leader sends the coded packet to all listeners of the group
+    CVector<uint32_t> vecMixRowHash;
+    CVector<int>      vecMixGroupLeader; // channel counter of the listener which creates the mix
+    CVector<int>      vecMixGroupNext;   // next listener of the same group, INVALID_INDEX at the end
+    CVector<int>      vecMixGroupLast;   // last listener of the group (only valid for group leaders)
+
+    // multithreading: channel counters processed by each worker
+    CVector<int>          vecWorkerNumChans;
+    CVector<CVector<int>> vecvecWorkerChanCnts;
+};
+
 template<unsigned int slotId>
 class CServerSlots : public CServerSlots<slotId - 1>
 {
@@ -127,6 +226,15 @@ public:
               const bool         bNUseMultithreading,
               const bool         bDisableRecording,
               const bool         bNDelayPan,
+              const bool         bNUseMixMinus,
+              const bool         bNUseEncodeOnce,
+              const bool         bNPinCores,
+              const bool         bNUsePipeline,
+              const bool         bNDecodeOnArrival,
+              const int          iNNumRecvSockets,
+              const bool         bNUseRtThread,
+              const bool         bNUseOverloadControl,
+              const int          iNAdmissionTargetPercent,
               const bool         bNDisableIPv6,
               const ELicenceType eNLicenceType );
 
@@ -138,7 +246,7 @@ public:
 
     bool PutAudioData ( const CVector<uint8_t>& vecbyRecBuf, const int iNumBytesRead, const CHostAddress& HostAdr, int& iCurChanID );
 
-    int GetNumberOfConnectedClients();
+    int GetNumberOfConnectedClients() { return ChannelTable.GetNumChannels(); }
 
     void GetConCliParam ( CVector<CHostAddress>&     vecHostAddresses,
                           CVector<QString>&          vecsName,
@@ -152,7 +260,12 @@ public:
     bool IsIPv6Available() { return bIPv6Available; }
 
     // GUI settings ------------------------------------------------------------
-    int GetClientNumAudioChannels ( const int iChanNum ) { return vecChannels[iChanNum].GetNumAudioChannels(); }
+    int           GetClientNumAudioChannels ( const int iChanNum ) { return vecChannels[iChanNum].GetNumAudioChannels(); }
+    EAudComprType GetClientAudioCompressionType ( const int iChanNum ) { return vecChannels[iChanNum].GetAudioCompressionType(); }
+    int           GetClientCeltNumCodedBytes ( const int iChanNum ) { return vecChannels[iChanNum].GetCeltNumCodedBytes(); }
+
+    // rolling average of the processing time per tick of a client in microseconds
+    void GetClientCostUs ( const int iChanNum, float& fDecodeUs, float& fMixUs, float& fEncodeUs ) const;
 
     void           SetDirectoryType ( const EDirectoryType eNCSAT ) { ServerListManager.SetDirectoryType ( eNCSAT ); }
     EDirectoryType GetDirectoryType() { return ServerListManager.GetDirectoryType(); }
@@ -193,6 +306,53 @@ public:
     void SetEnableDelayPanning ( bool bDelayPanningOn ) { bDelayPan = bDelayPanningOn; }
     bool IsDelayPanningEnabled() { return bDelayPan; }
 
+    // statistics
+    qint64 GetNumEncodesSaved() const { return iNumEncodesSaved.load ( std::memory_order_relaxed ); }
+    double GetAvgRecvBatchSize() const { return Socket.GetAvgRecvBatchSize(); }
+    void   GetProtMessageQueueStats ( int& iMaxNumUsed, int64_t& iNumDropped ) const { Socket.GetProtMessageQueueStats ( iMaxNumUsed, iNumDropped ); }
+
+    // additional server latency caused by the pipelined processing
+    double GetPipelineLatencyMs() const { return bUsePipeline ? 1000.0 * iServerFrameSizeSamples / SYSTEM_SAMPLE_RATE_HZ : 0; }
+
+    // timer wakeup lateness since the last server start
+    void GetTimerWakeUpJitter ( double& dAvgUs, double& dMaxUs ) const { HighPrecisionTimer.GetWakeUpJitter ( dAvgUs, dMaxUs ); }
+
+    // per phase timing of the server ticks
+    const CTickProfiler& GetTickProfiler() const { return TickProfiler; }
+    void                 ResetPerfStats() { TickProfiler.Reset(); }
+
+    // graceful degradation if the ticks get close to their deadline
+    float GetTickUtilisation() const { return OverloadController.GetUtilisation(); }
+
+    // new clients are refused if they would overload the server
+    qint64 GetNumAdmissionsRefused() const { return iNumAdmissionsRefused.load ( std::memory_order_relaxed ); }
+
+    // offline operation (e.g. benchmark): the caller runs the ticks instead of
+    // the timer and puts the audio packets of synthetic clients directly
+    int  AddSyntheticClient ( const CHostAddress& InetAddr, const CNetworkTransportProps& NetworkTransportProps, const CChannelCoreInfo& ChanInfo );
+    void RemoveAllClients();
+    void ProcessTick();
+    void SetSendEnabled ( const bool bEnable ) { Socket.SetSendEnabled ( bEnable ); }
+    int  GetServerFrameSizeSamples() const { return iServerFrameSizeSamples; }
+    int  GetMaxNumChannels() const { return iMaxNumChannels; }
+
+    // packet capture and replay: the replay injects the recorded datagrams and
+    // handles the disconnections directly instead of via the event loop
+    void SetPacketCapture ( CPacketCaptureWriter* pNCapture ) { Socket.SetPacketCapture ( pNCapture ); }
+    void InjectPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytes )
+    {
+        Socket.InjectPacket ( vecbyPacket, RecHostAddr, iNumBytes );
+    }
+    void ProcessPendingDisconnects()
+    {
+        if ( bDisconnectEventPending )
+        {
+            OnChannelsDisconnected();
+        }
+    }
+    void EnableAudioDigest() { Socket.EnableAudioDigest(); }
+    void GetAudioDigest ( uint64_t& iDigest, int64_t& iNumPackets ) const { Socket.GetAudioDigest ( iDigest, iNumPackets ); }
+
     void SendChatTextToAllConChannels ( const int iSendingChanID, const QString& strChatText );
     bool SendChatTextToConChannel ( const int iCurChanID, const QString& strChatText );
 
@@ -220,16 +380,60 @@ protected:
     template<unsigned int slotId>
     inline void connectChannelSignalsToServerSlots();
 
-    static void DecodeReceiveDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients );
+    static void DecodeReceiveDataWorker ( void* pArg, const int iWorker );
 
-    static void MixEncodeTransmitDataBlocks ( CServer* pServer, const int iStartChanCnt, const int iStopChanCnt, const int iNumClients );
+    static void MixEncodeTransmitDataWorker ( void* pArg, const int iWorker );
+
+    static void PipelineWorker ( void* pArg, const int iWorker );
+
+    void AssignChannelsToWorkers ( const int iNumClients );
+
+    float EstimateChannelCostUs ( const int iCurChanID, const int iNumClients );
+
+    float EstimateClientCostUs ( const EAudComprType eAudComprType,
+                                 const int           iNumAudioChannels,
+                                 const int           iCeltNumCodedBytes,
+                                 const int           iNumClients );
+
+    void UpdateAdmissionPrediction ( const CServerFrame& Frame, const int iNumClients );
+
+    bool AdmitNewClient ( const CHostAddress& HostAdr, const int iNumBytesRead );
 
     void DecodeReceiveData ( const int iChanCnt, const int iNumClients );
 
-    void MixEncodeTransmitData ( const int iChanCnt, const int iNumClients );
+    OpusCustomDecoder* GetOpusDecoder ( const int           iCurChanID,
+                                        const EAudComprType eAudComprType,
+                                        const int           iNumAudioChannels,
+                                        int&                iClientFrameSizeSamples );
+
+    void DecodeOnArrival ( const int iCurChanID );
+
+    void MixEncodeTransmitData ( const int iChanCnt, const int iNumClients, const int iWorker );
+
+    void ClassifyMixMinusRow ( const int iChanCnt, const int iNumClients );
+
+    void CreateMixMinusBus ( const int iNumClients );
+
+    void MixFromMixMinusBus ( const int iChanCnt, const int iNumClients );
+
+    void CalcMixRowHash ( const int iChanCnt, const int iNumClients );
+
+    bool IsSameMix ( const int iChanCnt, const int iOtherChanCnt, const int iNumClients );
+
+    void GroupIdenticalMixes ( const int iNumClients );
+
+    void SendMixToGroup ( const int iChanCnt, const int iNumCodedBytes, CSocketSendBatch& SendBatch );
 
     virtual void customEvent ( QEvent* pEvent );
 
+    void OnChannelsDisconnected();
+
+    static void UpdateClientCostUs ( std::atomic<float>& fCostUs, const int64_t iTickCostNs );
+
+    void ApplyOverloadLevel ( const EOverloadLevel eNewLevel );
+
+    void SetEncoderComplexity ( const int iChanID, const bool bLowComplexity );
+
     void CreateAndSendRecorderStateForAllConChannels();
 
     // if server mode is normal or double system frame size
@@ -237,9 +441,15 @@ protected:
     int  iServerFrameSizeSamples;
 
     // variables needed for multithreading support
-    bool                       bUseMultithreading;
-    int                        iMaxNumThreads;
-    CVector<std::future<void>> Futures;
+    bool                           bUseMultithreading;
+    bool                           bPinCores;
+    std::unique_ptr<CRtWorkerTeam> pWorkerTeam;
+    CVector<int>                   vecChanIDWorker;
+    CVector<float>                 vecfWorkerLoadUs;
+    CVector<float>                 vecfChanCostUs;
+    CVector<float>                 vecfChanTickCostUs;
+    CVector<float>                 vecfChanMixTickCostUs; // separate since a moved channel may be mixed and decoded at the same time
+    CVector<int>                   vecNewChanCnts;
 
     bool CreateLevelsForAllConChannels ( const int iNumClients );
 
@@ -248,15 +458,35 @@ protected:
     CChannel vecChannels[MAX_NUM_CHANNELS];
     int      iMaxNumChannels;
 
-    int    iCurNumChannels;
-    int    vecChannelOrder[MAX_NUM_CHANNELS];
-    QMutex MutexChanOrder;
+    // lookup of the channel ID by the client address, the table is only
+    // modified with MutexChanTable locked
+    CChannelTable ChannelTable;
+    QMutex        MutexChanTable;
 
+    // The control plane (protocol messages, connection less messages, channel
+    // allocation and the writers of the mix row snapshots) is serialised by
+    // MutexControl. The tick never takes this mutex.
     CProtocol         ConnLessProtocol;
-    QMutex            Mutex;
+    QMutex            MutexControl;
     QMutex            MutexWelcomeMessage;
     std::atomic<bool> bChannelIsNowDisconnected;
 
+    // channels which were disconnected in the tick, they are freed by the
+    // main thread (see OnChannelsDisconnected)
+    std::atomic<bool> vecbDisconnectPending[MAX_NUM_CHANNELS];
+    std::atomic<bool> bDisconnectEventPending;
+
+    // the conversion buffers are only used by the tick, a new connection
+    // requests their reset which is done by the next decoding of the channel
+    std::atomic<bool> vecbConvBufResetPending[MAX_NUM_CHANNELS];
+
+    // processing cost of each client, the decoding on arrival is accumulated
+    // until the next tick adds it to the decoding cost
+    std::atomic<int64_t> veciChanArrivalDecodeNs[MAX_NUM_CHANNELS];
+    std::atomic<float>   vecfChanDecodeCostUs[MAX_NUM_CHANNELS];
+    std::atomic<float>   vecfChanMixCostUs[MAX_NUM_CHANNELS];
+    std::atomic<float>   vecfChanEncodeCostUs[MAX_NUM_CHANNELS];
+
     // audio encoder/decoder
     OpusCustomMode*    Opus64Mode[MAX_NUM_CHANNELS];
     OpusCustomEncoder* Opus64EncoderMono[MAX_NUM_CHANNELS];
@@ -268,6 +498,8 @@ protected:
     OpusCustomDecoder* OpusDecoderMono[MAX_NUM_CHANNELS];
     OpusCustomEncoder* OpusEncoderStereo[MAX_NUM_CHANNELS];
     OpusCustomDecoder* OpusDecoderStereo[MAX_NUM_CHANNELS];
+    bool               vecbEncoderLowComplexity[MAX_NUM_CHANNELS]; // overload complexity of the encoders, only used by the tick
+    QMutex             MutexDecoder[MAX_NUM_CHANNELS]; // decode-on-arrival and the tick may use a decoder at the same time
     CConvBuf<int16_t>  DoubleFrameSizeConvBufIn[MAX_NUM_CHANNELS];
     CConvBuf<int16_t>  DoubleFrameSizeConvBufOut[MAX_NUM_CHANNELS];
 
@@ -275,19 +507,32 @@ protected:
     bool bDisableRaw;
 
     CVector<QString> vstrChatColors;
-    CVector<int>     vecChanIDsCurConChan;
 
-    CVector<CVector<float>>   vecvecfGains;
-    CVector<CVector<float>>   vecvecfPannings;
-    CVector<CVector<int16_t>> vecvecsData;
+    // frame which is decoded and frame which is mixed in the current tick
+    // (these are the same if pipelining is not used)
+    CServerFrame Frames[2];
+    int          iDecFrame;
+    int          iMixFrame;
+    bool         bUsePipeline;
+
+    // decode-on-arrival: packets are decoded by the socket thread when they
+    // are received, only lost packets are concealed in the tick
+    bool bDecodeOnArrival;
+
     CVector<CVector<int16_t>> vecvecsData2;
-    CVector<int>              vecNumAudioChannels;
-    CVector<int>              vecNumFrameSizeConvBlocks;
-    CVector<int>              vecUseDoubleSysFraSizeConvBuf;
-    CVector<EAudComprType>    vecAudioComprType;
     CVector<CVector<int16_t>> vecvecsSendData;
     CVector<CVector<float>>   vecvecfIntermediateProcBuf;
-    CVector<CVector<uint8_t>> vecvecbyCodedData;
+
+    // audio packets are collected per worker and sent at the end of its mix
+    CVector<CSocketSendBatch> vecSendBatches;
+
+    // audio mix kernels (SIMD implementation is selected at runtime)
+    const CMixKernels& MixKernels;
+
+    // mix-minus and encode-once settings (see CServerFrame)
+    bool                bUseMixMinus;
+    bool                bUseEncodeOnce;
+    std::atomic<qint64> iNumEncodesSaved;
 
     // Channel levels
     CVector<uint16_t> vecChannelLevels;
@@ -304,6 +549,36 @@ protected:
 
     CHighPrecisionTimer HighPrecisionTimer;
 
+    // in real-time mode the timer thread requests the stop from the main thread
+    std::atomic<bool> bStopRequested;
+
+    // per phase timing of the ticks, the wakeup lateness is measured against
+    // the ideal tick times which start with the first tick after a server start
+    CTickProfiler TickProfiler;
+    int64_t       iNextTickNs;
+
+    // overload control: the levels are applied by the tick (see
+    // EOverloadLevel), the number of frames in which an input was silent is
+    // needed for the last level
+    bool                bUseOverloadControl;
+    COverloadController OverloadController;
+    opus_int32          iOpus64DefaultComplexity;
+    int                 iSilentInputFrames;
+    int                 veciChanSilentFrames[MAX_NUM_CHANNELS];
+
+    // admission control: a new client is refused if the predicted tick
+    // utilisation exceeds the target (zero if not used), the tick utilisation
+    // is measured by the overload controller and the prediction is published
+    // by the tick (the tick only tries to lock the mutex and never waits)
+    int                  iAdmissionTargetPercent;
+    std::atomic<qint64>  iNumAdmissionsRefused;
+    std::atomic<int64_t> veciChanAdmissionNs[MAX_NUM_CHANNELS];
+    QMutex               MutexAdmission;
+    CAdmissionPrediction AdmissionPrediction;
+    int                  iNumAdmittedSinceTick;
+    CHostAddress         vecRefusedAddr[ADMISSION_REFUSAL_CACHE_SIZE];
+    int64_t              veciRefusedNs[ADMISSION_REFUSAL_CACHE_SIZE];
+
     // server list
     CServerListManager ServerListManager;
 
@@ -324,8 +599,6 @@ protected:
 
     CSignalHandler* pSignalHandler;
 
-    std::unique_ptr<CThreadPool> pThreadPool;
-
 signals:
     void Started();
     void Stopped();
@@ -333,6 +606,7 @@ signals:
     void ClientConnected ( const int iChID, const QHostAddress RecHostAddr, const int iTotChans );
     void sentChatMessage ( const int iSendingChanID, const QString& strChatText );
     void SvrRegStatusChanged();
+    void OverloadLevelChanged ( const int iLevel, const float fUtilisation );
     void AudioFrame ( const int              iChID,
                       const QString          stChName,
                       const CHostAddress     RecHostAddr,
@@ -356,9 +630,9 @@ public slots:
 
     void OnSendCLProtMessage ( CHostAddress InetAddr, CVector<uint8_t> vecMessage );
 
-    void OnProtocolCLMessageReceived ( int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr );
+    void OnProtocolCLMessageReceived ( int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr );
 
-    void OnProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress RecHostAddr );
+    void OnProtocolMessageReceived ( int iRecCounter, int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& RecHostAddr );
 
     void OnCLPingReceived ( CHostAddress InetAddr, int iMs ) { ConnLessProtocol.CreateCLPingMes ( InetAddr, iMs ); }
 
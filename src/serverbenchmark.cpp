@@ -0,0 +1,310 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "serverbenchmark.h"
+#include <QStringList>
+
+/* Implementation *************************************************************/
+CServerBenchmark::CServerBenchmark ( CServer* pNServer, const int iNNumClients, const int iNNumFrames, const QString& strMix ) :
+    pServer ( pNServer ),
+    iNumClients ( iNNumClients ),
+    iNumFrames ( iNNumFrames )
+{
+    ParseMix ( strMix );
+
+    for ( int i = 0; i < vecClientTypes.Size(); i++ )
+    {
+        EncodeFrames ( vecClientTypes[i] );
+    }
+
+    // the packets of the mixes go nowhere
+    pServer->SetSendEnabled ( false );
+}
+
+void CServerBenchmark::ParseMix ( const QString& strMix )
+{
+    const QStringList slTypes = strMix.split ( "," );
+
+    for ( int i = 0; i < slTypes.size(); i++ )
+    {
+        const QString     strType = slTypes[i].trimmed().toLower();
+        const QStringList slParts = strType.split ( "-" );
+        CClientType       ClientType;
+
+        if ( ( slParts.size() != 2 ) || ( ( slParts[0] != "opus" ) && ( slParts[0] != "opus64" ) ) ||
+             ( ( slParts[1] != "mono" ) && ( slParts[1] != "stereo" ) ) )
+        {
+            throw CGenErr ( QString ( "Invalid benchmark client type '%1', use [opus|opus64]-[mono|stereo]" ).arg ( slTypes[i] ) );
+        }
+
+        ClientType.strName           = strType;
+        ClientType.eAudComprType     = ( slParts[0] == "opus" ) ? CT_OPUS : CT_OPUS64;
+        ClientType.iNumAudioChannels = ( slParts[1] == "mono" ) ? 1 : 2;
+
+        // the clients use the default audio quality
+        ClientType.iOpusFrameSizeSamples = COpusCoding::GetFrameSizeSamples ( ClientType.eAudComprType );
+        ClientType.iCeltNumCodedBytes    = COpusCoding::GetNumCodedBytes ( ClientType.eAudComprType, ClientType.iNumAudioChannels, AQ_NORMAL );
+
+        vecClientTypes.Add ( ClientType );
+    }
+}
+
+void CServerBenchmark::EncodeFrames ( CClientType& ClientType )
+{
+    const int          iFrameSizeSamples = ClientType.iOpusFrameSizeSamples;
+    const int          iNumAudioChannels = ClientType.iNumAudioChannels;
+    int                iOpusError;
+    OpusCustomMode*    OpusMode    = opus_custom_mode_create ( SYSTEM_SAMPLE_RATE_HZ, iFrameSizeSamples, &iOpusError );
+    OpusCustomEncoder* OpusEncoder = opus_custom_encoder_create ( OpusMode, iNumAudioChannels, &iOpusError );
+
+    // same encoder settings and test signal as in the load generator
+    COpusCoding::InitEncoder ( OpusEncoder, ClientType.eAudComprType );
+    COpusCoding::SetEncoderBitRate ( OpusEncoder, ClientType.eAudComprType, ClientType.iCeltNumCodedBytes );
+
+    CVector<int16_t> vecsAudio ( BENCHMARK_NUM_PREENCODED_FRAMES * iFrameSizeSamples * iNumAudioChannels );
+
+    COpusCoding::GetTestSignal ( vecsAudio, iNumAudioChannels );
+
+    ClientType.vecvecbyCodedFrames.Init ( BENCHMARK_NUM_PREENCODED_FRAMES );
+
+    for ( int iFrame = 0; iFrame < BENCHMARK_NUM_PREENCODED_FRAMES; iFrame++ )
+    {
+        ClientType.vecvecbyCodedFrames[iFrame].Init ( ClientType.iCeltNumCodedBytes );
+
+        opus_custom_encode ( OpusEncoder,
+                             &vecsAudio[iFrame * iFrameSizeSamples * iNumAudioChannels],
+                             iFrameSizeSamples,
+                             &ClientType.vecvecbyCodedFrames[iFrame][0],
+                             ClientType.iCeltNumCodedBytes );
+    }
+
+    opus_custom_encoder_destroy ( OpusEncoder );
+    opus_custom_mode_destroy ( OpusMode );
+}
+
+void CServerBenchmark::AddClients ( const int iNewNumClients )
+{
+    vecClients.Init ( iNewNumClients );
+
+    for ( int i = 0; i < iNewNumClients; i++ )
+    {
+        CClient&           Client     = vecClients[i];
+        const CClientType& ClientType = vecClientTypes[i % vecClientTypes.Size()];
+
+        Client.iType    = i % vecClientTypes.Size();
+        Client.InetAddr = CHostAddress ( QHostAddress ( QHostAddress::LocalHost ), static_cast<quint16> ( BENCHMARK_FIRST_CLIENT_PORT + i ) );
+        Client.iFrame   = ( 7 * i ) % BENCHMARK_NUM_PREENCODED_FRAMES;
+
+        // the packets carry a sequence number like the packets of current clients
+        Client.vecbyPacket.Init ( ClientType.iCeltNumCodedBytes + 1 );
+
+        const CNetworkTransportProps NetworkTransportProps ( static_cast<uint32_t> ( ClientType.iCeltNumCodedBytes + 1 ),
+                                                             1,
+                                                             static_cast<uint32_t> ( ClientType.iNumAudioChannels ),
+                                                             SYSTEM_SAMPLE_RATE_HZ,
+                                                             ClientType.eAudComprType,
+                                                             NF_WITH_COUNTER,
+                                                             0 );
+
+        const CChannelCoreInfo
+            ChanInfo ( QString ( "Benchmark %1" ).arg ( i + 1 ), QLocale::AnyCountry, "", CInstPictures::GetNotUsedInstrument(), SL_NOT_SET );
+
+        if ( pServer->AddSyntheticClient ( Client.InetAddr, NetworkTransportProps, ChanInfo ) == INVALID_CHANNEL_ID )
+        {
+            throw CGenErr ( QString ( "The server has no free channel for benchmark client %1" ).arg ( i + 1 ) );
+        }
+    }
+}
+
+void CServerBenchmark::PutClientPackets()
+{
+    const int iServerFrameSizeSamples = pServer->GetServerFrameSizeSamples();
+    int       iCurChanID;
+
+    // each client puts as many packets as the next tick consumes (a 128 samples
+    // tick consumes two OPUS64 packets, a 64 samples tick consumes an OPUS
+    // packet only every second tick)
+    for ( int i = 0; i < vecClients.Size(); i++ )
+    {
+        CClient&           Client     = vecClients[i];
+        const CClientType& ClientType = vecClientTypes[Client.iType];
+
+        Client.iDueSamples += iServerFrameSizeSamples;
+
+        while ( Client.iDueSamples >= ClientType.iOpusFrameSizeSamples )
+        {
+            const CVector<uint8_t>& vecbyCodedFrame = ClientType.vecvecbyCodedFrames[Client.iFrame];
+
+            std::copy ( vecbyCodedFrame.begin(), vecbyCodedFrame.end(), Client.vecbyPacket.begin() );
+            Client.vecbyPacket[ClientType.iCeltNumCodedBytes] = Client.iSequenceNumber++;
+
+            pServer->PutAudioData ( Client.vecbyPacket, Client.vecbyPacket.Size(), Client.InetAddr, iCurChanID );
+
+            Client.iFrame = ( Client.iFrame + 1 ) % BENCHMARK_NUM_PREENCODED_FRAMES;
+            Client.iDueSamples -= ClientType.iOpusFrameSizeSamples;
+        }
+    }
+}
+
+double CServerBenchmark::Measure ( const int iNewNumClients, const int iNewNumFrames )
+{
+    AddClients ( iNewNumClients );
+
+    for ( int i = 0; i < BENCHMARK_NUM_WARMUP_FRAMES; i++ )
+    {
+        PutClientPackets();
+        pServer->ProcessTick();
+    }
+
+    FrameHistogram.Reset();
+    pServer->ResetPerfStats();
+
+    const int64_t iStartNs = CTickProfiler::Now();
+
+    for ( int i = 0; i < iNewNumFrames; i++ )
+    {
+        const int64_t iFrameStartNs = CTickProfiler::Now();
+
+        // with decoding on arrival, putting the packets includes the decoding
+        PutClientPackets();
+        pServer->ProcessTick();
+
+        FrameHistogram.Record ( CTickProfiler::Now() - iFrameStartNs );
+    }
+
+    // frames per second
+    return 1e9 * iNewNumFrames / std::max ( CTickProfiler::Now() - iStartNs, static_cast<int64_t> ( 1 ) );
+}
+
+bool CServerBenchmark::FitsInBudget ( const int iNewNumClients )
+{
+    Measure ( iNewNumClients, BENCHMARK_NUM_SEARCH_FRAMES );
+    pServer->RemoveAllClients();
+
+    const CPerfHistogram* pHistogram = &FrameHistogram;
+    const double          dP99Us     = CPerfHistogram::Summarize ( &pHistogram, 1 ).dP99Us;
+    const bool            bFits      = dP99Us <= pServer->GetTickProfiler().GetDeadlineNs() / 1000.0;
+
+    qInfo() << qUtf8Printable (
+        QString ( "- %1 clients: p99 %2 us per frame -> %3" ).arg ( iNewNumClients ).arg ( dP99Us, 0, 'f', 1 ).arg ( bFits ? "fits" : "too slow" ) );
+
+    return bFits;
+}
+
+void CServerBenchmark::Run()
+{
+    const CTickProfiler&  TickProfiler = pServer->GetTickProfiler();
+    const double          dBudgetUs    = TickProfiler.GetDeadlineNs() / 1000.0;
+    const CPerfHistogram* pHistogram   = &FrameHistogram;
+    QStringList           slTypeNames;
+
+    for ( int i = 0; i < vecClientTypes.Size(); i++ )
+    {
+        slTypeNames << vecClientTypes[i].strName;
+    }
+
+    qInfo() << qUtf8Printable ( QString ( "- benchmark: %1 clients (%2), %3 frames of %4 samples, budget %5 us per frame, %6 worker(s)" )
+                                    .arg ( iNumClients )
+                                    .arg ( slTypeNames.join ( ", " ) )
+                                    .arg ( iNumFrames )
+                                    .arg ( pServer->GetServerFrameSizeSamples() )
+                                    .arg ( dBudgetUs, 0, 'f', 0 )
+                                    .arg ( TickProfiler.GetNumWorkers() ) );
+
+    // measurement with the requested number of clients ------------------------
+    const double                dFramesPerSec = Measure ( iNumClients, iNumFrames );
+    const CPerfHistogramSummary Summary       = CPerfHistogram::Summarize ( &pHistogram, 1 );
+
+    qInfo() << qUtf8Printable ( QString ( "- %1 frames/s (%2x real time), mean %3 us per frame, %4 us per frame per client" )
+                                    .arg ( dFramesPerSec, 0, 'f', 0 )
+                                    .arg ( dFramesPerSec * dBudgetUs / 1e6, 0, 'f', 1 )
+                                    .arg ( Summary.dMeanUs, 0, 'f', 1 )
+                                    .arg ( Summary.dMeanUs / iNumClients, 0, 'f', 2 ) );
+
+    qInfo() << qUtf8Printable ( QString ( "- frame time p50 %1 us, p99 %2 us, p99.9 %3 us, max %4 us" )
+                                    .arg ( Summary.dP50Us, 0, 'f', 1 )
+                                    .arg ( Summary.dP99Us, 0, 'f', 1 )
+                                    .arg ( Summary.dP999Us, 0, 'f', 1 )
+                                    .arg ( Summary.dMaxUs, 0, 'f', 1 ) );
+
+    // the phases are measured per worker
+    for ( int iPhase = PP_DECODE; iPhase <= PP_ENCODE; iPhase++ )
+    {
+        const EPerfPhase            ePhase       = static_cast<EPerfPhase> ( iPhase );
+        const CPerfHistogramSummary PhaseSummary = TickProfiler.GetSummaryAllWorkers ( ePhase );
+
+        qInfo() << qUtf8Printable ( QString ( "- %1: mean %2 us, p99 %3 us per frame and worker" )
+                                        .arg ( CTickProfiler::GetPhaseName ( ePhase ) )
+                                        .arg ( PhaseSummary.dMeanUs, 0, 'f', 1 )
+                                        .arg ( PhaseSummary.dP99Us, 0, 'f', 1 ) );
+    }
+
+    pServer->RemoveAllClients();
+
+    // search for the maximum number of clients --------------------------------
+    // binary search for the largest number of clients with the 99th percentile
+    // of the frame time within the budget (the time per frame grows with the
+    // number of clients)
+    int iMinNumClients = 0;
+    int iMaxNumClients = pServer->GetMaxNumChannels();
+
+    while ( iMinNumClients < iMaxNumClients )
+    {
+        const int iTestNumClients = ( iMinNumClients + iMaxNumClients + 1 ) / 2;
+
+        if ( FitsInBudget ( iTestNumClients ) )
+        {
+            iMinNumClients = iTestNumClients;
+        }
+        else
+        {
+            iMaxNumClients = iTestNumClients - 1;
+        }
+    }
+
+    qInfo() << qUtf8Printable (
+        QString ( "- maximum number of clients within the budget of %1 us: %2" ).arg ( dBudgetUs, 0, 'f', 0 ).arg ( iMinNumClients ) );
+}
@@ -0,0 +1,130 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <QString>
+#include "global.h"
+#include "util.h"
+#include "server.h"
+#include "tickprofiler.h"
+
+/* Definitions ****************************************************************/
+// default number of measured frames and default mix of synthetic clients
+#define BENCHMARK_DEFAULT_NUM_FRAMES 10000
+#define BENCHMARK_DEFAULT_MIX        "opus64-mono,opus64-stereo"
+
+// number of pre-encoded frames per client type, the clients start at
+// different positions of this sequence
+#define BENCHMARK_NUM_PREENCODED_FRAMES 200
+
+// frames before each measurement (the jitter buffers and the work partitioning
+// of the workers settle) and measured frames per step of the search for the
+// maximum number of clients
+#define BENCHMARK_NUM_WARMUP_FRAMES 200
+#define BENCHMARK_NUM_SEARCH_FRAMES 1000
+
+// the synthetic clients use local addresses with consecutive port numbers
+#define BENCHMARK_FIRST_CLIENT_PORT 10000
+
+/* Classes ********************************************************************/
+// Offline benchmark of the mix engine of the server. Synthetic clients are
+// added to the server, their pre-encoded audio packets are put directly into
+// the jitter buffers and the server ticks are run as fast as possible. No
+// network packet is sent, i.e. the decoding, mixing and encoding is measured
+// but not the socket.
+class CServerBenchmark
+{
+public:
+    // the mix is a comma separated list of client types, e.g.
+    // "opus64-stereo,opus-mono", which are assigned to the clients in turn
+    CServerBenchmark ( CServer* pNServer, const int iNNumClients, const int iNNumFrames, const QString& strMix );
+
+    void Run();
+
+protected:
+    // type of synthetic client with its pre-encoded frames
+    class CClientType
+    {
+    public:
+        CClientType() : eAudComprType ( CT_OPUS64 ), iNumAudioChannels ( 1 ), iCeltNumCodedBytes ( 0 ), iOpusFrameSizeSamples ( 0 ) {}
+
+        QString                   strName;
+        EAudComprType             eAudComprType;
+        int                       iNumAudioChannels;
+        int                       iCeltNumCodedBytes;
+        int                       iOpusFrameSizeSamples;
+        CVector<CVector<uint8_t>> vecvecbyCodedFrames;
+    };
+
+    class CClient
+    {
+    public:
+        CClient() : iType ( 0 ), iFrame ( 0 ), iDueSamples ( 0 ), iSequenceNumber ( 0 ) {}
+
+        int              iType;
+        CHostAddress     InetAddr;
+        int              iFrame;      // next frame of the pre-encoded sequence
+        int              iDueSamples; // samples which must be put before the next tick
+        uint8_t          iSequenceNumber;
+        CVector<uint8_t> vecbyPacket;
+    };
+
+    void ParseMix ( const QString& strMix );
+    void EncodeFrames ( CClientType& ClientType );
+
+    void   AddClients ( const int iNewNumClients );
+    void   PutClientPackets();
+    double Measure ( const int iNewNumClients, const int iNewNumFrames );
+    bool   FitsInBudget ( const int iNewNumClients );
+
+    CServer*             pServer;
+    int                  iNumClients;
+    int                  iNumFrames;
+    CVector<CClientType> vecClientTypes;
+    CVector<CClient>     vecClients;
+    CPerfHistogram       FrameHistogram; // duration of putting the packets and processing one tick
+};
@@ -98,7 +98,7 @@ CServerListEntry CServerListEntry::parse ( QString strHAddr,
     NetworkUtil::ParseNetworkAddress ( strLHAddr, haServerLocalAddr, bIPv6Available );
     if ( haServerLocalAddr.iPort == 0 )
     {
-        haServerLocalAddr.iPort = haServerHostAddr.iPort;
+        haServerLocalAddr.SetPort ( haServerHostAddr.iPort );
     }
 
     // Capture parsing success of integers
@@ -162,7 +162,7 @@ CServerListManager::CServerListManager ( CServer*       pServer,
     iSvrRegRetries ( 0 )
 {
 
-    CHostAddress haServerAddr ( NetworkUtil::GetLocalAddress().InetAddr, iNPortNum );
+    CHostAddress haServerAddr ( NetworkUtil::GetLocalAddress().GetQHostAddress(), iNPortNum );
 
     // set the server internal address, including internal port number
     QHostAddress qhaServerPublicIP;
@@ -170,7 +170,7 @@ CServerListManager::CServerListManager ( CServer*       pServer,
     if ( strServerPublicIP == "" )
     {
         // No user-supplied override via --serverpublicip -> use auto-detection
-        qhaServerPublicIP = haServerAddr.InetAddr;
+        qhaServerPublicIP = haServerAddr.GetQHostAddress();
     }
     else
     {
@@ -185,7 +185,7 @@ CServerListManager::CServerListManager ( CServer*       pServer,
         // set the server internal address, including internal port number
         QHostAddress qhaServerPublicIP6;
 
-        qhaServerPublicIP6 = NetworkUtil::GetLocalAddress6().InetAddr;
+        qhaServerPublicIP6 = NetworkUtil::GetLocalAddress6().GetQHostAddress();
         qDebug() << "Using" << qhaServerPublicIP6.toString() << "as external IPv6.";
         ServerPublicIP6 = CHostAddress ( qhaServerPublicIP6, iNPortNum );
     }
@@ -581,7 +581,7 @@ void CServerListManager::Append ( const CHostAddress&    InetAddr,
     if ( bIsDirectory )
     {
         // if the client IP address is a private one, it's on the same LAN as the directory
-        bool serverIsExternal = !NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr );
+        bool serverIsExternal = !NetworkUtil::IsPrivateNetworkIP ( InetAddr.GetQHostAddress() );
 
         qInfo() << qUtf8Printable ( QString ( "Requested to register entry for %1 (%2): %3 (%4)" )
                                         .arg ( InetAddr.toString() )
@@ -606,7 +606,7 @@ void CServerListManager::Append ( const CHostAddress&    InetAddr,
         if ( !vWhiteList.empty() )
         {
             // if the server is not listed, refuse registration and send registration response
-            if ( !vWhiteList.contains ( InetAddr.InetAddr ) )
+            if ( !vWhiteList.contains ( InetAddr.GetQHostAddress() ) )
             {
                 pConnLessProtocol->CreateCLRegisterServerResp ( InetAddr, SRR_NOT_FULFILL_REQUIREMENTS );
                 return; // leave function early, i.e., we do not register this server
@@ -692,15 +692,15 @@ void CServerListManager::RetrieveAll ( const CHostAddress& InetAddr )
     if ( bIsDirectory )
     {
         // if the client IP address is a private one, it's on the same LAN as the directory
-        bool clientIsInternal = NetworkUtil::IsPrivateNetworkIP ( InetAddr.InetAddr );
+        bool clientIsInternal = NetworkUtil::IsPrivateNetworkIP ( InetAddr.GetQHostAddress() );
 
         CHostAddress clientPublicAddr = InetAddr;
-        if ( clientIsInternal && CHostAddress().InetAddr != ServerList[0].LHostAddr.InetAddr &&
-             !NetworkUtil::IsPrivateNetworkIP ( ServerList[0].LHostAddr.InetAddr ) )
+        if ( clientIsInternal && !CHostAddress().HasSameIP ( ServerList[0].LHostAddr ) &&
+             !NetworkUtil::IsPrivateNetworkIP ( ServerList[0].LHostAddr.GetQHostAddress() ) )
         {
             // client and directory on same LAN, directory has public IP set, that should be suitable for the
             // client, too (i.e. same router with same public IP will be used for both), so use it for client public IP
-            clientPublicAddr.InetAddr = ServerList[0].LHostAddr.InetAddr;
+            clientPublicAddr.SetIPv6 ( ServerList[0].LHostAddr.byAddr, clientPublicAddr.iPort, ServerList[0].LHostAddr.iScopeId );
         }
 
         const ushort iCurServerListSize = static_cast<ushort> ( ServerList.size() );
@@ -719,11 +719,11 @@ void CServerListManager::RetrieveAll ( const CHostAddress& InetAddr )
             // copy list item
             CServerInfo& siCurListEntry = vecServerInfo[iIdx] = ServerList[iIdx];
 
-            bool serverIsInternal = NetworkUtil::IsPrivateNetworkIP ( siCurListEntry.HostAddr.InetAddr );
+            bool serverIsInternal = NetworkUtil::IsPrivateNetworkIP ( siCurListEntry.HostAddr.GetQHostAddress() );
 
             bool wantHostAddr = clientIsInternal /* HostAddr is local IP if local server else external IP, so do not replace */ ||
                                 ( !serverIsInternal &&
-                                  InetAddr.InetAddr != siCurListEntry.HostAddr.InetAddr /* external server and client have different public IPs */ );
+                                  !InetAddr.HasSameIP ( siCurListEntry.HostAddr ) /* external server and client have different public IPs */ );
 
             if ( !wantHostAddr )
             {
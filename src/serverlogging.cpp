@@ -86,6 +86,16 @@ void CServerLogging::AddServerStopped()
     *this << strLogStr;                      // in log file
 }
 
+void CServerLogging::AddOverloadLevelChanged ( const EOverloadLevel eLevel, const float fUtilisation )
+{
+    const QString strLevel  = QString ( "%1 (%2)" ).arg ( eLevel ).arg ( COverloadController::GetLevelName ( eLevel ) );
+    const QString strLoad   = QString::number ( static_cast<int> ( fUtilisation * 100 ) );
+    const QString strLogStr = CurTimeDatetoLogString() + ",, overload level " + strLevel + ", tick utilisation " + strLoad + " %";
+
+    qInfo() << qUtf8Printable ( strLogStr ); // on console
+    *this << strLogStr;                      // in log file
+}
+
 void CServerLogging::operator<< ( const QString& sNewStr )
 {
     if ( bDoLogging )
@@ -53,6 +53,7 @@
 #include <QTimer>
 #include "global.h"
 #include "util.h"
+#include "overloadcontroller.h"
 
 /* Classes ********************************************************************/
 class CServerLogging
@@ -64,6 +65,7 @@ public:
 
     void Start ( const QString& strLoggingFileName );
     void AddServerStopped();
+    void AddOverloadLevelChanged ( const EOverloadLevel eLevel, const float fUtilisation );
 
     void AddNewConnection ( const QHostAddress& ClientInetAddr, const int iNumberOfConnectedClients );
     bool IsLogging() { return bDoLogging; }
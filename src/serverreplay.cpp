@@ -0,0 +1,135 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "serverreplay.h"
+
+/* Implementation *************************************************************/
+CServerReplay::CServerReplay ( CServer* pNServer, CPacketCaptureReader* pNReader ) : pServer ( pNServer ), pReader ( pNReader )
+{
+    // the packets to the recorded clients go nowhere
+    pServer->SetSendEnabled ( false );
+    pServer->EnableAudioDigest();
+}
+
+void CServerReplay::Run()
+{
+    const int64_t    iFrameSizeSamples = pServer->GetServerFrameSizeSamples();
+    CVector<uint8_t> vecbyPacket ( MAX_SIZE_BYTES_NETW_BUF );
+    CHostAddress     HostAddr;
+    int64_t          iPacketTimeNs  = 0;
+    int              iNumBytes      = 0;
+    int64_t          iNumPackets    = 0;
+    int64_t          iNumTicks      = 0;
+    int              iMaxNumClients = 0;
+
+    // virtual time at which the server was started and number of ticks since
+    int64_t iWakeUpTimeNs        = 0;
+    int64_t iNumTicksSinceWakeUp = 0;
+
+    qInfo() << qUtf8Printable ( QString ( "- replay of a packet capture with a frame size of %1 samples" ).arg ( iFrameSizeSamples ) );
+
+    pServer->ResetPerfStats();
+
+    const int64_t iStartNs    = CTickProfiler::Now();
+    bool          bHavePacket = pReader->ReadPacket ( iPacketTimeNs, HostAddr, vecbyPacket, iNumBytes );
+
+    while ( bHavePacket )
+    {
+        if ( pServer->GetNumberOfConnectedClients() == 0 )
+        {
+            // the server sleeps until the next datagram is received, an audio
+            // packet of a new client starts the timer
+            pServer->InjectPacket ( vecbyPacket, HostAddr, iNumBytes );
+            iNumPackets++;
+
+            iWakeUpTimeNs        = iPacketTimeNs;
+            iNumTicksSinceWakeUp = 0;
+            bHavePacket          = pReader->ReadPacket ( iPacketTimeNs, HostAddr, vecbyPacket, iNumBytes );
+            continue;
+        }
+
+        // the time of the next tick is calculated from the start of the timer
+        // so that the rounding errors do not add up
+        iNumTicksSinceWakeUp++;
+
+        const int64_t iTickTimeNs = iWakeUpTimeNs + iNumTicksSinceWakeUp * iFrameSizeSamples * 1000000000 / SYSTEM_SAMPLE_RATE_HZ;
+
+        while ( bHavePacket && ( iPacketTimeNs <= iTickTimeNs ) )
+        {
+            pServer->InjectPacket ( vecbyPacket, HostAddr, iNumBytes );
+            iNumPackets++;
+
+            bHavePacket = pReader->ReadPacket ( iPacketTimeNs, HostAddr, vecbyPacket, iNumBytes );
+        }
+
+        iMaxNumClients = std::max ( iMaxNumClients, pServer->GetNumberOfConnectedClients() );
+
+        pServer->ProcessTick();
+        pServer->ProcessPendingDisconnects();
+        iNumTicks++;
+    }
+
+    const int64_t iWallTimeNs = std::max ( CTickProfiler::Now() - iStartNs, static_cast<int64_t> ( 1 ) );
+
+    uint64_t iDigest;
+    int64_t  iNumAudioPackets;
+
+    pServer->GetAudioDigest ( iDigest, iNumAudioPackets );
+
+    qInfo() << qUtf8Printable ( QString ( "- replayed %1 packets (up to %2 clients) in %3 ticks" )
+                                    .arg ( iNumPackets )
+                                    .arg ( iMaxNumClients )
+                                    .arg ( iNumTicks ) );
+
+    qInfo() << qUtf8Printable ( QString ( "- capture length %1 s, replay time %2 s (%3x real time)" )
+                                    .arg ( iPacketTimeNs / 1e9, 0, 'f', 1 )
+                                    .arg ( iWallTimeNs / 1e9, 0, 'f', 1 )
+                                    .arg ( static_cast<double> ( iPacketTimeNs ) / iWallTimeNs, 0, 'f', 1 ) );
+
+    qInfo() << qUtf8Printable ( QString ( "- digest of %1 sent audio packets: %2" )
+                                    .arg ( iNumAudioPackets )
+                                    .arg ( iDigest, 16, 16, QLatin1Char ( '0' ) ) );
+}
@@ -0,0 +1,76 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include "global.h"
+#include "util.h"
+#include "server.h"
+#include "packetcapture.h"
+#include "tickprofiler.h"
+
+/* Classes ********************************************************************/
+// Replay of a packet capture (see CPacketCaptureWriter) as fast as possible.
+// The server is driven by a virtual clock instead of the high precision timer:
+// all datagrams which were received up to the time of a tick are injected in
+// the socket, then the tick is processed. While no client is connected, the
+// server sleeps and the clock jumps to the next datagram. Nothing is sent but
+// the digest of all audio packets is reported so that two runs (e.g. before
+// and after an optimisation) can be checked for bit-identical mixes. E.g., a
+// capture with lost packets must give the same digest with and without
+// --decodeonarrival. The overload and admission control measure the real tick
+// durations, therefore they are disabled for the replay (see main.cpp).
+class CServerReplay
+{
+public:
+    CServerReplay ( CServer* pNServer, CPacketCaptureReader* pNReader );
+
+    void Run();
+
+protected:
+    CServer*              pServer;
+    CPacketCaptureReader* pReader;
+};
@@ -95,6 +95,20 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
                                             } );
     } );
 
+    /// @rpc_notification jamulusserver/overloadLevelChanged
+    /// @brief Emitted when the overload control has changed the degradation level (see --overloadcontrol).
+    /// @param {number} params.level - The new overload level, 0 is normal operation.
+    /// @param {string} params.name - Name of the new overload level.
+    /// @param {number} params.utilisation - Smoothed tick duration relative to the frame duration.
+    connect ( pServer, &CServer::OverloadLevelChanged, [=] ( const int iLevel, const float fUtilisation ) {
+        pRpcServer->BroadcastNotification ( "jamulusserver/overloadLevelChanged",
+                                            QJsonObject{
+                                                { "level", iLevel },
+                                                { "name", COverloadController::GetLevelName ( static_cast<EOverloadLevel> ( iLevel ) ) },
+                                                { "utilisation", fUtilisation },
+                                            } );
+    } );
+
     /// @rpc_method jamulusserver/broadcastChatMessage
     /// @brief Sends a message (as the server) to all connected clients. This can be used to broadcast messages from external sources (e.g. scripts or
     /// monitoring tools).
@@ -170,6 +184,12 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
     /// @result {string} result.clients[*].city - The city name provided by the user for this channel.
     /// @result {number} result.clients[*].countryName - The text name of the country specified by the user for this channel (see QLocale::Country).
     /// @result {number} result.clients[*].skillLevelCode - The skill level id provided by the user for this channel.
+    /// @result {string} result.clients[*].codec - The audio codec of the client: "opus", "opus64", "celt" or "none".
+    /// @result {number} result.clients[*].codedBytes - The number of coded bytes per audio frame of the client.
+    /// @result {number} result.clients[*].decodeUs - Rolling average of the OPUS decoding time per tick in microseconds.
+    /// @result {number} result.clients[*].mixUs - Rolling average of the mixing time per tick in microseconds (zero for a shared mix).
+    /// @result {number} result.clients[*].encodeUs - Rolling average of the OPUS encoding time per tick in microseconds (zero for a shared mix,
+    /// see --encodeonce).
     pRpcServer->HandleMethod ( "jamulusserver/getClients", [=] ( const QJsonObject& params, QJsonObject& response ) {
         QJsonArray                clients;
         CVector<CHostAddress>     vecHostAddresses;
@@ -188,11 +208,35 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
         // fill list with connected clients
         for ( int i = 0; i < iNumChannels; i++ )
         {
-            if ( vecHostAddresses[i].InetAddr == QHostAddress ( static_cast<quint32> ( 0 ) ) )
+            if ( vecHostAddresses[i].HasSameIP ( CHostAddress() ) )
             {
                 continue;
             }
 
+            float fDecodeUs;
+            float fMixUs;
+            float fEncodeUs;
+
+            pServer->GetClientCostUs ( i, fDecodeUs, fMixUs, fEncodeUs );
+
+            QString strCodec;
+
+            switch ( pServer->GetClientAudioCompressionType ( i ) )
+            {
+            case CT_OPUS:
+                strCodec = "opus";
+                break;
+            case CT_OPUS64:
+                strCodec = "opus64";
+                break;
+            case CT_CELT:
+                strCodec = "celt";
+                break;
+            default:
+                strCodec = "none";
+                break;
+            }
+
             QJsonObject client{
                 { "id", i },
                 { "address", vecHostAddresses[i].toString ( CHostAddress::SM_IP_PORT ) },
@@ -203,6 +247,11 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
                 { "city", vecChanInfo[i].strCity },
                 { "countryName", QLocale::countryToString ( vecChanInfo[i].eCountry ) },
                 { "skillLevelCode", vecChanInfo[i].eSkillLevel },
+                { "codec", strCodec },
+                { "codedBytes", pServer->GetClientCeltNumCodedBytes ( i ) },
+                { "decodeUs", fDecodeUs },
+                { "mixUs", fMixUs },
+                { "encodeUs", fEncodeUs },
             };
             clients.append ( client );
 
@@ -249,6 +298,94 @@ CServerRpc::CServerRpc ( CServer* pServer, CRpcServer* pRpcServer, QObject* pare
         Q_UNUSED ( params );
     } );
 
+    /// @rpc_method jamulusserver/getServerStats
+    /// @brief Returns statistics of the server audio processing.
+    /// @param {object} params - No parameters (empty object).
+    /// @result {number} result.encodesSaved - Number of OPUS encodings saved since the server start by sharing identical mixes (see --encodeonce).
+    pRpcServer->HandleMethod ( "jamulusserver/getServerStats", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        QJsonObject result{
+            { "encodesSaved", pServer->GetNumEncodesSaved() },
+        };
+        response["result"] = result;
+        Q_UNUSED ( params );
+    } );
+
+    /// @rpc_method jamulusserver/getPerfStats
+    /// @brief Returns the timing statistics of the server ticks since the server start or the last reset.
+    /// @param {object} params - No parameters (empty object).
+    /// @result {number} result.deadlineUs - Duration of one frame in microseconds, a tick taking longer misses its deadline.
+    /// @result {number} result.ticks - Number of measured ticks.
+    /// @result {number} result.deadlineMisses - Number of ticks which took longer than the deadline.
+    /// @result {object} result.phases - Timing of the tick phases of all workers combined, see below.
+    /// @result {array} result.workers - Timing of the tick phases for each worker thread (worker 0 is the timer thread).
+    /// @result {object} result.phases.wakeupLateness - Lateness of the timer wakeup compared to the ideal tick time.
+    /// @result {object} result.phases.decode - Time spent in the jitter buffers and the OPUS decoding per tick.
+    /// @result {object} result.phases.levels - Time spent in the level calculation, mix grouping and mix-minus bus per tick.
+    /// @result {object} result.phases.mix - Time spent in the mixing per tick.
+    /// @result {object} result.phases.encode - Time spent in the OPUS encoding and packing of the packets per tick.
+    /// @result {object} result.phases.send - Time spent in the transmission of the audio packets per tick.
+    /// @result {object} result.phases.tick - Duration of the complete tick.
+    /// @result {number} result.phases.*.count - Number of ticks in which the phase was measured.
+    /// @result {number} result.phases.*.meanUs - Mean duration in microseconds.
+    /// @result {number} result.phases.*.p50Us - Median duration in microseconds (resolution about 6 %).
+    /// @result {number} result.phases.*.p90Us - 90th percentile of the duration in microseconds.
+    /// @result {number} result.phases.*.p99Us - 99th percentile of the duration in microseconds.
+    /// @result {number} result.phases.*.p999Us - 99.9th percentile of the duration in microseconds.
+    /// @result {number} result.phases.*.maxUs - Maximum duration in microseconds.
+    pRpcServer->HandleMethod ( "jamulusserver/getPerfStats", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        const CTickProfiler& TickProfiler = pServer->GetTickProfiler();
+
+        auto PhasesToJson = [&TickProfiler] ( const int iWorker ) -> QJsonObject {
+            QJsonObject jsonPhases;
+
+            for ( int iPhase = 0; iPhase < PP_NUM_PHASES; iPhase++ )
+            {
+                const EPerfPhase            ePhase  = static_cast<EPerfPhase> ( iPhase );
+                const CPerfHistogramSummary Summary = ( iWorker == INVALID_INDEX ) ? TickProfiler.GetSummaryAllWorkers ( ePhase )
+                                                                                   : TickProfiler.GetSummary ( iWorker, ePhase );
+
+                jsonPhases[CTickProfiler::GetPhaseName ( ePhase )] = QJsonObject{
+                    { "count", static_cast<qint64> ( Summary.iCount ) },
+                    { "meanUs", Summary.dMeanUs },
+                    { "p50Us", Summary.dP50Us },
+                    { "p90Us", Summary.dP90Us },
+                    { "p99Us", Summary.dP99Us },
+                    { "p999Us", Summary.dP999Us },
+                    { "maxUs", Summary.dMaxUs },
+                };
+            }
+
+            return jsonPhases;
+        };
+
+        QJsonArray jsonWorkers;
+
+        for ( int i = 0; i < TickProfiler.GetNumWorkers(); i++ )
+        {
+            jsonWorkers.append ( PhasesToJson ( i ) );
+        }
+
+        QJsonObject result{
+            { "deadlineUs", TickProfiler.GetDeadlineNs() / 1000.0 },
+            { "ticks", static_cast<qint64> ( TickProfiler.GetNumTicks() ) },
+            { "deadlineMisses", static_cast<qint64> ( TickProfiler.GetNumDeadlineMisses() ) },
+            { "phases", PhasesToJson ( INVALID_INDEX ) },
+            { "workers", jsonWorkers },
+        };
+        response["result"] = result;
+        Q_UNUSED ( params );
+    } );
+
+    /// @rpc_method jamulusserver/resetPerfStats
+    /// @brief Resets the timing statistics of the server ticks.
+    /// @param {object} params - No parameters (empty object).
+    /// @result {string} result - Always "ok".
+    pRpcServer->HandleMethod ( "jamulusserver/resetPerfStats", [=] ( const QJsonObject& params, QJsonObject& response ) {
+        pServer->ResetPerfStats();
+        response["result"] = "ok";
+        Q_UNUSED ( params );
+    } );
+
     /// @rpc_method jamulusserver/setDirectory
     /// @brief Set the directory type and, for custom, the directory address.
     /// @param {string} params.directoryType - The directory type as a string (see EDirectoryType and DeserializeDirectoryType).
@@ -46,6 +46,7 @@
 
 #include "socket.h"
 #include "server.h"
+#include "packetcapture.h"
 
 #ifdef _WIN32
 // Winsock versions of pollfd and poll are named differently, but work the same
@@ -56,9 +57,61 @@ typedef int socklen_t;
 // include Unix-style support for non-blocking and poll()
 #    include <fcntl.h>
 #    include <poll.h>
+#    include <unistd.h>
 #endif
 
 /* Implementation *************************************************************/
+void CSocketAddress::Set ( const CHostAddress& HostAddr )
+{
+    memset ( &Addr, 0, sizeof ( Addr ) );
+
+    // the address is built directly from the raw bytes of the host address,
+    // IPv4 addresses are stored IPv4-mapped and are sent via the IPv4 structure
+    if ( HostAddr.IsIPv4() )
+    {
+#ifdef Q_OS_BSD4
+        Addr.IPv4.sin_len = sizeof ( Addr.IPv4 );
+#endif
+        Addr.IPv4.sin_family      = AF_INET;
+        Addr.IPv4.sin_port        = htons ( HostAddr.iPort );
+        Addr.IPv4.sin_addr.s_addr = htonl ( HostAddr.GetIPv4() );
+        iLen                      = sizeof ( Addr.IPv4 );
+    }
+    else
+    {
+#ifdef Q_OS_BSD4
+        Addr.IPv6.sin6_len = sizeof ( Addr.IPv6 );
+#endif
+        Addr.IPv6.sin6_family   = AF_INET6;
+        Addr.IPv6.sin6_port     = htons ( HostAddr.iPort );
+        Addr.IPv6.sin6_scope_id = HostAddr.iScopeId;
+        memcpy ( &Addr.IPv6.sin6_addr.s6_addr, HostAddr.byAddr, sizeof ( Addr.IPv6.sin6_addr.s6_addr ) );
+        iLen = sizeof ( Addr.IPv6 );
+    }
+}
+
+void CSocketSendBatch::Init ( const int iNewMaxNumPackets )
+{
+    vecpData.Init ( iNewMaxNumPackets );
+    veciSize.Init ( iNewMaxNumPackets );
+    vecSockAddr.Init ( iNewMaxNumPackets );
+#ifdef __linux__
+    vecMsgHdr.Init ( iNewMaxNumPackets );
+    vecIov.Init ( iNewMaxNumPackets );
+#endif
+    iNumPackets = 0;
+}
+
+void CSocketSendBatch::Add ( const uint8_t* pData, const int iSize, const CSocketAddress& SockAddr )
+{
+    if ( !IsFull() )
+    {
+        vecpData[iNumPackets]    = pData;
+        veciSize[iNumPackets]    = iSize;
+        vecSockAddr[iNumPackets] = SockAddr;
+        iNumPackets++;
+    }
+}
 
 // Connections -------------------------------------------------------------
 // it is important to do the following connections in this class since we
@@ -66,6 +119,175 @@ typedef int socklen_t;
 
 // we have different connections for client and server, created after Init in corresponding constructor
 
+CProtocolMessageQueue::CProtocolMessageQueue() :
+    iReadPos ( 0 ),
+    iWritePos ( 0 ),
+    bWakeUpPending ( false ),
+    bIsProcessing ( false ),
+    iMaxNumUsed ( 0 ),
+    iNumDropped ( 0 )
+{
+    static_assert ( ( PROT_MESS_QUEUE_SIZE & ( PROT_MESS_QUEUE_SIZE - 1 ) ) == 0, "PROT_MESS_QUEUE_SIZE must be a power of two" );
+    static_assert ( PROT_MESS_QUEUE_NUM_CLM_RESERVED < PROT_MESS_QUEUE_SIZE, "PROT_MESS_QUEUE_NUM_CLM_RESERVED too large" );
+
+    // all memory is allocated here, the socket thread only copies data
+    for ( int i = 0; i < PROT_MESS_QUEUE_SIZE; i++ )
+    {
+        vecMessages[i].vecbyMesBodyData.reserve ( MAX_SIZE_BYTES_NETW_BUF );
+    }
+
+#ifdef _WIN32
+    // auto reset event, it is reset when the notifier was activated
+    hWakeUpEvent = CreateEvent ( nullptr, FALSE, FALSE, nullptr );
+
+    if ( hWakeUpEvent == nullptr )
+    {
+        throw CGenErr ( "creation of the protocol message event failed", "Network Error" );
+    }
+
+    pWakeUpNotifier = new QWinEventNotifier ( hWakeUpEvent, this );
+
+    QObject::connect ( pWakeUpNotifier, &QWinEventNotifier::activated, this, &CProtocolMessageQueue::OnWakeUp );
+#else
+    if ( pipe ( iWakeUpPipe ) != 0 )
+    {
+        throw CGenErr ( "creation of the protocol message pipe failed", "Network Error" );
+    }
+
+    // neither the socket thread nor the consumer must ever block on the pipe
+    for ( int i = 0; i < 2; i++ )
+    {
+        fcntl ( iWakeUpPipe[i], F_SETFL, fcntl ( iWakeUpPipe[i], F_GETFL, 0 ) | O_NONBLOCK );
+    }
+
+    pWakeUpNotifier = new QSocketNotifier ( iWakeUpPipe[0], QSocketNotifier::Read, this );
+
+    QObject::connect ( pWakeUpNotifier, &QSocketNotifier::activated, this, &CProtocolMessageQueue::OnWakeUp );
+#endif
+}
+
+CProtocolMessageQueue::~CProtocolMessageQueue()
+{
+    delete pWakeUpNotifier;
+
+#ifdef _WIN32
+    CloseHandle ( hWakeUpEvent );
+#else
+    close ( iWakeUpPipe[0] );
+    close ( iWakeUpPipe[1] );
+#endif
+}
+
+void CProtocolMessageQueue::Put ( const int               iRecCounter,
+                                  const int               iRecID,
+                                  const CVector<uint8_t>& vecbyMesBodyData,
+                                  const CHostAddress&     HostAddr )
+{
+    const uint32_t iCurWritePos = iWritePos.load ( std::memory_order_relaxed );
+    const int      iNumUsed     = static_cast<int> ( iCurWritePos - iReadPos.load ( std::memory_order_acquire ) );
+
+    // the messages of a connection are resent if dropped, the connectionless
+    // messages are not, therefore only these may use the reserved buffers
+    const int iNumAvailable =
+        CProtocol::IsConnectionLessMessageID ( iRecID ) ? PROT_MESS_QUEUE_SIZE : PROT_MESS_QUEUE_SIZE - PROT_MESS_QUEUE_NUM_CLM_RESERVED;
+
+    if ( iNumUsed >= iNumAvailable )
+    {
+        iNumDropped.fetch_add ( 1, std::memory_order_relaxed );
+        return;
+    }
+
+    if ( iNumUsed + 1 > iMaxNumUsed.load ( std::memory_order_relaxed ) )
+    {
+        iMaxNumUsed.store ( iNumUsed + 1, std::memory_order_relaxed );
+    }
+
+    // copy the message in the free buffer (the capacity of the buffer is large
+    // enough, i.e. no memory is allocated)
+    SMessage& Message = vecMessages[iCurWritePos & ( PROT_MESS_QUEUE_SIZE - 1 )];
+
+    Message.iRecCounter = iRecCounter;
+    Message.iRecID      = iRecID;
+    Message.HostAddr    = HostAddr;
+    Message.vecbyMesBodyData.Init ( vecbyMesBodyData.Size() );
+    std::copy ( vecbyMesBodyData.begin(), vecbyMesBodyData.end(), Message.vecbyMesBodyData.begin() );
+
+    iWritePos.store ( iCurWritePos + 1, std::memory_order_release );
+
+    // only wake up the consumer once for a burst of messages
+    if ( !bWakeUpPending.exchange ( true ) )
+    {
+        WakeUp();
+    }
+}
+
+void CProtocolMessageQueue::WakeUp()
+{
+#ifdef _WIN32
+    SetEvent ( hWakeUpEvent );
+#else
+    const char cWakeUp = 0;
+
+    if ( write ( iWakeUpPipe[1], &cWakeUp, 1 ) < 0 )
+    {
+        // the pipe is full, i.e., the consumer is woken up anyway
+    }
+#endif
+}
+
+void CProtocolMessageQueue::OnWakeUp()
+{
+#ifndef _WIN32
+    char vecbyDummy[64];
+
+    while ( read ( iWakeUpPipe[0], vecbyDummy, sizeof ( vecbyDummy ) ) > 0 )
+    {
+    }
+#endif
+
+    // messages which are put after this point wake us up again
+    bWakeUpPending.store ( false );
+
+    if ( bIsProcessing )
+    {
+        // we are called from a nested event loop of the outer call, i.e., the
+        // outer call cannot empty the queue before the nested event loop has
+        // finished: re-arm the wake up for the outer call (the notifier is
+        // disabled until then since it would fire continuously otherwise)
+        pWakeUpNotifier->setEnabled ( false );
+        bWakeUpPending.store ( true );
+        WakeUp();
+        return;
+    }
+
+    bIsProcessing = true;
+
+    uint32_t iCurReadPos = iReadPos.load ( std::memory_order_relaxed );
+
+    while ( iCurReadPos != iWritePos.load ( std::memory_order_acquire ) )
+    {
+        const SMessage& Message = vecMessages[iCurReadPos & ( PROT_MESS_QUEUE_SIZE - 1 )];
+
+        if ( CProtocol::IsConnectionLessMessageID ( Message.iRecID ) )
+        {
+            emit ProtocolCLMessageReceived ( Message.iRecID, Message.vecbyMesBodyData, Message.HostAddr );
+        }
+        else
+        {
+            emit ProtocolMessageReceived ( Message.iRecCounter, Message.iRecID, Message.vecbyMesBodyData, Message.HostAddr );
+        }
+
+        // the buffer can now be reused by the socket thread
+        iCurReadPos++;
+        iReadPos.store ( iCurReadPos, std::memory_order_release );
+    }
+
+    bIsProcessing = false;
+
+    // process the wake up which was re-armed by a nested call (if any)
+    pWakeUpNotifier->setEnabled ( true );
+}
+
 CSocket::CSocket ( CChannel*      pNewChannel,
                    const quint16  iPortNumber,
                    const quint16  iQosNumber,
@@ -75,7 +297,13 @@ CSocket::CSocket ( CChannel*      pNewChannel,
                    bool&          bIPv6Available ) :
     pChannel ( pNewChannel ),
     bIsClient ( true ),
+    bReusePort ( false ),
     bJitterBufferOK ( true ),
+    bSendEnabled ( true ),
+    pCapture ( nullptr ),
+    bAudioDigestEnabled ( false ),
+    iAudioDigest ( 0 ),
+    iNumAudioDigestPackets ( 0 ),
     bIPv6Available ( bIPv6Available )
 {
 #ifdef _WIN32
@@ -95,9 +323,9 @@ CSocket::CSocket ( CChannel*      pNewChannel,
     Init ( iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bDisableIPv6 );
 
     // client connections:
-    QObject::connect ( this, &CSocket::ProtocolMessageReceived, pChannel, &CChannel::OnProtocolMessageReceived );
+    QObject::connect ( &ProtMessageQueue, &CProtocolMessageQueue::ProtocolMessageReceived, pChannel, &CChannel::OnProtocolMessageReceived );
 
-    QObject::connect ( this, &CSocket::ProtocolCLMessageReceived, pChannel, &CChannel::OnProtocolCLMessageReceived );
+    QObject::connect ( &ProtMessageQueue, &CProtocolMessageQueue::ProtocolCLMessageReceived, pChannel, &CChannel::OnProtocolCLMessageReceived );
 
     QObject::connect ( this, static_cast<void ( CSocket::* )()> ( &CSocket::NewConnection ), pChannel, &CChannel::OnNewConnection );
 }
@@ -108,10 +336,17 @@ CSocket::CSocket ( CServer*       pNServP,
                    const QString& strServerBindIP4,
                    const QString& strServerBindIP6,
                    const bool     bDisableIPv6,
-                   bool&          bIPv6Available ) :
+                   bool&          bIPv6Available,
+                   const bool     bNReusePort ) :
     pServer ( pNServP ),
     bIsClient ( false ),
+    bReusePort ( bNReusePort ),
     bJitterBufferOK ( true ),
+    bSendEnabled ( true ),
+    pCapture ( nullptr ),
+    bAudioDigestEnabled ( false ),
+    iAudioDigest ( 0 ),
+    iNumAudioDigestPackets ( 0 ),
     bIPv6Available ( bIPv6Available )
 {
 #ifdef _WIN32
@@ -131,9 +366,9 @@ CSocket::CSocket ( CServer*       pNServP,
     Init ( iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bDisableIPv6 );
 
     // server connections:
-    QObject::connect ( this, &CSocket::ProtocolMessageReceived, pServer, &CServer::OnProtocolMessageReceived );
+    QObject::connect ( &ProtMessageQueue, &CProtocolMessageQueue::ProtocolMessageReceived, pServer, &CServer::OnProtocolMessageReceived );
 
-    QObject::connect ( this, &CSocket::ProtocolCLMessageReceived, pServer, &CServer::OnProtocolCLMessageReceived );
+    QObject::connect ( &ProtMessageQueue, &CProtocolMessageQueue::ProtocolCLMessageReceived, pServer, &CServer::OnProtocolCLMessageReceived );
 
     QObject::connect ( this,
                        static_cast<void ( CSocket::* ) ( int, int, CHostAddress )> ( &CSocket::NewConnection ),
@@ -316,6 +551,33 @@ void CSocket::Init ( const quint16  iNewPortNumber,
 
     // allocate memory for network receive and send buffer in samples
     vecbyRecBuf.Init ( MAX_SIZE_BYTES_NETW_BUF );
+    vecbyMesBodyData.reserve ( MAX_SIZE_BYTES_NETW_BUF );
+
+#ifdef __linux__
+    // the message headers of the receive ring point to fixed buffers, only the
+    // address lengths have to be reset before each recvmmsg() call
+    vecvecbyRecRing.Init ( RECV_BATCH_MAX_NUM_PACKETS );
+    vecRecMsgHdr.Init ( RECV_BATCH_MAX_NUM_PACKETS );
+    vecRecIov.Init ( RECV_BATCH_MAX_NUM_PACKETS );
+    vecRecSockAddr.Init ( RECV_BATCH_MAX_NUM_PACKETS );
+
+    for ( int i = 0; i < RECV_BATCH_MAX_NUM_PACKETS; i++ )
+    {
+        vecvecbyRecRing[i].Init ( MAX_SIZE_BYTES_NETW_BUF );
+
+        vecRecIov[i].iov_base = &vecvecbyRecRing[i][0];
+        vecRecIov[i].iov_len  = MAX_SIZE_BYTES_NETW_BUF;
+
+        memset ( &vecRecMsgHdr[i], 0, sizeof ( vecRecMsgHdr[i] ) );
+        vecRecMsgHdr[i].msg_hdr.msg_name    = &vecRecSockAddr[i];
+        vecRecMsgHdr[i].msg_hdr.msg_namelen = sizeof ( vecRecSockAddr[i] );
+        vecRecMsgHdr[i].msg_hdr.msg_iov     = &vecRecIov[i];
+        vecRecMsgHdr[i].msg_hdr.msg_iovlen  = 1;
+    }
+#endif
+
+    iNumRecvCalls   = 0;
+    iNumRecvPackets = 0;
 
     // initialize the listening socket
     bool bSuccess;
@@ -369,6 +631,20 @@ void CSocket::Init ( const quint16  iNewPortNumber,
 
         sa4.sin_port = sa6.sin6_port = htons ( iPortNumber );
 
+#ifdef __linux__
+        // allow several sockets on the same port, the kernel shards the flows
+        if ( bReusePort )
+        {
+            const int iReuse = 1;
+
+            if ( ( setsockopt ( UdpSocket4, SOL_SOCKET, SO_REUSEPORT, &iReuse, sizeof ( iReuse ) ) == -1 ) ||
+                 ( ( UdpSocket6 != INVALID_SOCKET ) && ( setsockopt ( UdpSocket6, SOL_SOCKET, SO_REUSEPORT, &iReuse, sizeof ( iReuse ) ) == -1 ) ) )
+            {
+                throw CGenErr ( "request to set SO_REUSEPORT failed", "Network Error" );
+            }
+        }
+#endif
+
         bSuccess = ( ::bind ( UdpSocket4, (struct sockaddr*) &sa4, sa4len ) == 0 );
 
         if ( UdpSocket6 != INVALID_SOCKET )
@@ -405,64 +681,32 @@ CSocket::~CSocket()
 
 void CSocket::SendPacket ( const CVector<uint8_t>& vecbySendBuf, const CHostAddress& HostAddr )
 {
+    if ( !bSendEnabled )
+    {
+        return;
+    }
+
     QMutexLocker locker ( &Mutex );
 
     const int iVecSizeOut = vecbySendBuf.Size();
 
     if ( iVecSizeOut > 0 )
     {
-        // send packet through network (we have to convert the constant unsigned
-        // char vector in "const char*", for this we first convert the const
-        // uint8_t vector in a read/write uint8_t vector and then do the cast to
-        // const char *)
+        const CSocketAddress SockAddr ( HostAddr );
 
         for ( int tries = 0; tries < 2; tries++ ) // retry loop in case send fails on iOS
         {
             int status = -1;
 
-            if ( HostAddr.InetAddr.protocol() == QAbstractSocket::IPv4Protocol )
+            if ( SockAddr.IsValid() )
             {
-                if ( UdpSocket4 != INVALID_SOCKET )
-                {
-                    struct sockaddr_in sa4;
-                    memset ( &sa4, 0, sizeof ( sa4 ) );
-#ifdef Q_OS_BSD4
-                    sa4.sin_len = sizeof ( sa4 );
-#endif
-                    sa4.sin_family      = AF_INET;
-                    sa4.sin_port        = htons ( HostAddr.iPort );
-                    sa4.sin_addr.s_addr = htonl ( HostAddr.InetAddr.toIPv4Address() );
-
-                    status = sendto ( UdpSocket4,
-                                      (const char*) &( (CVector<uint8_t>) vecbySendBuf )[0],
-                                      iVecSizeOut,
-                                      0,
-                                      (struct sockaddr*) &sa4,
-                                      sizeof ( sa4 ) );
-                }
-            }
-            else if ( HostAddr.InetAddr.protocol() == QAbstractSocket::IPv6Protocol )
-            {
-                if ( UdpSocket6 != INVALID_SOCKET )
-                {
-                    struct sockaddr_in6 sa6;
-                    memset ( &sa6, 0, sizeof ( sa6 ) );
-#ifdef Q_OS_BSD4
-                    sa6.sin6_len = sizeof ( sa6 );
-#endif
-                    sa6.sin6_family = AF_INET6;
-                    sa6.sin6_port   = htons ( HostAddr.iPort );
+                const SOCKET UdpSocket = SockAddr.IsIPv6() ? UdpSocket6 : UdpSocket4;
 
-                    Q_IPV6ADDR ip6 = HostAddr.InetAddr.toIPv6Address();
-                    memcpy ( &sa6.sin6_addr.s6_addr, ip6.c, sizeof ( sa6.sin6_addr.s6_addr ) );
-                    sa6.sin6_scope_id = HostAddr.InetAddr.scopeId().toUInt();
-
-                    status = sendto ( UdpSocket6,
-                                      (const char*) &( (CVector<uint8_t>) vecbySendBuf )[0],
-                                      iVecSizeOut,
-                                      0,
-                                      (struct sockaddr*) &sa6,
-                                      sizeof ( sa6 ) );
+                if ( UdpSocket != INVALID_SOCKET )
+                {
+                    // send packet through network (the data pointer is converted to
+                    // "const char*" since this is the type winsock uses)
+                    status = sendto ( UdpSocket, (const char*) vecbySendBuf.data(), iVecSizeOut, 0, &SockAddr.Addr.Generic, SockAddr.iLen );
                 }
             }
 
@@ -481,6 +725,125 @@ void CSocket::SendPacket ( const CVector<uint8_t>& vecbySendBuf, const CHostAddr
     }
 }
 
+void CSocket::SendBatch ( CSocketSendBatch& Batch )
+{
+    if ( bAudioDigestEnabled )
+    {
+        UpdateAudioDigest ( Batch );
+    }
+
+    if ( !bSendEnabled )
+    {
+        Batch.Clear();
+        return;
+    }
+
+#ifdef __linux__
+    // The sockets are never re-initialized on Linux so that we do not need the
+    // mutex here. There is one socket per address family, i.e. one system call
+    // for each of them.
+    for ( int iFamily = 0; iFamily < 2; iFamily++ )
+    {
+        const bool   bIPv6     = ( iFamily == 1 );
+        const SOCKET UdpSocket = bIPv6 ? UdpSocket6 : UdpSocket4;
+        int          iNumMsgs  = 0;
+
+        if ( UdpSocket == INVALID_SOCKET )
+        {
+            continue;
+        }
+
+        for ( int i = 0; i < Batch.iNumPackets; i++ )
+        {
+            const CSocketAddress& SockAddr = Batch.vecSockAddr[i];
+
+            if ( SockAddr.IsValid() && ( SockAddr.IsIPv6() == bIPv6 ) )
+            {
+                struct iovec&   Iov    = Batch.vecIov[iNumMsgs];
+                struct mmsghdr& MsgHdr = Batch.vecMsgHdr[iNumMsgs];
+
+                Iov.iov_base = const_cast<uint8_t*> ( Batch.vecpData[i] );
+                Iov.iov_len  = static_cast<size_t> ( Batch.veciSize[i] );
+
+                memset ( &MsgHdr, 0, sizeof ( MsgHdr ) );
+                MsgHdr.msg_hdr.msg_name    = const_cast<struct sockaddr*> ( &SockAddr.Addr.Generic );
+                MsgHdr.msg_hdr.msg_namelen = SockAddr.iLen;
+                MsgHdr.msg_hdr.msg_iov     = &Iov;
+                MsgHdr.msg_hdr.msg_iovlen  = 1;
+
+                iNumMsgs++;
+            }
+        }
+
+        // sendmmsg() stops at the first packet which cannot be sent, we skip
+        // that packet and send the rest (UDP packets may be lost anyway)
+        int iNumSent = 0;
+
+        while ( iNumSent < iNumMsgs )
+        {
+            const int iRet = sendmmsg ( UdpSocket, &Batch.vecMsgHdr[iNumSent], static_cast<unsigned int> ( iNumMsgs - iNumSent ), 0 );
+
+            iNumSent += ( iRet > 0 ) ? iRet : 1;
+        }
+    }
+#else
+    QMutexLocker locker ( &Mutex );
+
+    for ( int i = 0; i < Batch.iNumPackets; i++ )
+    {
+        const CSocketAddress& SockAddr  = Batch.vecSockAddr[i];
+        const SOCKET          UdpSocket = SockAddr.IsIPv6() ? UdpSocket6 : UdpSocket4;
+
+        if ( SockAddr.IsValid() && ( UdpSocket != INVALID_SOCKET ) )
+        {
+            sendto ( UdpSocket, (const char*) Batch.vecpData[i], Batch.veciSize[i], 0, &SockAddr.Addr.Generic, SockAddr.iLen );
+        }
+    }
+#endif
+
+    Batch.Clear();
+}
+
+void CSocket::UpdateAudioDigest ( const CSocketSendBatch& Batch )
+{
+    uint64_t iBatchDigest = 0;
+
+    for ( int i = 0; i < Batch.iNumPackets; i++ )
+    {
+        // FNV-1a hash of the destination and the content of the packet
+        const CSocketAddress& SockAddr = Batch.vecSockAddr[i];
+        uint64_t              iHash    = 14695981039346656037ULL;
+
+        auto HashBytes = [&iHash] ( const void* pData, const size_t iSize ) {
+            const uint8_t* pbyData = static_cast<const uint8_t*> ( pData );
+
+            for ( size_t j = 0; j < iSize; j++ )
+            {
+                iHash = ( iHash ^ pbyData[j] ) * 1099511628211ULL;
+            }
+        };
+
+        if ( SockAddr.IsIPv6() )
+        {
+            HashBytes ( &SockAddr.Addr.IPv6.sin6_addr, sizeof ( SockAddr.Addr.IPv6.sin6_addr ) );
+            HashBytes ( &SockAddr.Addr.IPv6.sin6_port, sizeof ( SockAddr.Addr.IPv6.sin6_port ) );
+        }
+        else
+        {
+            HashBytes ( &SockAddr.Addr.IPv4.sin_addr, sizeof ( SockAddr.Addr.IPv4.sin_addr ) );
+            HashBytes ( &SockAddr.Addr.IPv4.sin_port, sizeof ( SockAddr.Addr.IPv4.sin_port ) );
+        }
+
+        HashBytes ( Batch.vecpData[i], static_cast<size_t> ( Batch.veciSize[i] ) );
+
+        // the sum (modulo 2^64) does not depend on the order of the packets
+        iBatchDigest += iHash;
+    }
+
+    iAudioDigest.fetch_add ( iBatchDigest, std::memory_order_relaxed );
+    iNumAudioDigestPackets.fetch_add ( Batch.iNumPackets, std::memory_order_relaxed );
+}
+
 bool CSocket::GetAndResetbJitterBufferOKFlag()
 {
     // atomically read the jitter buffer status and reset it to OK so that a
@@ -539,6 +902,9 @@ void CSocket::OnDataReceived ( std::atomic<bool>& bRun )
     {
         if ( fds[retfds].revents & POLLIN )
         {
+#ifdef __linux__
+            ReceiveBatch ( UdpSocket4 );
+#else
             // read block from network interface and query address of sender
             sockaddr_in sa4;
             socklen_t   sa4len = sizeof ( sa4 );
@@ -574,11 +940,14 @@ void CSocket::OnDataReceived ( std::atomic<bool>& bRun )
                 }
 
                 // convert address of client
-                RecHostAddr.InetAddr.setAddress ( ntohl ( sa4.sin_addr.s_addr ) );
-                RecHostAddr.iPort = ntohs ( sa4.sin_port );
+                RecHostAddr.SetIPv4 ( ntohl ( sa4.sin_addr.s_addr ), ntohs ( sa4.sin_port ) );
+
+                iNumRecvCalls++;
+                iNumRecvPackets++;
 
-                ProcessPacket ( RecHostAddr, iNumBytesRead );
+                ProcessPacket ( vecbyRecBuf, RecHostAddr, iNumBytesRead );
             }
+#endif
         }
         retfds++;
     }
@@ -588,6 +957,9 @@ void CSocket::OnDataReceived ( std::atomic<bool>& bRun )
     {
         if ( fds[retfds].revents & POLLIN )
         {
+#ifdef __linux__
+            ReceiveBatch ( UdpSocket6 );
+#else
             // read block from network interface and query address of sender
             sockaddr_in6 sa6;
             socklen_t    sa6len = sizeof ( sa6 );
@@ -623,40 +995,106 @@ void CSocket::OnDataReceived ( std::atomic<bool>& bRun )
                 }
 
                 // convert address of client
-                RecHostAddr.InetAddr.setAddress ( sa6.sin6_addr.s6_addr );
-                RecHostAddr.iPort = ntohs ( sa6.sin6_port );
+                RecHostAddr.SetIPv6 ( sa6.sin6_addr.s6_addr, ntohs ( sa6.sin6_port ), sa6.sin6_scope_id );
 
-                ProcessPacket ( RecHostAddr, iNumBytesRead );
+                iNumRecvCalls++;
+                iNumRecvPackets++;
+
+                ProcessPacket ( vecbyRecBuf, RecHostAddr, iNumBytesRead );
             }
+#endif
         }
         retfds++;
     }
 }
 
-void CSocket::ProcessPacket ( const CHostAddress& RecHostAddr, const int iNumBytesRead )
+#ifdef __linux__
+void CSocket::ReceiveBatch ( const SOCKET UdpSocket )
 {
-    // check if this is a protocol message
-    int              iRecCounter;
-    int              iRecID;
-    CVector<uint8_t> vecbyMesBodyData;
+    CHostAddress RecHostAddr;
 
-    if ( !CProtocol::ParseMessageFrame ( vecbyRecBuf, iNumBytesRead, vecbyMesBodyData, iRecCounter, iRecID ) )
+    for ( int i = 0; i < RECV_BATCH_MAX_NUM_PACKETS; i++ )
     {
-        // this is a protocol message, check the type of the message
-        if ( CProtocol::IsConnectionLessMessageID ( iRecID ) )
+        vecRecMsgHdr[i].msg_hdr.msg_namelen = sizeof ( vecRecSockAddr[i] );
+    }
+
+    // Read as many packets as are available (up to the ring size) at once. Only
+    // one batch is read per socket and wakeup so that a flood on one socket
+    // cannot starve the other one, the remaining packets are read after the
+    // next poll() which returns immediately.
+    const int iNumPackets = recvmmsg ( UdpSocket, &vecRecMsgHdr[0], RECV_BATCH_MAX_NUM_PACKETS, MSG_DONTWAIT, nullptr );
+
+    if ( iNumPackets < 0 )
+    {
+        if ( errno != EAGAIN && errno != EWOULDBLOCK )
         {
-            //### TODO: BEGIN ###//
-            // a copy of the vector is used -> avoid malloc in real-time routine
-            emit ProtocolCLMessageReceived ( iRecID, vecbyMesBodyData, RecHostAddr );
-            //### TODO: END ###//
+            qDebug() << "Unexpected error returned by recvmmsg()";
+        }
+        return;
+    }
+
+    if ( iNumPackets == 0 )
+    {
+        return;
+    }
+
+    iNumRecvCalls++;
+    iNumRecvPackets += iNumPackets;
+
+    for ( int i = 0; i < iNumPackets; i++ )
+    {
+        const int iNumBytesRead = static_cast<int> ( vecRecMsgHdr[i].msg_len );
+
+        if ( iNumBytesRead == 0 )
+        {
+            continue;
+        }
+
+        // convert address of client
+        if ( vecRecSockAddr[i].ss_family == AF_INET6 )
+        {
+            const sockaddr_in6* pSa6 = reinterpret_cast<const sockaddr_in6*> ( &vecRecSockAddr[i] );
+
+            RecHostAddr.SetIPv6 ( pSa6->sin6_addr.s6_addr, ntohs ( pSa6->sin6_port ), pSa6->sin6_scope_id );
         }
         else
         {
-            //### TODO: BEGIN ###//
-            // a copy of the vector is used -> avoid malloc in real-time routine
-            emit ProtocolMessageReceived ( iRecCounter, iRecID, vecbyMesBodyData, RecHostAddr );
-            //### TODO: END ###//
+            const sockaddr_in* pSa4 = reinterpret_cast<const sockaddr_in*> ( &vecRecSockAddr[i] );
+
+            RecHostAddr.SetIPv4 ( ntohl ( pSa4->sin_addr.s_addr ), ntohs ( pSa4->sin_port ) );
         }
+
+        ProcessPacket ( vecvecbyRecRing[i], RecHostAddr, iNumBytesRead );
+    }
+}
+#endif
+
+void CSocket::InjectPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytes )
+{
+    ProcessPacket ( vecbyPacket, RecHostAddr, iNumBytes );
+
+    // the protocol queue normally wakes up the owning thread via its event loop
+    ProtMessageQueue.OnWakeUp();
+}
+
+void CSocket::ProcessPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytesRead )
+{
+    CPacketCaptureWriter* pCurCapture = pCapture.load ( std::memory_order_acquire );
+
+    if ( pCurCapture != nullptr )
+    {
+        pCurCapture->Add ( vecbyPacket, iNumBytesRead, RecHostAddr );
+    }
+
+    // check if this is a protocol message
+    int iRecCounter;
+    int iRecID;
+
+    if ( !CProtocol::ParseMessageFrame ( vecbyPacket, iNumBytesRead, vecbyMesBodyData, iRecCounter, iRecID ) )
+    {
+        // this is a protocol message, it is handed over to the protocol thread
+        // without allocating memory in this real-time routine
+        ProtMessageQueue.Put ( iRecCounter, iRecID, vecbyMesBodyData, RecHostAddr );
     }
     else
     {
@@ -665,7 +1103,7 @@ void CSocket::ProcessPacket ( const CHostAddress& RecHostAddr, const int iNumByt
         {
             // client:
 
-            switch ( pChannel->PutAudioData ( vecbyRecBuf, iNumBytesRead, RecHostAddr ) )
+            switch ( pChannel->PutAudioData ( vecbyPacket, iNumBytesRead, RecHostAddr ) )
             {
             case PS_AUDIO_ERR:
             case PS_GEN_ERROR:
@@ -693,7 +1131,7 @@ void CSocket::ProcessPacket ( const CHostAddress& RecHostAddr, const int iNumByt
 
             int iCurChanID;
 
-            if ( pServer->PutAudioData ( vecbyRecBuf, iNumBytesRead, RecHostAddr, iCurChanID ) )
+            if ( pServer->PutAudioData ( vecbyPacket, iNumBytesRead, RecHostAddr, iCurChanID ) )
             {
                 // we have a new connection, emit a signal
                 emit NewConnection ( iCurChanID, pServer->GetNumberOfConnectedClients(), RecHostAddr );
@@ -49,6 +49,11 @@
 #include <QObject>
 #include <QThread>
 #include <QMutex>
+#ifdef _WIN32
+#    include <QWinEventNotifier>
+#else
+#    include <QSocketNotifier>
+#endif
 #include <vector>
 #include <atomic>
 #include "global.h"
@@ -65,14 +70,152 @@ typedef int SOCKET;
 // The header files channel.h and server.h require to include this header file
 // so we get a cyclic dependency. To solve this issue, a prototype of the
 // channel class and server class is defined here.
-class CServer;  // forward declaration of CServer
-class CChannel; // forward declaration of CChannel
+class CServer;              // forward declaration of CServer
+class CChannel;             // forward declaration of CChannel
+class CPacketCaptureWriter; // forward declaration of CPacketCaptureWriter
 
 /* Definitions ****************************************************************/
 // number of ports we try to bind until we give up
 #define NUM_SOCKET_PORTS_TO_TRY 100
 
+// maximum number of packets which are read with one system call (Linux only)
+#define RECV_BATCH_MAX_NUM_PACKETS 32
+
+// maximum number of server sockets which share the port (Linux only)
+#define MAX_NUM_RECV_SOCKETS 16
+
+// number of buffers for received protocol messages per socket (must be a
+// power of two)
+#define PROT_MESS_QUEUE_SIZE 64
+
+// number of these buffers which can only be used by connectionless messages
+#define PROT_MESS_QUEUE_NUM_CLM_RESERVED 16
+
 /* Classes ********************************************************************/
+/* Native socket address ---------------------------------------------------- */
+// The conversion of a CHostAddress to the socket address structure is done
+// once, e.g. when a channel gets connected, instead of for each packet.
+class CSocketAddress
+{
+public:
+    CSocketAddress() : iLen ( 0 ) { memset ( &Addr, 0, sizeof ( Addr ) ); }
+    CSocketAddress ( const CHostAddress& HostAddr ) { Set ( HostAddr ); }
+
+    void Set ( const CHostAddress& HostAddr );
+
+    bool IsValid() const { return iLen > 0; }
+    bool IsIPv6() const { return Addr.Generic.sa_family == AF_INET6; }
+
+    union
+    {
+        struct sockaddr     Generic;
+        struct sockaddr_in  IPv4;
+        struct sockaddr_in6 IPv6;
+    } Addr;
+    socklen_t iLen;
+};
+
+/* Batch of packets which are sent together --------------------------------- */
+// The packet data is not copied, it must stay valid until the batch is sent.
+// Each thread which sends audio packets uses its own batch so that the threads
+// do not have to wait for each other. On Linux all packets of a batch are sent
+// with one system call.
+class CSocketSendBatch
+{
+public:
+    CSocketSendBatch() : iNumPackets ( 0 ) {}
+
+    void Init ( const int iNewMaxNumPackets );
+
+    bool IsFull() const { return iNumPackets >= vecSockAddr.Size(); }
+    bool IsEmpty() const { return iNumPackets == 0; }
+
+    void Add ( const uint8_t* pData, const int iSize, const CSocketAddress& SockAddr );
+    void Clear() { iNumPackets = 0; }
+
+protected:
+    friend class CSocket;
+
+    CVector<const uint8_t*> vecpData;
+    CVector<int>            veciSize;
+    CVector<CSocketAddress> vecSockAddr;
+#ifdef __linux__
+    CVector<struct mmsghdr> vecMsgHdr;
+    CVector<struct iovec>   vecIov;
+#endif
+    int iNumPackets;
+};
+
+/* Queue of received protocol messages ------------------------------------- */
+// The socket thread must not allocate memory, therefore the received protocol
+// messages are copied in a fixed pool of preallocated buffers which is used as
+// a single producer single consumer ring. The socket thread fills the buffers
+// and the thread which owns the queue object (the thread of the channel or
+// server) emits the messages. The consumer is woken up by a pipe (an event
+// object on Windows) which does not allocate memory either. If all buffers are
+// in use, the message is dropped. For the messages of a connection this is not
+// critical since the protocol resends them until they are acknowledged. The
+// connectionless messages (e.g. pings, server list) are not acknowledged and
+// not resent, therefore some buffers are reserved for them which the messages
+// of a connection must not use.
+class CProtocolMessageQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    CProtocolMessageQueue();
+    virtual ~CProtocolMessageQueue();
+
+    // called by the socket thread
+    void Put ( const int iRecCounter, const int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& HostAddr );
+
+    int     GetMaxNumUsed() const { return iMaxNumUsed.load ( std::memory_order_relaxed ); }
+    int64_t GetNumDropped() const { return iNumDropped.load ( std::memory_order_relaxed ); }
+
+protected:
+    struct SMessage
+    {
+        int              iRecCounter;
+        int              iRecID;
+        CVector<uint8_t> vecbyMesBodyData;
+        CHostAddress     HostAddr;
+    };
+
+    void WakeUp();
+
+    SMessage vecMessages[PROT_MESS_QUEUE_SIZE];
+
+    // the read position is only written by the consumer and the write position
+    // only by the producer, both are incremented without wrapping
+    std::atomic<uint32_t> iReadPos;
+    std::atomic<uint32_t> iWritePos;
+
+    // true if the consumer was already woken up and did not yet empty the queue
+    std::atomic<bool> bWakeUpPending;
+
+    // the processing of a message may run a nested event loop (e.g. message box)
+    bool bIsProcessing;
+
+    std::atomic<int>     iMaxNumUsed;
+    std::atomic<int64_t> iNumDropped;
+
+#ifdef _WIN32
+    HANDLE             hWakeUpEvent;
+    QWinEventNotifier* pWakeUpNotifier;
+#else
+    int              iWakeUpPipe[2];
+    QSocketNotifier* pWakeUpNotifier;
+#endif
+
+public slots:
+    void OnWakeUp();
+
+signals:
+    void ProtocolMessageReceived ( int iRecCounter, int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& HostAdr );
+
+    void ProtocolCLMessageReceived ( int iRecID, const CVector<uint8_t>& vecbyMesBodyData, const CHostAddress& HostAdr );
+};
+
 /* Base socket class -------------------------------------------------------- */
 class CSocket : public QObject
 {
@@ -93,14 +236,48 @@ public:
               const QString& strServerBindIP4,
               const QString& strServerBindIP6,
               const bool     bDisableIPv6,
-              bool&          bIPv6Available );
+              bool&          bIPv6Available,
+              const bool     bNReusePort = false );
 
     virtual ~CSocket();
 
     void SendPacket ( const CVector<uint8_t>& vecbySendBuf, const CHostAddress& HostAddr );
 
+    void SendBatch ( CSocketSendBatch& Batch );
+
+    // if sending is disabled, all outgoing packets are dropped (e.g. for the
+    // offline benchmark which must not cause any network traffic)
+    void SetSendEnabled ( const bool bEnable ) { bSendEnabled = bEnable; }
+
+    // all received datagrams are recorded by the capture writer (server only)
+    void SetPacketCapture ( CPacketCaptureWriter* pNCapture ) { pCapture = pNCapture; }
+
+    // processes a datagram as if it was received by this socket, the protocol
+    // messages are processed directly by the calling thread (e.g. replay of a
+    // packet capture)
+    void InjectPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytes );
+
+    // The digest of all sent audio packets is the sum of the hashes of the
+    // packets. It does not depend on the order in which the packets are sent,
+    // i.e. on the order in which the workers finish their channels.
+    void EnableAudioDigest() { bAudioDigestEnabled = true; }
+
+    void GetAudioDigest ( uint64_t& iDigest, int64_t& iNumPackets ) const
+    {
+        iDigest     = iAudioDigest;
+        iNumPackets = iNumAudioDigestPackets;
+    }
+
     bool GetAndResetbJitterBufferOKFlag();
 
+    void GetRecvCounts ( int64_t& iCalls, int64_t& iPackets ) const
+    {
+        iCalls   = iNumRecvCalls;
+        iPackets = iNumRecvPackets;
+    }
+
+    const CProtocolMessageQueue& GetProtMessageQueue() const { return ProtMessageQueue; }
+
 protected:
     void    Init ( const quint16  iPortNumber,
                    const quint16  iQosNumber,
@@ -119,19 +296,54 @@ protected:
 
     CVector<uint8_t> vecbyRecBuf;
 
+    // preallocated buffer for parsing protocol messages in the socket thread
+    CVector<uint8_t> vecbyMesBodyData;
+
+    // the queue is no child of the socket, it stays in the thread in which
+    // the socket was created when the socket is moved to its own thread
+    CProtocolMessageQueue ProtMessageQueue;
+
+#ifdef __linux__
+    // ring of receive buffers, filled by one recvmmsg() call
+    CVector<CVector<uint8_t>>        vecvecbyRecRing;
+    CVector<struct mmsghdr>          vecRecMsgHdr;
+    CVector<struct iovec>            vecRecIov;
+    CVector<struct sockaddr_storage> vecRecSockAddr;
+#endif
+
+    // statistics for the average number of packets per receive call
+    std::atomic<int64_t> iNumRecvCalls;
+    std::atomic<int64_t> iNumRecvPackets;
+
     CChannel* pChannel; // for client
     CServer*  pServer;  // for server
 
     bool bIsClient;
 
+    // several server sockets may be bound to the same port (SO_REUSEPORT)
+    bool bReusePort;
+
     std::atomic<bool> bJitterBufferOK;
+    std::atomic<bool> bSendEnabled;
+
+    std::atomic<CPacketCaptureWriter*> pCapture;
+
+    std::atomic<bool>     bAudioDigestEnabled;
+    std::atomic<uint64_t> iAudioDigest;
+    std::atomic<int64_t>  iNumAudioDigestPackets;
 
     // This is a reference to CClient::bIPv6Available or CServer::bIPv6Available,
     // to inform the Client or Server which type of socket was created at startup.
     bool& bIPv6Available;
 
 private:
-    void ProcessPacket ( const CHostAddress& RecHostAddr, const int iNumBytesRead );
+    void ProcessPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytesRead );
+
+    void UpdateAudioDigest ( const CSocketSendBatch& Batch );
+
+#ifdef __linux__
+    void ReceiveBatch ( const SOCKET UdpSocket );
+#endif
 
 public:
     void OnDataReceived ( std::atomic<bool>& bRun );
@@ -145,10 +357,6 @@ signals:
     void ServerFull ( CHostAddress RecHostAddr );
 
     void InvalidPacketReceived ( CHostAddress RecHostAddr );
-
-    void ProtocolMessageReceived ( int iRecCounter, int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress HostAdr );
-
-    void ProtocolCLMessageReceived ( int iRecID, CVector<uint8_t> vecbyMesBodyData, CHostAddress HostAdr );
 };
 
 /* Socket which runs in a separate high priority thread --------------------- */
@@ -179,25 +387,124 @@ public:
                       const QString& strServerBindIP4,
                       const QString& strServerBindIP6,
                       const bool     bDisableIPv6,
-                      bool&          bIPv6Available ) :
-        Socket ( pNewServer, iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bDisableIPv6, bIPv6Available )
+                      bool&          bIPv6Available,
+                      const int      iNumRecvSockets = 1 ) :
+        Socket ( pNewServer, iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bDisableIPv6, bIPv6Available, iNumRecvSockets > 1 )
     {
         Init();
+
+#ifdef __linux__
+        // Additional sockets bound to the same port, each with its own receive
+        // thread. The kernel distributes the incoming packets by the address of
+        // the sender so that all packets of a client are received by the same
+        // socket. Sending is always done on the first socket.
+        for ( int i = 1; i < iNumRecvSockets; i++ )
+        {
+            CSocket* pRecvSocket =
+                new CSocket ( pNewServer, iPortNumber, iQosNumber, strServerBindIP4, strServerBindIP6, bDisableIPv6, bIPv6Available, true );
+
+            CSocketThread* pRecvThread = new CSocketThread ( pRecvSocket );
+
+            pRecvSocket->moveToThread ( pRecvThread );
+
+            QObject::connect ( pRecvSocket, &CSocket::InvalidPacketReceived, this, &CHighPrioSocket::InvalidPacketReceived );
+
+            vecpRecvSockets.push_back ( pRecvSocket );
+            vecpRecvThreads.push_back ( pRecvThread );
+        }
+#else
+        if ( iNumRecvSockets > 1 )
+        {
+            qWarning() << "- multiple receive sockets are only supported on Linux, using one receive socket";
+        }
+#endif
     }
 
-    virtual ~CHighPrioSocket() { NetworkWorkerThread.Stop(); }
+    virtual ~CHighPrioSocket()
+    {
+        NetworkWorkerThread.Stop();
+
+        for ( size_t i = 0; i < vecpRecvThreads.size(); i++ )
+        {
+            vecpRecvThreads[i]->Stop();
+
+            delete vecpRecvThreads[i];
+            delete vecpRecvSockets[i];
+        }
+    }
 
     void Start()
     {
         // starts the high priority socket receive thread (with using blocking
         // socket request call)
         NetworkWorkerThread.start ( QThread::TimeCriticalPriority );
+
+        for ( CSocketThread* pRecvThread : vecpRecvThreads )
+        {
+            pRecvThread->start ( QThread::TimeCriticalPriority );
+        }
     }
 
     void SendPacket ( const CVector<uint8_t>& vecbySendBuf, const CHostAddress& HostAddr ) { Socket.SendPacket ( vecbySendBuf, HostAddr ); }
 
+    void SendBatch ( CSocketSendBatch& Batch ) { Socket.SendBatch ( Batch ); }
+
+    void SetSendEnabled ( const bool bEnable ) { Socket.SetSendEnabled ( bEnable ); }
+
+    void SetPacketCapture ( CPacketCaptureWriter* pNCapture )
+    {
+        Socket.SetPacketCapture ( pNCapture );
+
+        for ( CSocket* pRecvSocket : vecpRecvSockets )
+        {
+            pRecvSocket->SetPacketCapture ( pNCapture );
+        }
+    }
+
+    void InjectPacket ( const CVector<uint8_t>& vecbyPacket, const CHostAddress& RecHostAddr, const int iNumBytes )
+    {
+        Socket.InjectPacket ( vecbyPacket, RecHostAddr, iNumBytes );
+    }
+
+    // all audio packets are sent by the first socket
+    void EnableAudioDigest() { Socket.EnableAudioDigest(); }
+    void GetAudioDigest ( uint64_t& iDigest, int64_t& iNumPackets ) const { Socket.GetAudioDigest ( iDigest, iNumPackets ); }
+
     bool GetAndResetbJitterBufferOKFlag() { return Socket.GetAndResetbJitterBufferOKFlag(); }
 
+    double GetAvgRecvBatchSize() const
+    {
+        int64_t iCalls;
+        int64_t iPackets;
+
+        Socket.GetRecvCounts ( iCalls, iPackets );
+
+        for ( const CSocket* pRecvSocket : vecpRecvSockets )
+        {
+            int64_t iSocketCalls;
+            int64_t iSocketPackets;
+
+            pRecvSocket->GetRecvCounts ( iSocketCalls, iSocketPackets );
+
+            iCalls += iSocketCalls;
+            iPackets += iSocketPackets;
+        }
+
+        return iCalls > 0 ? static_cast<double> ( iPackets ) / iCalls : 0.0;
+    }
+
+    void GetProtMessageQueueStats ( int& iMaxNumUsed, int64_t& iNumDropped ) const
+    {
+        iMaxNumUsed = Socket.GetProtMessageQueue().GetMaxNumUsed();
+        iNumDropped = Socket.GetProtMessageQueue().GetNumDropped();
+
+        for ( const CSocket* pRecvSocket : vecpRecvSockets )
+        {
+            iMaxNumUsed = std::max ( iMaxNumUsed, pRecvSocket->GetProtMessageQueue().GetMaxNumUsed() );
+            iNumDropped += pRecvSocket->GetProtMessageQueue().GetNumDropped();
+        }
+    }
+
 protected:
     class CSocketThread : public QThread
     {
@@ -256,6 +563,10 @@ protected:
     CSocketThread NetworkWorkerThread;
     CSocket       Socket;
 
+    // additional receive sockets and threads (server only)
+    std::vector<CSocket*>       vecpRecvSockets;
+    std::vector<CSocketThread*> vecpRecvThreads;
+
 signals:
     void InvalidPacketReceived ( CHostAddress RecHostAddr );
 };
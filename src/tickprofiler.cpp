@@ -0,0 +1,270 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#include "tickprofiler.h"
+
+/* Implementation *************************************************************/
+void CPerfHistogram::Record ( const int64_t iValueNs )
+{
+    const int64_t iClippedValueNs = std::min ( std::max ( iValueNs, static_cast<int64_t> ( 0 ) ),
+                                               ( static_cast<int64_t> ( 1 ) << PERF_HIST_MAX_VALUE_BITS ) - 1 );
+
+    // there is only one writer, therefore no read-modify-write is needed
+    std::atomic<uint32_t>& iBucketCount = iCounts[GetBucketIndex ( iClippedValueNs )];
+
+    iBucketCount.store ( iBucketCount.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    iCount.store ( iCount.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    iSumNs.store ( iSumNs.load ( std::memory_order_relaxed ) + iClippedValueNs, std::memory_order_relaxed );
+
+    if ( iClippedValueNs > iMaxNs.load ( std::memory_order_relaxed ) )
+    {
+        iMaxNs.store ( iClippedValueNs, std::memory_order_relaxed );
+    }
+}
+
+void CPerfHistogram::Reset()
+{
+    for ( int i = 0; i < PERF_HIST_NUM_BUCKETS; i++ )
+    {
+        iCounts[i].store ( 0, std::memory_order_relaxed );
+    }
+
+    iCount.store ( 0, std::memory_order_relaxed );
+    iSumNs.store ( 0, std::memory_order_relaxed );
+    iMaxNs.store ( 0, std::memory_order_relaxed );
+}
+
+int CPerfHistogram::GetBucketIndex ( const int64_t iValueNs )
+{
+    // values below 2^(PERF_HIST_SUB_BUCKET_BITS + 1) have their own bucket, above
+    // each power of two is split in 2^PERF_HIST_SUB_BUCKET_BITS buckets
+    int iMsb = 0;
+
+#if defined( __GNUC__ )
+    if ( iValueNs > 0 )
+    {
+        iMsb = 63 - __builtin_clzll ( static_cast<unsigned long long> ( iValueNs ) );
+    }
+#else
+    for ( int64_t iValue = iValueNs >> 1; iValue > 0; iValue >>= 1 )
+    {
+        iMsb++;
+    }
+#endif
+
+    const int iShift = std::max ( iMsb - PERF_HIST_SUB_BUCKET_BITS, 0 );
+
+    return ( iShift << PERF_HIST_SUB_BUCKET_BITS ) + static_cast<int> ( iValueNs >> iShift );
+}
+
+int64_t CPerfHistogram::GetBucketHighestValue ( const int iBucket )
+{
+    const int iSubBuckets = 1 << PERF_HIST_SUB_BUCKET_BITS;
+
+    if ( iBucket < 2 * iSubBuckets )
+    {
+        return iBucket;
+    }
+
+    const int iShift = ( iBucket >> PERF_HIST_SUB_BUCKET_BITS ) - 1;
+
+    return ( static_cast<int64_t> ( ( iBucket & ( iSubBuckets - 1 ) ) + iSubBuckets ) << iShift ) + ( static_cast<int64_t> ( 1 ) << iShift ) - 1;
+}
+
+CPerfHistogramSummary CPerfHistogram::Summarize ( const CPerfHistogram* const* ppHistograms, const int iNumHistograms )
+{
+    CPerfHistogramSummary Summary;
+    int64_t               veciCounts[PERF_HIST_NUM_BUCKETS] = {};
+    int64_t               iSumNs                            = 0;
+    int64_t               iMaxNs                            = 0;
+    int                   i, j;
+
+    // take a snapshot of the bucket counts (the total count is derived from the
+    // snapshot so that the percentiles are consistent with it)
+    for ( i = 0; i < iNumHistograms; i++ )
+    {
+        for ( j = 0; j < PERF_HIST_NUM_BUCKETS; j++ )
+        {
+            const int64_t iBucketCount = ppHistograms[i]->iCounts[j].load ( std::memory_order_relaxed );
+
+            veciCounts[j] += iBucketCount;
+            Summary.iCount += iBucketCount;
+        }
+
+        iSumNs += ppHistograms[i]->iSumNs.load ( std::memory_order_relaxed );
+        iMaxNs = std::max ( iMaxNs, ppHistograms[i]->iMaxNs.load ( std::memory_order_relaxed ) );
+    }
+
+    if ( Summary.iCount == 0 )
+    {
+        return Summary;
+    }
+
+    const double  vecdQuantiles[4] = { 0.5, 0.9, 0.99, 0.999 };
+    double* const vecpdResults[4]  = { &Summary.dP50Us, &Summary.dP90Us, &Summary.dP99Us, &Summary.dP999Us };
+    int64_t       iCumCount        = 0;
+    int           iQuantile        = 0;
+
+    for ( j = 0; ( j < PERF_HIST_NUM_BUCKETS ) && ( iQuantile < 4 ); j++ )
+    {
+        iCumCount += veciCounts[j];
+
+        // the highest value of the bucket is reported, limited by the maximum
+        while ( ( iQuantile < 4 ) && ( iCumCount >= vecdQuantiles[iQuantile] * Summary.iCount ) && ( iCumCount > 0 ) )
+        {
+            *vecpdResults[iQuantile] = std::min ( GetBucketHighestValue ( j ), iMaxNs ) / 1000.0;
+            iQuantile++;
+        }
+    }
+
+    Summary.dMeanUs = static_cast<double> ( iSumNs ) / Summary.iCount / 1000.0;
+    Summary.dMaxUs  = iMaxNs / 1000.0;
+
+    return Summary;
+}
+
+void CTickProfiler::Init ( const int iNewNumWorkers, const int64_t iNewDeadlineNs )
+{
+    iNumWorkers   = iNewNumWorkers;
+    iDeadlineNs   = iNewDeadlineNs;
+    vecWorkerData = std::unique_ptr<CWorkerData[]> ( new CWorkerData[iNumWorkers] );
+
+    for ( int i = 0; i < iNumWorkers; i++ )
+    {
+        for ( int iPhase = 0; iPhase < PP_NUM_PHASES; iPhase++ )
+        {
+            vecWorkerData[i].iAccuNs[iPhase]    = 0;
+            vecWorkerData[i].bPhaseUsed[iPhase] = false;
+        }
+    }
+
+    Reset();
+}
+
+void CTickProfiler::FinishTick ( const int64_t iTickDurationNs )
+{
+    for ( int i = 0; i < iNumWorkers; i++ )
+    {
+        CWorkerData& WorkerData = vecWorkerData[i];
+
+        // phases in which the worker had nothing to do in this tick are not recorded
+        for ( int iPhase = 0; iPhase < PP_NUM_PHASES; iPhase++ )
+        {
+            if ( WorkerData.bPhaseUsed[iPhase] )
+            {
+                WorkerData.Histograms[iPhase].Record ( WorkerData.iAccuNs[iPhase] );
+
+                WorkerData.iAccuNs[iPhase]    = 0;
+                WorkerData.bPhaseUsed[iPhase] = false;
+            }
+        }
+    }
+
+    vecWorkerData[0].Histograms[PP_TICK].Record ( iTickDurationNs );
+
+    iNumTicks.store ( iNumTicks.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+
+    if ( iTickDurationNs > iDeadlineNs )
+    {
+        iNumDeadlineMisses.store ( iNumDeadlineMisses.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    }
+}
+
+void CTickProfiler::Reset()
+{
+    for ( int i = 0; i < iNumWorkers; i++ )
+    {
+        for ( int iPhase = 0; iPhase < PP_NUM_PHASES; iPhase++ )
+        {
+            vecWorkerData[i].Histograms[iPhase].Reset();
+        }
+    }
+
+    iNumTicks.store ( 0, std::memory_order_relaxed );
+    iNumDeadlineMisses.store ( 0, std::memory_order_relaxed );
+}
+
+CPerfHistogramSummary CTickProfiler::GetSummary ( const int iWorker, const EPerfPhase ePhase ) const
+{
+    const CPerfHistogram* pHistogram = &vecWorkerData[iWorker].Histograms[ePhase];
+
+    return CPerfHistogram::Summarize ( &pHistogram, 1 );
+}
+
+CPerfHistogramSummary CTickProfiler::GetSummaryAllWorkers ( const EPerfPhase ePhase ) const
+{
+    std::unique_ptr<const CPerfHistogram*[]> vecpHistograms ( new const CPerfHistogram*[iNumWorkers] );
+
+    for ( int i = 0; i < iNumWorkers; i++ )
+    {
+        vecpHistograms[i] = &vecWorkerData[i].Histograms[ePhase];
+    }
+
+    return CPerfHistogram::Summarize ( vecpHistograms.get(), iNumWorkers );
+}
+
+const char* CTickProfiler::GetPhaseName ( const EPerfPhase ePhase )
+{
+    switch ( ePhase )
+    {
+    case PP_WAKEUP_LATENESS:
+        return "wakeupLateness";
+    case PP_DECODE:
+        return "decode";
+    case PP_LEVELS:
+        return "levels";
+    case PP_MIX:
+        return "mix";
+    case PP_ENCODE:
+        return "encode";
+    case PP_SEND:
+        return "send";
+    case PP_TICK:
+        return "tick";
+    default:
+        return "";
+    }
+}
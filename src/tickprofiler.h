@@ -0,0 +1,174 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *  The Jamulus Development Team
+ *
+ * As of Jamulus 3.12.1dev (commit eb172d47): All new source code contributions must be licensed
+ * under AGPL 3.0 or any later version.
+ *
+ * Existing code: Code contributed before 3.12.1dev (commit eb172d47) was licensed under GPL 2.0+.
+ * This code will be licensed under GPL 3.0 (or any later version) from
+ * 3.12.1dev (commit eb172d47).  When distributed as part of Jamulus, the AGPL 3.0 terms govern
+ * the combined work, including network use provisions.
+ *
+ ******************************************************************************
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * ---------------------------------------------------------------------------
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+\******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+
+/* Definitions ****************************************************************/
+// The histograms have 2^PERF_HIST_SUB_BUCKET_BITS linear sub buckets per power
+// of two, i.e. a relative resolution of about 6 %. Values are in nanoseconds,
+// larger values than 2^PERF_HIST_MAX_VALUE_BITS (about 68 s) are clipped.
+#define PERF_HIST_SUB_BUCKET_BITS 4
+#define PERF_HIST_MAX_VALUE_BITS  36
+#define PERF_HIST_NUM_BUCKETS     ( ( PERF_HIST_MAX_VALUE_BITS - PERF_HIST_SUB_BUCKET_BITS + 1 ) << PERF_HIST_SUB_BUCKET_BITS )
+
+// phases of a server tick which are measured by the tick profiler
+enum EPerfPhase
+{
+    PP_WAKEUP_LATENESS = 0, // lateness of the timer wakeup (timer thread only)
+    PP_DECODE          = 1, // jitter buffer and OPUS decoding
+    PP_LEVELS          = 2, // level calculation, mix grouping and mix-minus bus (timer thread only)
+    PP_MIX             = 3, // mixing of the audio data
+    PP_ENCODE          = 4, // OPUS encoding and packing of the network packets
+    PP_SEND            = 5, // transmission of the network packets
+    PP_TICK            = 6, // complete tick (timer thread only)
+    PP_NUM_PHASES      = 7
+};
+
+/* Classes ********************************************************************/
+// Summary of one or more histograms, all values in microseconds.
+struct CPerfHistogramSummary
+{
+    CPerfHistogramSummary() : iCount ( 0 ), dMeanUs ( 0 ), dP50Us ( 0 ), dP90Us ( 0 ), dP99Us ( 0 ), dP999Us ( 0 ), dMaxUs ( 0 ) {}
+
+    int64_t iCount;
+    double  dMeanUs;
+    double  dP50Us;
+    double  dP90Us;
+    double  dP99Us;
+    double  dP999Us;
+    double  dMaxUs;
+};
+
+// HDR style histogram of durations with a single writer. Recording a value
+// does not allocate memory, does not take a lock and does not use any
+// read-modify-write instruction. Other threads may read the histogram at any
+// time, the result is then only consistent up to the values recorded
+// concurrently.
+class CPerfHistogram
+{
+public:
+    CPerfHistogram() { Reset(); }
+
+    void Record ( const int64_t iValueNs );
+
+    // may be called by any thread, values recorded concurrently may survive
+    void Reset();
+
+    int64_t GetCount() const { return iCount.load ( std::memory_order_relaxed ); }
+
+    // the summary is generated for the sum of all given histograms
+    static CPerfHistogramSummary Summarize ( const CPerfHistogram* const* ppHistograms, const int iNumHistograms );
+
+protected:
+    static int     GetBucketIndex ( const int64_t iValueNs );
+    static int64_t GetBucketHighestValue ( const int iBucket );
+
+    std::atomic<uint32_t> iCounts[PERF_HIST_NUM_BUCKETS];
+    std::atomic<int64_t>  iCount;
+    std::atomic<int64_t>  iSumNs;
+    std::atomic<int64_t>  iMaxNs;
+};
+
+// Always-on profiler of the server tick. There is one set of histograms per
+// worker of the real-time worker team. The durations of a phase are
+// accumulated per tick with AddDuration() and are recorded as one value by
+// FinishTick(), therefore each histogram shows the time one worker spent in
+// that phase in one tick. A worker must only add durations to its own data.
+class CTickProfiler
+{
+public:
+    CTickProfiler() : iNumWorkers ( 0 ), iDeadlineNs ( 0 ), iNumTicks ( 0 ), iNumDeadlineMisses ( 0 ) {}
+
+    void Init ( const int iNewNumWorkers, const int64_t iNewDeadlineNs );
+
+    static int64_t Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds> ( std::chrono::steady_clock::now().time_since_epoch() ).count();
+    }
+
+    void AddDuration ( const int iWorker, const EPerfPhase ePhase, const int64_t iDurationNs )
+    {
+        vecWorkerData[iWorker].iAccuNs[ePhase] += iDurationNs;
+        vecWorkerData[iWorker].bPhaseUsed[ePhase] = true;
+    }
+
+    // records the accumulated phase durations of all workers and the complete
+    // tick duration, must be called by the timer thread while no other worker
+    // is active
+    void FinishTick ( const int64_t iTickDurationNs );
+
+    void Reset();
+
+    int     GetNumWorkers() const { return iNumWorkers; }
+    int64_t GetDeadlineNs() const { return iDeadlineNs; }
+    int64_t GetNumTicks() const { return iNumTicks.load ( std::memory_order_relaxed ); }
+    int64_t GetNumDeadlineMisses() const { return iNumDeadlineMisses.load ( std::memory_order_relaxed ); }
+
+    CPerfHistogramSummary GetSummary ( const int iWorker, const EPerfPhase ePhase ) const;
+    CPerfHistogramSummary GetSummaryAllWorkers ( const EPerfPhase ePhase ) const;
+
+    static const char* GetPhaseName ( const EPerfPhase ePhase );
+
+protected:
+    struct CWorkerData
+    {
+        CPerfHistogram Histograms[PP_NUM_PHASES];
+        int64_t        iAccuNs[PP_NUM_PHASES];
+        bool           bPhaseUsed[PP_NUM_PHASES];
+    };
+
+    int                            iNumWorkers;
+    int64_t                        iDeadlineNs;
+    std::unique_ptr<CWorkerData[]> vecWorkerData;
+    std::atomic<int64_t>           iNumTicks;
+    std::atomic<int64_t>           iNumDeadlineMisses;
+};
@@ -45,6 +45,17 @@
 \******************************************************************************/
 
 #include "util.h"
+#include <random>
+#ifdef USE_OPUS_SHARED_LIB
+#    include "opus/opus_custom.h"
+#else
+#    include "opus_custom.h"
+#endif
+#ifdef __linux__
+#    include <pthread.h>
+#    include <sched.h>
+#    include <sys/mman.h>
+#endif
 
 namespace
 {
@@ -224,14 +235,63 @@ double CStereoSignalLevelMeter::CalcLogResultForMeter ( const double& dLinearLev
 }
 
 // CRC -------------------------------------------------------------------------
-void CCRC::Reset()
+#define CRC_POLY         ( ( 1 << 5 ) | ( 1 << 12 ) )
+#define CRC_BIT_OUT_MASK ( 1 << 16 )
+
+// The update of the shift register is linear, therefore the new state can be
+// split in the contribution of the old state (low and high byte looked up
+// separately) and the contribution of each input byte. For four bytes at once
+// the state contribution is looked up in the "4" tables and each input byte
+// in the table of its position in the block.
+class CCRCTables
 {
-    // init state shift-register with ones. Set all registers to "1" with
-    // bit-wise not operation
-    iStateShiftReg = ~uint32_t ( 0 );
-}
+public:
+    CCRCTables()
+    {
+        for ( int i = 0; i < 256; i++ )
+        {
+            const uint8_t byZero = 0;
 
-void CCRC::AddByte ( const uint8_t byNewInput )
+            uint32_t iStateLo = CCRC::AddByteBitwise ( i, byZero );
+            uint32_t iStateHi = CCRC::AddByteBitwise ( i << 8, byZero );
+
+            vecRegLo1[i] = static_cast<uint16_t> ( iStateLo );
+            vecRegHi1[i] = static_cast<uint16_t> ( iStateHi );
+
+            for ( int j = 1; j < 4; j++ )
+            {
+                iStateLo = CCRC::AddByteBitwise ( iStateLo, byZero );
+                iStateHi = CCRC::AddByteBitwise ( iStateHi, byZero );
+            }
+
+            vecRegLo4[i] = static_cast<uint16_t> ( iStateLo );
+            vecRegHi4[i] = static_cast<uint16_t> ( iStateHi );
+
+            // the input byte at position k is followed by 3 - k zero bytes
+            for ( int k = 0; k < 4; k++ )
+            {
+                uint32_t iStateIn = CCRC::AddByteBitwise ( 0, static_cast<uint8_t> ( i ) );
+
+                for ( int j = k + 1; j < 4; j++ )
+                {
+                    iStateIn = CCRC::AddByteBitwise ( iStateIn, byZero );
+                }
+
+                vecIn4[k][i] = static_cast<uint16_t> ( iStateIn );
+            }
+        }
+    }
+
+    uint16_t vecRegLo1[256];
+    uint16_t vecRegHi1[256];
+    uint16_t vecRegLo4[256];
+    uint16_t vecRegHi4[256];
+    uint16_t vecIn4[4][256]; // vecIn4[3] is the table for a single byte
+};
+
+static const CCRCTables CRCTables;
+
+uint32_t CCRC::AddByteBitwise ( uint32_t iStateShiftReg, const uint8_t byNewInput )
 {
     for ( int i = 0; i < 8; i++ )
     {
@@ -241,7 +301,7 @@ void CCRC::AddByte ( const uint8_t byNewInput )
         // take bit, which was shifted out of the register-size and place it
         // at the beginning (LSB)
         // (If condition is not satisfied, implicitly a "0" is added)
-        if ( ( iStateShiftReg & iBitOutMask ) > 0 )
+        if ( ( iStateShiftReg & CRC_BIT_OUT_MASK ) > 0 )
         {
             iStateShiftReg |= 1;
         }
@@ -255,9 +315,46 @@ void CCRC::AddByte ( const uint8_t byNewInput )
         // add mask to shift-register if first bit is true
         if ( iStateShiftReg & 1 )
         {
-            iStateShiftReg ^= iPoly;
+            iStateShiftReg ^= CRC_POLY;
         }
     }
+
+    // only the bits inside the register size have an effect on later bytes
+    return iStateShiftReg & ( CRC_BIT_OUT_MASK - 1 );
+}
+
+void CCRC::Reset()
+{
+    // init state shift-register with ones. Set all registers to "1" with
+    // bit-wise not operation
+    iStateShiftReg = ( CRC_BIT_OUT_MASK - 1 );
+}
+
+void CCRC::AddByte ( const uint8_t byNewInput )
+{
+    // note that GetCRC() inverts all bits of the register
+    iStateShiftReg = CRCTables.vecRegLo1[iStateShiftReg & 255] ^ CRCTables.vecRegHi1[( iStateShiftReg >> 8 ) & 255] ^ CRCTables.vecIn4[3][byNewInput];
+}
+
+void CCRC::AddBytes ( const uint8_t* pbyNewInput, const int iNumBytes )
+{
+    uint32_t iState = iStateShiftReg & ( CRC_BIT_OUT_MASK - 1 );
+    int      i      = 0;
+
+    // slicing-by-4
+    for ( ; i + 4 <= iNumBytes; i += 4 )
+    {
+        iState = CRCTables.vecRegLo4[iState & 255] ^ CRCTables.vecRegHi4[iState >> 8] ^ CRCTables.vecIn4[0][pbyNewInput[i]] ^
+                 CRCTables.vecIn4[1][pbyNewInput[i + 1]] ^ CRCTables.vecIn4[2][pbyNewInput[i + 2]] ^ CRCTables.vecIn4[3][pbyNewInput[i + 3]];
+    }
+
+    // remaining bytes
+    for ( ; i < iNumBytes; i++ )
+    {
+        iState = CRCTables.vecRegLo1[iState & 255] ^ CRCTables.vecRegHi1[iState >> 8] ^ CRCTables.vecIn4[3][pbyNewInput[i]];
+    }
+
+    iStateShiftReg = iState;
 }
 
 uint32_t CCRC::GetCRC()
@@ -266,13 +363,16 @@ uint32_t CCRC::GetCRC()
     iStateShiftReg = ~iStateShiftReg;
 
     // remove bit which where shifted out of the shift-register frame
-    return iStateShiftReg & ( iBitOutMask - 1 );
+    return iStateShiftReg & ( CRC_BIT_OUT_MASK - 1 );
 }
 
 // CHighPrecisionTimer implementation ******************************************
 #ifdef _WIN32
-CHighPrecisionTimer::CHighPrecisionTimer ( const bool bNewUseDoubleSystemFrameSize ) : bUseDoubleSystemFrameSize ( bNewUseDoubleSystemFrameSize )
+CHighPrecisionTimer::CHighPrecisionTimer ( const bool bNewUseDoubleSystemFrameSize, const bool bNRealTime ) :
+    bUseDoubleSystemFrameSize ( bNewUseDoubleSystemFrameSize )
 {
+    Q_UNUSED ( bNRealTime )
+
     // add some error checking, the high precision timer implementation only
     // supports 64 and 128 samples frame size at 48 kHz sampling rate
 #    if ( SYSTEM_FRAME_SIZE_SAMPLES != 64 ) && ( DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES != 128 )
@@ -358,7 +458,21 @@ void CHighPrecisionTimer::OnTimer()
     }
 }
 #else // Mac and Linux
-CHighPrecisionTimer::CHighPrecisionTimer ( const bool bUseDoubleSystemFrameSize ) : bRun ( false )
+// priority of the timer thread in real-time mode (SCHED_FIFO, 1..99), this is
+// below the priorities typically used by JACK and the kernel interrupt threads
+#    define RT_TIMER_THREAD_PRIORITY 70
+
+// size of the stack which is prefaulted by the timer thread in real-time mode
+#    define RT_TIMER_PREFAULT_STACK_BYTES ( 256 * 1024 )
+
+CHighPrecisionTimer::CHighPrecisionTimer ( const bool bUseDoubleSystemFrameSize, const bool bNRealTime ) :
+    bRun ( false ),
+    bRealTime ( bNRealTime ),
+    bSchedWarningShown ( false ),
+    bLockWarningShown ( false ),
+    iNumWakeUps ( 0 ),
+    iWakeUpLateSumNs ( 0 ),
+    iWakeUpLateMaxNs ( 0 )
 {
     // calculate delay in ns
     uint64_t iNsDelay;
@@ -374,10 +488,9 @@ CHighPrecisionTimer::CHighPrecisionTimer ( const bool bUseDoubleSystemFrameSize
 
 #    if defined( __APPLE__ ) || defined( __MACOSX )
     // calculate delay in mach absolute time
-    struct mach_timebase_info timeBaseInfo;
-    mach_timebase_info ( &timeBaseInfo );
+    mach_timebase_info ( &TimeBaseInfo );
 
-    Delay = ( iNsDelay * (uint64_t) timeBaseInfo.denom ) / (uint64_t) timeBaseInfo.numer;
+    Delay = ( iNsDelay * (uint64_t) TimeBaseInfo.denom ) / (uint64_t) TimeBaseInfo.numer;
 #    else
     // set delay
     Delay = iNsDelay;
@@ -392,6 +505,11 @@ void CHighPrecisionTimer::Start()
         // set run flag
         bRun = true;
 
+        // reset the statistics
+        iNumWakeUps      = 0;
+        iWakeUpLateSumNs = 0;
+        iWakeUpLateMaxNs = 0;
+
         // set initial end time
 #    if defined( __APPLE__ ) || defined( __MACOSX )
         NextEnd = mach_absolute_time() + Delay;
@@ -420,19 +538,69 @@ void CHighPrecisionTimer::Stop()
     wait ( 5000 );
 }
 
+void CHighPrecisionTimer::GetWakeUpJitter ( double& dAvgUs, double& dMaxUs ) const
+{
+    const int64_t iCurNumWakeUps = iNumWakeUps.load ( std::memory_order_relaxed );
+
+    dAvgUs = iCurNumWakeUps > 0 ? iWakeUpLateSumNs.load ( std::memory_order_relaxed ) / 1000.0 / iCurNumWakeUps : 0;
+    dMaxUs = iWakeUpLateMaxNs.load ( std::memory_order_relaxed ) / 1000.0;
+}
+
+void CHighPrecisionTimer::UpdateWakeUpJitter ( const int64_t iLateNs )
+{
+    // only the timer thread writes the statistics
+    iNumWakeUps.store ( iNumWakeUps.load ( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+    iWakeUpLateSumNs.store ( iWakeUpLateSumNs.load ( std::memory_order_relaxed ) + iLateNs, std::memory_order_relaxed );
+
+    if ( iLateNs > iWakeUpLateMaxNs.load ( std::memory_order_relaxed ) )
+    {
+        iWakeUpLateMaxNs.store ( iLateNs, std::memory_order_relaxed );
+    }
+}
+
 void CHighPrecisionTimer::run()
 {
+#    ifdef __linux__
+    if ( bRealTime )
+    {
+        sched_param Param;
+        Param.sched_priority = RT_TIMER_THREAD_PRIORITY;
+
+        // needs CAP_SYS_NICE or an rtprio limit, otherwise the normal scheduling is kept
+        if ( ( pthread_setschedparam ( pthread_self(), SCHED_FIFO, &Param ) != 0 ) && !bSchedWarningShown )
+        {
+            qWarning() << "- real-time thread: SCHED_FIFO is not permitted, using the normal scheduling";
+            bSchedWarningShown = true;
+        }
+
+        // prefault the stack which is used by the processing
+        volatile uint8_t byStack[RT_TIMER_PREFAULT_STACK_BYTES];
+
+        for ( int i = 0; i < RT_TIMER_PREFAULT_STACK_BYTES; i += 4096 )
+        {
+            byStack[i] = 0;
+        }
+
+        // Lock the current memory of the process so that the real-time thread does
+        // not stall on page faults. At this point the server buffers are preallocated
+        // and the stacks of this thread and the workers exist. MCL_FUTURE is not used
+        // since later allocations (e.g. thread stacks) would fail with ENOMEM once
+        // the memlock limit is reached.
+        if ( ( mlockall ( MCL_CURRENT ) != 0 ) && !bLockWarningShown )
+        {
+            qWarning() << "- real-time thread: locking the memory failed (check the memlock limit)";
+            bLockWarningShown = true;
+        }
+    }
+#    endif
+
     // loop until the thread shall be terminated
     while ( bRun )
     {
-        // call processing routine by fireing signal
-
-        //### TODO: BEGIN ###//
-        // by emit a signal we leave the high priority thread -> maybe use some
-        // other connection type to have something like a true callback, e.g.
-        //     "Qt::DirectConnection" -> Can this work?
+        // call processing routine by fireing signal (in real-time mode the
+        // signal is connected directly, i.e., the processing is done in this
+        // thread)
         emit timeout();
-        //### TODO: END ###//
 
         // now wait until the next buffer shall be processed (we
         // use the "increment method" to make sure we do not introduce
@@ -440,10 +608,29 @@ void CHighPrecisionTimer::run()
 #    if defined( __APPLE__ ) || defined( __MACOSX )
         mach_wait_until ( NextEnd );
 
+        const uint64_t iNow = mach_absolute_time();
+
+        if ( iNow > NextEnd )
+        {
+            UpdateWakeUpJitter ( static_cast<int64_t> ( ( iNow - NextEnd ) * TimeBaseInfo.numer / TimeBaseInfo.denom ) );
+        }
+        else
+        {
+            UpdateWakeUpJitter ( 0 );
+        }
+
         NextEnd += Delay;
 #    else
         clock_nanosleep ( CLOCK_MONOTONIC, TIMER_ABSTIME, &NextEnd, NULL );
 
+        timespec Now;
+        clock_gettime ( CLOCK_MONOTONIC, &Now );
+
+        // if the processing took longer than one tick, the lateness includes the overrun
+        const int64_t iLateNs = static_cast<int64_t> ( Now.tv_sec - NextEnd.tv_sec ) * 1000000000 + ( Now.tv_nsec - NextEnd.tv_nsec );
+
+        UpdateWakeUpJitter ( std::max ( iLateNs, static_cast<int64_t> ( 0 ) ) );
+
         NextEnd.tv_nsec += Delay;
         if ( NextEnd.tv_nsec >= 1000000000L )
         {
@@ -1140,6 +1327,82 @@ bool NetworkUtil::IsPrivateNetworkIP ( const QHostAddress& qhAddr )
 }
 
 // CHostAddress methods
+void CHostAddress::Set ( const QHostAddress& NInetAddr, const quint16 iNPort )
+{
+    if ( NInetAddr.protocol() == QAbstractSocket::IPv6Protocol )
+    {
+        const Q_IPV6ADDR IPv6Addr = NInetAddr.toIPv6Address();
+
+        SetIPv6 ( IPv6Addr.c, iNPort, NInetAddr.scopeId().toUInt() );
+    }
+    else
+    {
+        // note that an unknown or empty address results in 0.0.0.0
+        SetIPv4 ( NInetAddr.toIPv4Address(), iNPort );
+    }
+}
+
+void CHostAddress::SetIPv4 ( const quint32 iNIPv4Addr, const quint16 iNPort )
+{
+    memset ( byAddr, 0, 10 );
+    byAddr[10] = 0xFF;
+    byAddr[11] = 0xFF;
+    byAddr[12] = static_cast<uint8_t> ( iNIPv4Addr >> 24 );
+    byAddr[13] = static_cast<uint8_t> ( iNIPv4Addr >> 16 );
+    byAddr[14] = static_cast<uint8_t> ( iNIPv4Addr >> 8 );
+    byAddr[15] = static_cast<uint8_t> ( iNIPv4Addr );
+    iScopeId   = 0;
+    iPort      = iNPort;
+
+    UpdateHash();
+}
+
+void CHostAddress::SetIPv6 ( const uint8_t* pNIPv6Addr, const quint16 iNPort, const quint32 iNScopeId )
+{
+    memcpy ( byAddr, pNIPv6Addr, sizeof ( byAddr ) );
+    iScopeId = iNScopeId;
+    iPort    = iNPort;
+
+    UpdateHash();
+}
+
+QHostAddress CHostAddress::GetQHostAddress() const
+{
+    if ( IsIPv4() )
+    {
+        return QHostAddress ( GetIPv4() );
+    }
+
+    QHostAddress IPv6Addr ( byAddr );
+
+    if ( iScopeId != 0 )
+    {
+        IPv6Addr.setScopeId ( QString::number ( iScopeId ) );
+    }
+
+    return IPv6Addr;
+}
+
+void CHostAddress::UpdateHash()
+{
+    uint64_t iHi;
+    uint64_t iLo;
+
+    memcpy ( &iHi, &byAddr[0], sizeof ( iHi ) );
+    memcpy ( &iLo, &byAddr[8], sizeof ( iLo ) );
+
+    // mix all bits of the address, scope id and port (finaliser of MurmurHash3)
+    uint64_t iMix = iHi ^ ( iLo * 0x9E3779B97F4A7C15ULL ) ^ ( static_cast<uint64_t> ( iPort ) << 40 ) ^ ( static_cast<uint64_t> ( iScopeId ) << 8 );
+
+    iMix ^= iMix >> 33;
+    iMix *= 0xFF51AFD7ED558CCDULL;
+    iMix ^= iMix >> 33;
+    iMix *= 0xC4CEB9FE1A85EC53ULL;
+    iMix ^= iMix >> 33;
+
+    iHash = static_cast<quint16> ( iMix );
+}
+
 // Compare() - compare two CHostAddress objects, and return an ordering between them:
 // 0 - they are equal
 // <0 - this comes before other
@@ -1155,37 +1418,29 @@ int CHostAddress::Compare ( const CHostAddress& other ) const
         return (int) iPort - (int) other.iPort;
     }
 
-    // compare protocols before addresses
-
-    QAbstractSocket::NetworkLayerProtocol thisProto  = InetAddr.protocol();
-    QAbstractSocket::NetworkLayerProtocol otherProto = other.InetAddr.protocol();
+    // IPv4 addresses come before IPv6 addresses
 
-    if ( thisProto != otherProto )
+    if ( IsIPv4() != other.IsIPv4() )
     {
-        return (int) thisProto - (int) otherProto;
+        return IsIPv4() ? -1 : 1;
     }
 
-    // now we know both addresses are the same protocol
+    // link-local addresses are only unique per interface
 
-    if ( thisProto == QAbstractSocket::IPv6Protocol )
+    if ( iScopeId != other.iScopeId )
     {
-        // compare IPv6 addresses
-        Q_IPV6ADDR thisAddr  = InetAddr.toIPv6Address();
-        Q_IPV6ADDR otherAddr = other.InetAddr.toIPv6Address();
-
-        return memcmp ( &thisAddr, &otherAddr, sizeof ( Q_IPV6ADDR ) );
+        return iScopeId < other.iScopeId ? -1 : 1;
     }
 
-    // compare IPv4 addresses
-    quint32 thisAddr  = InetAddr.toIPv4Address();
-    quint32 otherAddr = other.InetAddr.toIPv4Address();
+    // the byte order of the addresses is the network byte order
 
-    return thisAddr < otherAddr ? -1 : thisAddr > otherAddr ? 1 : 0;
+    return memcmp ( byAddr, other.byAddr, sizeof ( byAddr ) );
 }
 
 QString CHostAddress::toString ( const EStringMode eStringMode ) const
 {
-    QString strReturn = InetAddr.toString();
+    const QHostAddress InetAddr  = GetQHostAddress();
+    QString            strReturn = InetAddr.toString();
 
     // special case: for local host address, we do not replace the last byte
     if ( ( ( eStringMode == SM_IP_NO_LAST_BYTE ) || ( eStringMode == SM_IP_NO_LAST_BYTE_PORT ) ) &&
@@ -1221,6 +1476,82 @@ QString CHostAddress::toString ( const EStringMode eStringMode ) const
     return strReturn;
 }
 
+// OPUS coding parameters of the client ----------------------------------------
+int COpusCoding::GetNumCodedBytes ( const EAudComprType eAudComprType, const int iNumAudioChannels, const EAudioQuality eAudioQuality )
+{
+    const bool bIsMono = ( iNumAudioChannels == 1 );
+
+    if ( eAudComprType == CT_OPUS )
+    {
+        switch ( eAudioQuality )
+        {
+        case AQ_LOW:
+            return bIsMono ? OPUS_NUM_BYTES_MONO_LOW_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_STEREO_LOW_QUALITY_DBLE_FRAMESIZE;
+        case AQ_NORMAL:
+            return bIsMono ? OPUS_NUM_BYTES_MONO_NORMAL_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY_DBLE_FRAMESIZE;
+        default: // AQ_HIGH, AQ_RAW
+            return bIsMono ? OPUS_NUM_BYTES_MONO_HIGH_QUALITY_DBLE_FRAMESIZE : OPUS_NUM_BYTES_STEREO_HIGH_QUALITY_DBLE_FRAMESIZE;
+        }
+    }
+
+    switch ( eAudioQuality )
+    {
+    case AQ_LOW:
+        return bIsMono ? OPUS_NUM_BYTES_MONO_LOW_QUALITY : OPUS_NUM_BYTES_STEREO_LOW_QUALITY;
+    case AQ_NORMAL:
+        return bIsMono ? OPUS_NUM_BYTES_MONO_NORMAL_QUALITY : OPUS_NUM_BYTES_STEREO_NORMAL_QUALITY;
+    default: // AQ_HIGH, AQ_RAW
+        return bIsMono ? OPUS_NUM_BYTES_MONO_HIGH_QUALITY : OPUS_NUM_BYTES_STEREO_HIGH_QUALITY;
+    }
+}
+
+void COpusCoding::InitEncoder ( OpusCustomEncoder* pEncoder, const EAudComprType eAudComprType )
+{
+    // we require a constant bit rate
+    opus_custom_encoder_ctl ( pEncoder, OPUS_SET_VBR ( 0 ) );
+
+    // we want as low delay as possible
+    opus_custom_encoder_ctl ( pEncoder, OPUS_SET_APPLICATION ( OPUS_APPLICATION_RESTRICTED_LOWDELAY ) );
+
+    if ( eAudComprType == CT_OPUS64 )
+    {
+        // for 64 samples frame size we have to adjust the PLC behavior to avoid loud artifacts
+        opus_custom_encoder_ctl ( pEncoder, OPUS_SET_PACKET_LOSS_PERC ( 35 ) );
+    }
+    else
+    {
+        // set encoder low complexity for legacy 128 samples frame size
+        opus_custom_encoder_ctl ( pEncoder, OPUS_SET_COMPLEXITY ( 1 ) );
+    }
+}
+
+void COpusCoding::SetEncoderBitRate ( OpusCustomEncoder* pEncoder, const EAudComprType eAudComprType, const int iCeltNumCodedBytes )
+{
+    const int iBitRateBitsPerSec = CalcBitRateBitsPerSecFromCodedBytes ( iCeltNumCodedBytes, GetFrameSizeSamples ( eAudComprType ) );
+
+    opus_custom_encoder_ctl ( pEncoder, OPUS_SET_BITRATE ( iBitRateBitsPerSec ) );
+}
+
+void COpusCoding::GetTestSignal ( CVector<int16_t>& vecsAudio, const int iNumAudioChannels )
+{
+    const int                        iNumSamples = vecsAudio.Size() / iNumAudioChannels;
+    const double                     dTwoPi      = 8 * atan ( 1.0 );
+    std::mt19937                     RandomGen ( 1 );
+    std::uniform_real_distribution<> Noise ( -0.02, 0.02 );
+
+    for ( int i = 0; i < iNumSamples; i++ )
+    {
+        const double dTime = static_cast<double> ( i ) / SYSTEM_SAMPLE_RATE_HZ;
+
+        for ( int iCh = 0; iCh < iNumAudioChannels; iCh++ )
+        {
+            const double dValue = 0.2 * sin ( dTwoPi * ( 220 + 57 * iCh ) * dTime ) + 0.1 * sin ( dTwoPi * 330 * dTime ) + Noise ( RandomGen );
+
+            vecsAudio[i * iNumAudioChannels + iCh] = static_cast<int16_t> ( dValue * _MAXSHORT );
+        }
+    }
+}
+
 // Instrument picture data base ------------------------------------------------
 CVector<CInstPictures::CInstPictProps>& CInstPictures::GetTable ( const bool bReGenerateTable )
 {
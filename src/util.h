@@ -48,6 +48,8 @@
 #include <vector>
 #include <algorithm>
 #include <atomic>
+#include <cstring>
+#include <type_traits>
 #ifdef _WIN32
 #    include <winsock2.h>
 #    include <ws2tcpip.h>
@@ -106,6 +108,8 @@
 class CClient; // forward declaration of CClient
 #endif
 
+struct OpusCustomEncoder; // forward declaration of the OPUS encoder
+
 /* Definitions ****************************************************************/
 #define METER_FLY_BACK             2
 #define INVALID_MIDI_CH            -1 // invalid MIDI channel definition
@@ -391,6 +395,44 @@ void CMovingAv<TData>::Add ( const TData tNewD )
     }
 }
 
+/******************************************************************************\
+* CTripleBuffer (lock-free single producer/single consumer snapshot)           *
+\******************************************************************************/
+// The writer fills the back buffer and publishes it by swapping it with the
+// middle buffer. The reader swaps the middle buffer into the front buffer only
+// if something new was published. Neither side ever blocks, the reader always
+// sees a complete snapshot. Multiple writers must be serialized by the caller
+// and something must be published before the first read.
+template<class TData>
+class CTripleBuffer
+{
+public:
+    CTripleBuffer() : iBack ( 0 ), iMiddle ( 1 ), iFront ( 2 ) {}
+
+    TData& GetWriteBuffer() { return Buf[iBack]; }
+
+    void Publish() { iBack = iMiddle.exchange ( iBack | NEW_DATA_FLAG, std::memory_order_acq_rel ) & INDEX_MASK; }
+
+    const TData& GetReadBuffer()
+    {
+        if ( iMiddle.load ( std::memory_order_relaxed ) & NEW_DATA_FLAG )
+        {
+            iFront = iMiddle.exchange ( iFront, std::memory_order_acq_rel ) & INDEX_MASK;
+        }
+
+        return Buf[iFront];
+    }
+
+protected:
+    static constexpr int INDEX_MASK    = 3;
+    static constexpr int NEW_DATA_FLAG = 4;
+
+    TData            Buf[3];
+    int              iBack;
+    std::atomic<int> iMiddle;
+    int              iFront;
+};
+
 /******************************************************************************\
 * GUI Utilities                                                                *
 \******************************************************************************/
@@ -542,6 +584,7 @@ enum EAudioQuality
 enum EGetDataStat
 {
     GS_BUFFER_OK,
+    GS_BUFFER_OK_DECODED, // the block was already decoded on arrival
     GS_BUFFER_UNDERRUN,
     GS_CHAN_NOW_DISCONNECTED,
     GS_CHAN_NOT_CONNECTED
@@ -794,6 +837,12 @@ protected:
 };
 
 // Host address ----------------------------------------------------------------
+// The address is a trivially copyable 24 byte type since it is copied with each
+// protocol message and looked up for each audio packet. IPv4 addresses are
+// stored as IPv4-mapped IPv6 addresses. The IPv6 scope id is part of the
+// address since link-local addresses are only unique per interface. The hash
+// is precomputed, therefore the address must only be modified with the Set
+// functions. QHostAddress is only used for parsing and for the display.
 class CHostAddress
 {
 public:
@@ -804,31 +853,72 @@ public:
         SM_IP_NO_LAST_BYTE_PORT
     };
 
-    CHostAddress() : InetAddr ( static_cast<quint32> ( 0 ) ), iPort ( 0 ) {}
+    CHostAddress() { SetIPv4 ( 0, 0 ); }
 
-    CHostAddress ( const QHostAddress& NInetAddr, const quint16 iNPort ) : InetAddr ( NInetAddr ), iPort ( iNPort ) {}
+    CHostAddress ( const QHostAddress& NInetAddr, const quint16 iNPort ) { Set ( NInetAddr, iNPort ); }
 
-    CHostAddress ( const CHostAddress& NHAddr ) : InetAddr ( NHAddr.InetAddr ), iPort ( NHAddr.iPort ) {}
+    void Set ( const QHostAddress& NInetAddr, const quint16 iNPort );
+    void SetIPv4 ( const quint32 iNIPv4Addr, const quint16 iNPort ); // host byte order
+    void SetIPv6 ( const uint8_t* pNIPv6Addr, const quint16 iNPort, const quint32 iNScopeId = 0 ); // network byte order
 
-    // copy operator
-    CHostAddress& operator= ( const CHostAddress& NHAddr )
+    void SetPort ( const quint16 iNPort )
     {
-        InetAddr = NHAddr.InetAddr;
-        iPort    = NHAddr.iPort;
-        return *this;
+        iPort = iNPort;
+        UpdateHash();
     }
 
-    // compare operator
-    bool operator== ( const CHostAddress& CompAddr ) const { return ( ( CompAddr.InetAddr == InetAddr ) && ( CompAddr.iPort == iPort ) ); }
+    bool IsIPv4() const
+    {
+        static const uint8_t byMappedPrefix[12] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF };
+        return memcmp ( byAddr, byMappedPrefix, sizeof ( byMappedPrefix ) ) == 0;
+    }
+
+    // like QHostAddress, zero is returned for an IPv6 address
+    quint32 GetIPv4() const
+    {
+        if ( !IsIPv4() )
+        {
+            return 0;
+        }
+
+        return ( static_cast<quint32> ( byAddr[12] ) << 24 ) | ( static_cast<quint32> ( byAddr[13] ) << 16 ) |
+               ( static_cast<quint32> ( byAddr[14] ) << 8 ) | byAddr[15];
+    }
+
+    QHostAddress GetQHostAddress() const;
+
+    // compare operators
+    bool operator== ( const CHostAddress& CompAddr ) const
+    {
+        return ( CompAddr.iHash == iHash ) && ( CompAddr.iPort == iPort ) && HasSameIP ( CompAddr );
+    }
+
+    bool operator!= ( const CHostAddress& CompAddr ) const { return !( *this == CompAddr ); }
+
+    bool HasSameIP ( const CHostAddress& CompAddr ) const
+    {
+        return ( CompAddr.iScopeId == iScopeId ) && ( memcmp ( CompAddr.byAddr, byAddr, sizeof ( byAddr ) ) == 0 );
+    }
 
     int Compare ( const CHostAddress& other ) const;
 
+    quint16 GetHash() const { return iHash; }
+
     QString toString ( const EStringMode eStringMode = SM_IP_PORT ) const;
 
-    QHostAddress InetAddr;
-    quint16      iPort;
+    uint8_t byAddr[16]; // IPv6 address in network byte order
+    quint32 iScopeId;   // IPv6 scope id (interface index), zero if not used
+    quint16 iPort;
+
+protected:
+    void UpdateHash();
+
+    quint16 iHash;
 };
 
+static_assert ( sizeof ( CHostAddress ) == 24, "CHostAddress must be compact" );
+static_assert ( std::is_trivially_copyable<CHostAddress>::value, "CHostAddress must be trivially copyable" );
+
 // Instrument picture data base ------------------------------------------------
 // this is a pure static class
 class CInstPictures
@@ -1098,6 +1188,30 @@ public:
     int32_t       iAudioCodingArg;
 };
 
+// OPUS coding parameters of the client ----------------------------------------
+// this is a pure static class, the load generator and the benchmarks use it to
+// produce the same audio streams as a real client
+class COpusCoding
+{
+public:
+    static int GetFrameSizeSamples ( const EAudComprType eAudComprType )
+    {
+        return ( eAudComprType == CT_OPUS ) ? DOUBLE_SYSTEM_FRAME_SIZE_SAMPLES : SYSTEM_FRAME_SIZE_SAMPLES;
+    }
+
+    // raw audio is mapped to the highest OPUS quality (the fall back if the server
+    // does not support raw audio)
+    static int GetNumCodedBytes ( const EAudComprType eAudComprType, const int iNumAudioChannels, const EAudioQuality eAudioQuality );
+
+    static void InitEncoder ( OpusCustomEncoder* pEncoder, const EAudComprType eAudComprType );
+    static void SetEncoderBitRate ( OpusCustomEncoder* pEncoder, const EAudComprType eAudComprType, const int iCeltNumCodedBytes );
+
+    // A chord with some noise gives a realistic coding load (silence would be
+    // coded much faster). The signal always starts at the same position and the
+    // noise uses a fixed seed, so the test signal is reproducible.
+    static void GetTestSignal ( CVector<int16_t>& vecsAudio, const int iNumAudioChannels );
+};
+
 // Network utility functions ---------------------------------------------------
 class NetworkUtil
 {
@@ -1172,19 +1286,24 @@ public:
 };
 
 // CRC -------------------------------------------------------------------------
+// The CRC is table driven (slicing-by-4), the tables are generated from the
+// original bit serial shift register implementation so that the result is
+// identical.
 class CCRC
 {
 public:
-    CCRC() : iPoly ( ( 1 << 5 ) | ( 1 << 12 ) ), iBitOutMask ( 1 << 16 ) { Reset(); }
+    CCRC() { Reset(); }
 
     void     Reset();
     void     AddByte ( const uint8_t byNewInput );
+    void     AddBytes ( const uint8_t* pbyNewInput, const int iNumBytes );
     bool     CheckCRC ( const uint32_t iCRC ) { return iCRC == GetCRC(); }
     uint32_t GetCRC();
 
+    // bit serial reference implementation, used to generate the tables
+    static uint32_t AddByteBitwise ( uint32_t iStateShiftReg, const uint8_t byNewInput );
+
 protected:
-    uint32_t iPoly;
-    uint32_t iBitOutMask;
     uint32_t iStateShiftReg;
 };
 
@@ -1320,12 +1439,21 @@ class CHighPrecisionTimer : public QObject
     Q_OBJECT
 
 public:
-    CHighPrecisionTimer ( const bool bNewUseDoubleSystemFrameSize );
+    CHighPrecisionTimer ( const bool bNewUseDoubleSystemFrameSize, const bool bNRealTime = false );
 
     void Start();
     void Stop();
     bool isActive() const { return Timer.isActive(); }
 
+    // the timer runs in the main thread, i.e., there is no real-time mode
+    bool IsRealTime() const { return false; }
+
+    void GetWakeUpJitter ( double& dAvgUs, double& dMaxUs ) const
+    {
+        dAvgUs = 0;
+        dMaxUs = 0;
+    }
+
 protected:
     QTimer       Timer;
     CVector<int> veciTimeOutIntervals;
@@ -1346,20 +1474,38 @@ class CHighPrecisionTimer : public QThread
     Q_OBJECT
 
 public:
-    CHighPrecisionTimer ( const bool bUseDoubleSystemFrameSize );
+    CHighPrecisionTimer ( const bool bUseDoubleSystemFrameSize, const bool bNRealTime = false );
 
     void Start();
     void Stop();
     bool isActive() { return bRun; }
 
+    // In real-time mode the timeout() signal must be connected with a direct
+    // connection so that the processing runs in the timer thread. On Linux the
+    // thread then uses SCHED_FIFO (if permitted) and the memory is locked.
+    bool IsRealTime() const { return bRealTime; }
+
+    // lateness of the wakeups since the timer was started
+    void GetWakeUpJitter ( double& dAvgUs, double& dMaxUs ) const;
+
 protected:
     virtual void run();
 
+    void UpdateWakeUpJitter ( const int64_t iLateNs );
+
     std::atomic<bool> bRun;
+    bool              bRealTime;
+    bool              bSchedWarningShown;
+    bool              bLockWarningShown;
+
+    std::atomic<int64_t> iNumWakeUps;
+    std::atomic<int64_t> iWakeUpLateSumNs;
+    std::atomic<int64_t> iWakeUpLateMaxNs;
 
 #    if defined( __APPLE__ ) || defined( __MACOSX )
-    uint64_t          Delay;
-    uint64_t          NextEnd;
+    uint64_t                  Delay;
+    uint64_t                  NextEnd;
+    struct mach_timebase_info TimeBaseInfo;
 #    else
     long     Delay;
     timespec NextEnd;